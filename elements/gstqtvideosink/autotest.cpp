@@ -24,6 +24,8 @@
 #include <QWidget>
 #include <QLabel>
 #include <QGridLayout>
+#include <QElapsedTimer>
+#include <QMutex>
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 # define SkipSingle 0
@@ -40,8 +42,11 @@
 #endif
 
 #include "painters/genericsurfacepainter.h"
+#include "utils/yuvconverter.h"
+#include "utils/overlaycomposition.h"
 
 Q_DECLARE_METATYPE(Qt::AspectRatioMode)
+Q_DECLARE_METATYPE(YuvConverter::Coefficients)
 
 struct PipelineDeleter
 {
@@ -133,7 +138,7 @@ class QtVideoSinkTest : public QObject
     Q_OBJECT
 public:
     explicit QtVideoSinkTest(QObject* parent = 0)
-        : QObject(parent), haveArbFp(false), haveGlsl(false) {}
+        : QObject(parent), haveArbFp(false), haveGlsl(false), havePbo(false) {}
 
 private Q_SLOTS:
     void initTestCase();
@@ -147,6 +152,17 @@ private Q_SLOTS:
     void genericSurfacePainterFormatsTest_data();
     void genericSurfacePainterFormatsTest();
 
+    void paddedFrameTest_data();
+    void paddedFrameTest();
+
+    void overlayCompositionTest();
+
+    void yuvConverterKernelsTest_data();
+    void yuvConverterKernelsTest();
+
+    void yuvConverterBenchmark_data();
+    void yuvConverterBenchmark();
+
 #ifndef GST_QT_VIDEO_SINK_NO_OPENGL
     void glSurfacePainterFormatsTest_data();
     void glSurfacePainterFormatsTest();
@@ -155,6 +171,9 @@ private Q_SLOTS:
     void qtVideoSinkTest_data();
     void qtVideoSinkTest();
 
+    void allocationTest();
+    void playbackAllocationTest();
+
     void cleanupTestCase();
 
 private:
@@ -166,6 +185,7 @@ private:
 
     bool haveArbFp;
     bool haveGlsl;
+    bool havePbo;
 };
 
 //------------------------------------
@@ -183,6 +203,8 @@ void QtVideoSinkTest::initTestCase()
 
 # ifndef QT_OPENGL_ES
     haveArbFp = extensions.contains("ARB_fragment_program");
+    havePbo = extensions.contains("ARB_pixel_buffer_object")
+                || extensions.contains("EXT_pixel_buffer_object");
 # endif
 
 # ifndef QT_OPENGL_ES_2
@@ -218,6 +240,10 @@ void QtVideoSinkTest::bufferFormatTest_data()
     QTest::newRow("YV12") << GST_VIDEO_FORMAT_YV12 << GST_VIDEO_COLOR_MATRIX_BT601;
     QTest::newRow("v308") << GST_VIDEO_FORMAT_v308 << GST_VIDEO_COLOR_MATRIX_BT601;
     QTest::newRow("AYUV") << GST_VIDEO_FORMAT_AYUV << GST_VIDEO_COLOR_MATRIX_BT601;
+    QTest::newRow("NV12") << GST_VIDEO_FORMAT_NV12 << GST_VIDEO_COLOR_MATRIX_BT601;
+    QTest::newRow("NV21") << GST_VIDEO_FORMAT_NV21 << GST_VIDEO_COLOR_MATRIX_BT601;
+    QTest::newRow("YUY2") << GST_VIDEO_FORMAT_YUY2 << GST_VIDEO_COLOR_MATRIX_BT601;
+    QTest::newRow("UYVY") << GST_VIDEO_FORMAT_UYVY << GST_VIDEO_COLOR_MATRIX_BT601;
 }
 
 void QtVideoSinkTest::bufferFormatTest()
@@ -365,6 +391,9 @@ void QtVideoSinkTest::genericSurfacePainterFormatsTest()
     areas.videoArea = areas.targetArea;
     areas.sourceRect = QRectF(0, 0, 1, 1);
 
+    // YUV frames are converted, so their colors may be slightly off
+    const bool exact = !YuvConverter::supportedPixelFormats().contains(format);
+
     GenericSurfacePainter genericSurfacePainter;
     QVERIFY(genericSurfacePainter.supportsFormat(format));
     try {
@@ -381,50 +410,416 @@ void QtVideoSinkTest::genericSurfacePainterFormatsTest()
     QVERIFY(!sample.isNull());
     GstBuffer *buffer = gst_sample_get_buffer(sample.data());
     QVERIFY(buffer);
-    GstMapInfo info;
-    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+    GstVideoFrame frame;
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
     genericSurfacePainter.paint(
-        info.data,
+        &frame,
         bufferFormat,
         &painter,
         areas);
-    QCOMPARE(targetImage.pixel(50, 50), qRgb(255, 0, 0));
-    gst_buffer_unmap(buffer, &info);
+    if (exact) {
+        QCOMPARE(targetImage.pixel(50, 50), qRgb(255, 0, 0));
+    } else {
+        QVERIFY(pixelsSimilar(targetImage.pixel(50, 50), qRgb(255, 0, 0)));
+    }
+    gst_video_frame_unmap(&frame);
 
     sample.reset(generateTestSample(format, 5)); //pattern = green
     QVERIFY(!sample.isNull());
     buffer = gst_sample_get_buffer(sample.data());
     QVERIFY(buffer);
-    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
     genericSurfacePainter.paint(
-        info.data,
+        &frame,
         bufferFormat,
         &painter,
         areas);
-    QCOMPARE(targetImage.pixel(50, 50), qRgb(0, 255, 0));
-    gst_buffer_unmap(buffer, &info);
+    if (exact) {
+        QCOMPARE(targetImage.pixel(50, 50), qRgb(0, 255, 0));
+    } else {
+        QVERIFY(pixelsSimilar(targetImage.pixel(50, 50), qRgb(0, 255, 0)));
+    }
+    gst_video_frame_unmap(&frame);
 
     sample.reset(generateTestSample(format, 6)); //pattern = blue
     QVERIFY(!sample.isNull());
     buffer = gst_sample_get_buffer(sample.data());
     QVERIFY(buffer);
-    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
     genericSurfacePainter.paint(
-        info.data,
+        &frame,
         bufferFormat,
         &painter,
         areas);
-    QCOMPARE(targetImage.pixel(50, 50), qRgb(0, 0, 255));
+    if (exact) {
+        QCOMPARE(targetImage.pixel(50, 50), qRgb(0, 0, 255));
+    } else {
+        QVERIFY(pixelsSimilar(targetImage.pixel(50, 50), qRgb(0, 0, 255)));
+    }
 
 
     QBENCHMARK {
         genericSurfacePainter.paint(
-            info.data,
+            &frame,
             bufferFormat,
             &painter,
             areas);
     }
+    gst_video_frame_unmap(&frame);
+}
+
+//------------------------------------
+
+void QtVideoSinkTest::paddedFrameTest_data()
+{
+    QTest::addColumn<GstVideoFormat>("format");
+
+    QTest::newRow("BGRA") << GST_VIDEO_FORMAT_BGRA;
+    QTest::newRow("RGB") << GST_VIDEO_FORMAT_RGB;
+    QTest::newRow("I420") << GST_VIDEO_FORMAT_I420;
+    QTest::newRow("YV12") << GST_VIDEO_FORMAT_YV12;
+    QTest::newRow("NV12") << GST_VIDEO_FORMAT_NV12;
+    QTest::newRow("YUY2") << GST_VIDEO_FORMAT_YUY2;
+}
+
+void QtVideoSinkTest::paddedFrameTest()
+{
+    QFETCH(GstVideoFormat, format);
+
+    // a 100x100 picture at (10, 6) of a 122x110 frame, whose odd width gives
+    // padded strides; everything around the picture is green, the picture red
+    const QRect crop(10, 6, 100, 100);
+    GstVideoInfo paddedInfo;
+    gst_video_info_set_format(&paddedInfo, format, 122, 110);
+
+    GstBuffer *buffer = gst_buffer_new_allocate(NULL, GST_VIDEO_INFO_SIZE(&paddedInfo), NULL);
+    gst_buffer_add_video_meta_full(buffer, GST_VIDEO_FRAME_FLAG_NONE, format,
+            GST_VIDEO_INFO_WIDTH(&paddedInfo), GST_VIDEO_INFO_HEIGHT(&paddedInfo),
+            GST_VIDEO_INFO_N_PLANES(&paddedInfo), paddedInfo.offset, paddedInfo.stride);
+
+    GstVideoCropMeta *cropMeta = gst_buffer_add_video_crop_meta(buffer);
+    cropMeta->x = crop.x();
+    cropMeta->y = crop.y();
+    cropMeta->width = crop.width();
+    cropMeta->height = crop.height();
+
+    // component values in the order of the GstVideoFormatInfo components,
+    // which is R, G, B, A for the RGB formats and Y, U, V for the YUV ones
+    const bool yuv = GST_VIDEO_INFO_IS_YUV(&paddedInfo);
+    const quint8 red[] = { 255, 0, 0, 255 };
+    const quint8 green[] = { 0, 255, 0, 255 };
+    const quint8 yuvRed[] = { 81, 90, 240, 0 };
+    const quint8 yuvGreen[] = { 145, 54, 34, 0 };
+
+    GstVideoFrame frame;
+    QVERIFY(gst_video_frame_map(&frame, &paddedInfo, buffer, GST_MAP_WRITE));
+    for (guint c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS(&frame); ++c) {
+        const GstVideoFormatInfo *finfo = frame.info.finfo;
+        const int wsub = GST_VIDEO_FORMAT_INFO_W_SUB(finfo, c);
+        const int hsub = GST_VIDEO_FORMAT_INFO_H_SUB(finfo, c);
+        quint8 *data = static_cast<quint8 *>(GST_VIDEO_FRAME_COMP_DATA(&frame, c));
+
+        for (int y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT(&frame, c); ++y) {
+            for (int x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH(&frame, c); ++x) {
+                const bool inside = x >= (crop.x() >> wsub) && x < ((crop.right() + 1) >> wsub)
+                                 && y >= (crop.y() >> hsub) && y < ((crop.bottom() + 1) >> hsub);
+                data[y * GST_VIDEO_FRAME_COMP_STRIDE(&frame, c)
+                     + x * GST_VIDEO_FRAME_COMP_PSTRIDE(&frame, c)] =
+                        inside ? (yuv ? yuvRed[c] : red[c]) : (yuv ? yuvGreen[c] : green[c]);
+            }
+        }
+    }
+    gst_video_frame_unmap(&frame);
+
+    GstCaps *caps = BufferFormat::newCaps(format, crop.size(), Fraction(1, 1), Fraction(1, 1));
+    BufferFormat bufferFormat = BufferFormat::fromCaps(caps);
+    gst_caps_unref(caps);
+
+    PaintAreas areas;
+    areas.targetArea = QRectF(QPointF(0,0), bufferFormat.frameSize());
+    areas.videoArea = areas.targetArea;
+    areas.sourceRect = QRectF(0, 0, 1, 1);
+
+    GenericSurfacePainter genericSurfacePainter;
+    try {
+        genericSurfacePainter.init(bufferFormat);
+    } catch (const QString & error) {
+        QFAIL("Failed to initialize GenericSurfacePainter");
+    }
+
+    QImage targetImage(crop.size(), QImage::Format_ARGB32);
+    targetImage.fill(Qt::black);
+    QPainter painter(&targetImage);
+
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
+    QCOMPARE(bufferFormat.cropRect(&frame), crop);
+    genericSurfacePainter.paint(&frame, bufferFormat, &painter, areas);
+    gst_video_frame_unmap(&frame);
+    gst_buffer_unref(buffer);
+
+    // the corners show that neither the padding nor the cropped out area got in
+    const QPoint points[] = { QPoint(0, 0), QPoint(99, 0), QPoint(0, 99), QPoint(99, 99), QPoint(50, 50) };
+    for (uint i = 0; i < G_N_ELEMENTS(points); ++i) {
+        QRgb pixel = targetImage.pixel(points[i]);
+        if (!pixelsSimilar(pixel, qRgb(255, 0, 0))) {
+            qWarning("Found (%d, %d, %d) at (%d, %d)", qRed(pixel), qGreen(pixel), qBlue(pixel),
+                     points[i].x(), points[i].y());
+            QFAIL("The padding or the cropped out area of the frame was painted");
+        }
+    }
+}
+
+//------------------------------------
+
+void QtVideoSinkTest::overlayCompositionTest()
+{
+    // a blue 100x100 frame, with a 10x10 red overlay that is scaled
+    // to render at (20, 30, 40, 20) of the frame
+    GstCaps *caps = BufferFormat::newCaps(GST_VIDEO_FORMAT_BGRA, QSize(100, 100),
+                                          Fraction(1, 1), Fraction(1, 1));
+    BufferFormat bufferFormat = BufferFormat::fromCaps(caps);
+    gst_caps_unref(caps);
+    GstVideoInfo videoInfo = bufferFormat.videoInfo();
+
+    GstBuffer *buffer = gst_buffer_new_allocate(NULL, GST_VIDEO_INFO_SIZE(&videoInfo), NULL);
+    GstMapInfo info;
+    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_WRITE));
+    for (gsize i = 0; i < info.size; i += 4) {
+        info.data[i] = 255;     // B
+        info.data[i + 1] = 0;   // G
+        info.data[i + 2] = 0;   // R
+        info.data[i + 3] = 255; // A
+    }
     gst_buffer_unmap(buffer, &info);
+
+    GstBuffer *pixels = gst_buffer_new_allocate(NULL, 10 * 10 * 4, NULL);
+    gst_buffer_add_video_meta(pixels, GST_VIDEO_FRAME_FLAG_NONE,
+                              GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 10, 10);
+    QVERIFY(gst_buffer_map(pixels, &info, GST_MAP_WRITE));
+    for (gsize i = 0; i < info.size; i += 4) {
+        *reinterpret_cast<quint32 *>(info.data + i) = 0xffff0000; // native endian ARGB
+    }
+    gst_buffer_unmap(pixels, &info);
+
+    GstVideoOverlayRectangle *rectangle = gst_video_overlay_rectangle_new_raw(
+            pixels, 20, 30, 40, 20, GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+    gst_buffer_unref(pixels);
+    GstVideoOverlayComposition *composition = gst_video_overlay_composition_new(rectangle);
+    gst_buffer_add_video_overlay_composition_meta(buffer, composition);
+
+    // the same rectangle in another composition, as when a subtitle stays on screen
+    GstBuffer *nextBuffer = gst_buffer_copy(buffer);
+    gst_buffer_remove_meta(nextBuffer, GST_META_CAST(
+            gst_buffer_get_video_overlay_composition_meta(nextBuffer)));
+    GstVideoOverlayComposition *nextComposition = gst_video_overlay_composition_new(rectangle);
+    gst_buffer_add_video_overlay_composition_meta(nextBuffer, nextComposition);
+
+    gst_video_overlay_composition_unref(composition);
+    gst_video_overlay_composition_unref(nextComposition);
+    gst_video_overlay_rectangle_unref(rectangle);
+
+    // the images are only converted again if the rectangles change
+    OverlayComposition overlays;
+    QVERIFY(overlays.update(buffer));
+    QCOMPARE(overlays.rectangles().size(), 1);
+    QCOMPARE(overlays.rectangles()[0].renderRect, QRect(20, 30, 40, 20));
+    QCOMPARE(overlays.rectangles()[0].image.size(), QSize(10, 10));
+    const qint64 cacheKey = overlays.rectangles()[0].image.cacheKey();
+    QVERIFY(!overlays.update(buffer));
+    QVERIFY(overlays.update(nextBuffer));
+    QCOMPARE(overlays.rectangles()[0].image.cacheKey(), cacheKey);
+    gst_buffer_unref(nextBuffer);
+
+    // the frame is painted twice as big, so the overlay gets there too
+    PaintAreas areas;
+    areas.targetArea = QRectF(0, 0, 200, 200);
+    areas.videoArea = areas.targetArea;
+    areas.sourceRect = QRectF(0, 0, 1, 1);
+
+    QRectF target, source;
+    QVERIFY(OverlayComposition::mapRectangle(QRect(20, 30, 40, 20), bufferFormat.frameSize(),
+                                             areas, &target, &source));
+    QCOMPARE(target, QRectF(40, 60, 80, 40));
+    QCOMPARE(source, QRectF(0, 0, 1, 1));
+
+    GenericSurfacePainter genericSurfacePainter;
+    try {
+        genericSurfacePainter.init(bufferFormat);
+    } catch (const QString & error) {
+        QFAIL("Failed to initialize GenericSurfacePainter");
+    }
+
+    QImage targetImage(QSize(200, 200), QImage::Format_ARGB32);
+    targetImage.fill(Qt::black);
+    QPainter painter(&targetImage);
+
+    GstVideoFrame frame;
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
+    genericSurfacePainter.paint(&frame, bufferFormat, &painter, areas);
+    gst_video_frame_unmap(&frame);
+    gst_buffer_unref(buffer);
+
+    QCOMPARE(targetImage.pixel(20, 20), qRgb(0, 0, 255));
+    QCOMPARE(targetImage.pixel(80, 80), qRgb(255, 0, 0));
+    QCOMPARE(targetImage.pixel(41, 61), qRgb(255, 0, 0));
+    QCOMPARE(targetImage.pixel(118, 98), qRgb(255, 0, 0));
+    QCOMPARE(targetImage.pixel(130, 80), qRgb(0, 0, 255));
+    QCOMPARE(targetImage.pixel(80, 110), qRgb(0, 0, 255));
+}
+
+//------------------------------------
+
+void QtVideoSinkTest::yuvConverterKernelsTest_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<YuvConverter::Coefficients>("coefficients");
+
+    const YuvConverter::Coefficients bt601 = { 75, 102, 25, 52, 129 };
+    const YuvConverter::Coefficients bt709 = { 75, 115, 14, 34, 135 };
+
+    // none of them is a multiple of the 8 and 16 pixels of the SIMD kernels
+    const int widths[] = { 1, 7, 15, 17, 31, 33, 1001 };
+    for (uint i = 0; i < G_N_ELEMENTS(widths); ++i) {
+        QByteArray name = QByteArray::number(widths[i]) + " pixels ";
+        QTest::newRow(name + "BT.601") << widths[i] << bt601;
+        QTest::newRow(name + "BT.709") << widths[i] << bt709;
+    }
+}
+
+void QtVideoSinkTest::yuvConverterKernelsTest()
+{
+    QFETCH(int, width);
+    QFETCH(YuvConverter::Coefficients, coefficients);
+
+    // random samples, with plenty of extreme values to exercise the clamping
+    qsrand(width);
+    QByteArray samples(width + 2 * ((width + 1) / 2), Qt::Uninitialized);
+    for (int i = 0; i < samples.size(); ++i) {
+        const int r = qrand();
+        samples[i] = char((r & 3) == 0 ? ((r & 4) ? 255 : 0) : (r >> 3) & 0xff);
+    }
+    const quint8 *y = reinterpret_cast<const quint8 *>(samples.constData());
+    const quint8 *u = y + width;
+    const quint8 *v = u + (width + 1) / 2;
+
+    QVector<quint32> expected(width);
+    QVERIFY(YuvConverter::convertRow("c", y, u, v, expected.data(), width, coefficients));
+
+    const QList<QByteArray> kernels = YuvConverter::availableKernels();
+    QVERIFY(kernels.contains(YuvConverter::kernelName()));
+
+    Q_FOREACH(const QByteArray & kernel, kernels) {
+        QVector<quint32> result(width);
+        QVERIFY(YuvConverter::convertRow(kernel, y, u, v, result.data(), width, coefficients));
+        for (int x = 0; x < width; ++x) {
+            if (result[x] != expected[x]) {
+                QFAIL(qPrintable(QString::fromLatin1("%1 kernel: pixel %2 is %3 instead of %4")
+                                 .arg(QString::fromLatin1(kernel)).arg(x)
+                                 .arg(result[x], 8, 16, QLatin1Char('0'))
+                                 .arg(expected[x], 8, 16, QLatin1Char('0'))));
+            }
+        }
+    }
+}
+
+void QtVideoSinkTest::yuvConverterBenchmark_data()
+{
+    QTest::addColumn<GstVideoFormat>("format");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<bool>("videoconvert");
+
+    const GstVideoFormat formats[] = {
+        GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_YUY2
+    };
+    const QSize sizes[] = { QSize(1280, 720), QSize(1920, 1080) };
+    GEnumClass *gstVideoFormatClass = G_ENUM_CLASS(g_type_class_ref(GST_TYPE_VIDEO_FORMAT));
+
+    for (uint i = 0; i < G_N_ELEMENTS(formats); ++i) {
+        GEnumValue *value = g_enum_get_value(gstVideoFormatClass, formats[i]);
+        for (uint j = 0; j < G_N_ELEMENTS(sizes); ++j) {
+            QByteArray name = QByteArray(value->value_name) + ' '
+                    + QByteArray::number(sizes[j].height()) + "p ";
+            QTest::newRow(name + "YuvConverter " + YuvConverter::kernelName())
+                    << formats[i] << sizes[j] << false;
+            QTest::newRow(name + "videoconvert") << formats[i] << sizes[j] << true;
+        }
+    }
+
+    g_type_class_unref(gstVideoFormatClass);
+}
+
+void QtVideoSinkTest::yuvConverterBenchmark()
+{
+    QFETCH(GstVideoFormat, format);
+    QFETCH(QSize, size);
+    QFETCH(bool, videoconvert);
+
+#if !GST_CHECK_VERSION(1, 6, 0)
+    if (videoconvert) {
+        QSKIP_PORT("Skipping because GstVideoConverter needs GStreamer 1.6", SkipSingle);
+    }
+#endif
+
+    GstCaps *caps = BufferFormat::newCaps(format, size, Fraction(1, 1), Fraction(1, 1));
+    BufferFormat bufferFormat = BufferFormat::fromCaps(caps);
+    gst_caps_unref(caps);
+    GstVideoInfo videoInfo = bufferFormat.videoInfo();
+
+    // the contents do not matter for the speed of the conversion
+    QByteArray frame(GST_VIDEO_INFO_SIZE(&videoInfo), Qt::Uninitialized);
+    for (int i = 0; i < frame.size(); ++i) {
+        frame[i] = char(i * 7);
+    }
+
+    QImage image(size, QImage::Format_RGB32);
+
+    if (!videoconvert) {
+        YuvConverter converter;
+        converter.init(bufferFormat);
+
+        GstBuffer *yuvBuffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY,
+                frame.data(), frame.size(), 0, frame.size(), NULL, NULL);
+        GstVideoFrame yuvFrame;
+        QVERIFY(bufferFormat.mapFrame(&yuvFrame, yuvBuffer));
+
+        QBENCHMARK {
+            converter.convert(&yuvFrame, QPoint(0, 0), image);
+        }
+
+        gst_video_frame_unmap(&yuvFrame);
+        gst_buffer_unref(yuvBuffer);
+    } else {
+#if GST_CHECK_VERSION(1, 6, 0)
+        // this is what the videoconvert element does for every frame
+        GstVideoInfo rgbInfo;
+        gst_video_info_set_format(&rgbInfo,
+                Q_BYTE_ORDER == Q_BIG_ENDIAN ? GST_VIDEO_FORMAT_xRGB : GST_VIDEO_FORMAT_BGRx,
+                size.width(), size.height());
+
+        GstBuffer *yuvBuffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY,
+                frame.data(), frame.size(), 0, frame.size(), NULL, NULL);
+        GstBuffer *rgbBuffer = gst_buffer_new_wrapped_full(GstMemoryFlags(0),
+                image.bits(), image.bytesPerLine() * image.height(),
+                0, image.bytesPerLine() * image.height(), NULL, NULL);
+
+        GstVideoFrame yuvFrame, rgbFrame;
+        QVERIFY(gst_video_frame_map(&yuvFrame, &videoInfo, yuvBuffer, GST_MAP_READ));
+        QVERIFY(gst_video_frame_map(&rgbFrame, &rgbInfo, rgbBuffer, GST_MAP_WRITE));
+
+        GstVideoConverter *converter = gst_video_converter_new(&videoInfo, &rgbInfo, NULL);
+        QVERIFY(converter);
+
+        QBENCHMARK {
+            gst_video_converter_frame(converter, &yuvFrame, &rgbFrame);
+        }
+
+        gst_video_converter_free(converter);
+        gst_video_frame_unmap(&rgbFrame);
+        gst_video_frame_unmap(&yuvFrame);
+        gst_buffer_unref(rgbBuffer);
+        gst_buffer_unref(yuvBuffer);
+#endif
+    }
 }
 
 //------------------------------------
@@ -435,6 +830,7 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest_data()
 {
     QTest::addColumn<GstVideoFormat>("format");
     QTest::addColumn<bool>("glsl");
+    QTest::addColumn<bool>("pbo");
 
 
     QSet<GstVideoFormat> formats = OpenGLSurfacePainter::supportedPixelFormats();
@@ -442,8 +838,10 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest_data()
 
     Q_FOREACH(GstVideoFormat format, formats) {
         GEnumValue *value = g_enum_get_value(gstVideoFormatClass, format);
-        QTest::newRow(QByteArray("glsl ") + value->value_name) << format << true;
-        QTest::newRow(QByteArray("arbfp ") + value->value_name) << format << false;
+        QTest::newRow(QByteArray("glsl ") + value->value_name) << format << true << false;
+        QTest::newRow(QByteArray("glsl pbo ") + value->value_name) << format << true << true;
+        QTest::newRow(QByteArray("arbfp ") + value->value_name) << format << false << false;
+        QTest::newRow(QByteArray("arbfp pbo ") + value->value_name) << format << false << true;
     }
 
     g_type_class_unref(gstVideoFormatClass);
@@ -453,6 +851,7 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
 {
     QFETCH(GstVideoFormat, format);
     QFETCH(bool, glsl);
+    QFETCH(bool, pbo);
     QVERIFY(format != GST_VIDEO_FORMAT_UNKNOWN);
 
     if (glsl && !haveGlsl) {
@@ -463,6 +862,10 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
         QSKIP_PORT("Skipping because the system does not support ARB Fragment Programs", SkipSingle);
     }
 
+    if (pbo && !havePbo) {
+        QSKIP_PORT("Skipping because the system does not support pixel buffer objects", SkipSingle);
+    }
+
     GstCaps *caps = BufferFormat::newCaps(format, QSize(100, 100), Fraction(1, 1), Fraction(1, 1));
     BufferFormat bufferFormat = BufferFormat::fromCaps(caps);
     gst_caps_unref(caps);
@@ -475,7 +878,7 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
     QGLPixelBuffer pixelBuffer(100, 100);
     pixelBuffer.makeCurrent();
 
-    QScopedPointer<AbstractSurfacePainter> glSurfacePainter;
+    QScopedPointer<OpenGLSurfacePainter> glSurfacePainter;
     if (glsl) {
         glSurfacePainter.reset(new GlslSurfacePainter);
     } else {
@@ -485,6 +888,7 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
     }
 
     QVERIFY(glSurfacePainter->supportsFormat(format));
+    glSurfacePainter->setPixelBufferObjectsEnabled(pbo);
 
     try {
         glSurfacePainter->init(bufferFormat);
@@ -497,13 +901,13 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
 
     GstSamplePtr sample(generateTestSample(format, 4)); //pattern = red
     QVERIFY(!sample.isNull());
-    GstMapInfo info;
+    GstVideoFrame frame;
     GstBuffer *buffer = gst_sample_get_buffer(sample.data());
     QVERIFY(buffer);
 
-    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
     glSurfacePainter->paint(
-        info.data,
+        &frame,
         bufferFormat,
         &painter,
         areas);
@@ -515,15 +919,15 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
                 qRed(pixel2), qGreen(pixel2), qBlue(pixel2));
         QFAIL("Failing due to differences in the compared images");
     }
-    gst_buffer_unmap(buffer, &info);
+    gst_video_frame_unmap(&frame);
 
     sample.reset(generateTestSample(format, 5)); //pattern = green
     QVERIFY(!sample.isNull());
     buffer = gst_sample_get_buffer(sample.data());
     QVERIFY(buffer);
-    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
     glSurfacePainter->paint(
-        info.data,
+        &frame,
         bufferFormat,
         &painter,
         areas);
@@ -534,15 +938,15 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
                 qRed(pixel1), qGreen(pixel1), qBlue(pixel1),
                 qRed(pixel2), qGreen(pixel2), qBlue(pixel2));
     }
-    gst_buffer_unmap(buffer, &info);
+    gst_video_frame_unmap(&frame);
 
     sample.reset(generateTestSample(format, 6)); //pattern = blue
     QVERIFY(!sample.isNull());
     buffer = gst_sample_get_buffer(sample.data());
     QVERIFY(buffer);
-    QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+    QVERIFY(bufferFormat.mapFrame(&frame, buffer));
     glSurfacePainter->paint(
-        info.data,
+        &frame,
         bufferFormat,
         &painter,
         areas);
@@ -557,12 +961,12 @@ void QtVideoSinkTest::glSurfacePainterFormatsTest()
 
     QBENCHMARK {
         glSurfacePainter->paint(
-            info.data,
+            &frame,
             bufferFormat,
             &painter,
             areas);
     }
-    gst_buffer_unmap(buffer, &info);
+    gst_video_frame_unmap(&frame);
 
 }
 
@@ -610,6 +1014,20 @@ void QtVideoSinkTest::qtVideoSinkTest_data()
             << false
             << true;
 
+    QTest::newRow("NV12 320x240 -> 400x240")
+            << GST_VIDEO_FORMAT_NV12
+            << QSize(320, 240)
+            << QSize(400, 240)
+            << true
+            << true;
+
+    QTest::newRow("YUY2 320x240 -> 400x240 scaled")
+            << GST_VIDEO_FORMAT_YUY2
+            << QSize(320, 240)
+            << QSize(400, 240)
+            << false
+            << true;
+
     QTest::newRow("RGB16 320x240 -> 400x500")
             << GST_VIDEO_FORMAT_RGB16
             << QSize(320, 240)
@@ -812,6 +1230,30 @@ void QtVideoSinkTest::qtVideoSinkTest()
     //and wait a bit for X/window manager/GPU/whatever to actually render the window
     QTest::qWait(1000);
 
+    //the preroll buffer must have been received and painted by now
+    GstStructure *stats = NULL;
+    g_object_get(qtvideosink.data(), "stats", &stats, NULL);
+    QVERIFY(stats);
+
+    guint64 framesReceived = 0, framesRendered = 0, paints = 0;
+    QVERIFY(gst_structure_get(stats,
+                "frames-received", G_TYPE_UINT64, &framesReceived,
+                "frames-rendered", G_TYPE_UINT64, &framesRendered,
+                "paints", G_TYPE_UINT64, &paints,
+                NULL));
+    QVERIFY(framesReceived >= 1);
+    QVERIFY(framesRendered >= 1);
+    QVERIFY(paints >= framesRendered);
+
+    const GValue *histogram = gst_structure_get_value(stats, "latency-histogram");
+    QVERIFY(histogram && GST_VALUE_HOLDS_ARRAY(histogram));
+    guint64 histogramTotal = 0;
+    for (guint i = 0; i < gst_value_array_get_size(histogram); ++i) {
+        histogramTotal += g_value_get_uint64(gst_value_array_get_value(histogram, i));
+    }
+    QCOMPARE(histogramTotal, framesRendered);
+    gst_structure_free(stats);
+
     GstSample *samplePtr = NULL;
     gst_child_proxy_get(GST_CHILD_PROXY(pipeline.data()), "fakesink::last-sample", &samplePtr, NULL);
 
@@ -869,6 +1311,175 @@ void QtVideoSinkTest::qtVideoSinkTest()
 
 //------------------------------------
 
+void QtVideoSinkTest::allocationTest()
+{
+    GstElementPtr qtvideosink(gst_element_factory_make(G_STRINGIFY(QTVIDEOSINK_NAME), NULL));
+    QVERIFY(qtvideosink);
+    gst_object_ref_sink(qtvideosink.data());
+
+    // none of the rows of the planes is a multiple of 16 bytes long
+    GstCaps *caps = BufferFormat::newCaps(GST_VIDEO_FORMAT_I420, QSize(100, 100),
+                                          Fraction(30, 1), Fraction(1, 1));
+    GstVideoInfo videoInfo;
+    QVERIFY(gst_video_info_from_caps(&videoInfo, caps));
+
+    GstQuery *query = gst_query_new_allocation(caps, TRUE);
+    GstPad *pad = gst_element_get_static_pad(qtvideosink.data(), "sink");
+    bool queryResult = gst_pad_query(pad, query);
+    gst_object_unref(pad);
+    gst_caps_unref(caps);
+
+    QVERIFY(queryResult);
+    QCOMPARE(gst_query_get_n_allocation_pools(query), 1u);
+
+    GstBufferPool *pool = NULL;
+    guint size, minBuffers, maxBuffers;
+    gst_query_parse_nth_allocation_pool(query, 0, &pool, &size, &minBuffers, &maxBuffers);
+    QVERIFY(gst_query_find_allocation_meta(query, GST_VIDEO_META_API_TYPE, NULL));
+    QVERIFY(gst_query_find_allocation_meta(query, GST_VIDEO_CROP_META_API_TYPE, NULL));
+    QVERIFY(gst_query_find_allocation_meta(query,
+                GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE, NULL));
+    gst_query_unref(query);
+
+    QVERIFY(pool);
+    QVERIFY(size >= static_cast<guint>(videoInfo.size));
+    QVERIFY(minBuffers >= 2);
+
+    GstStructure *config = gst_buffer_pool_get_config(pool);
+    QVERIFY(gst_buffer_pool_config_has_option(config, GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT));
+    gst_structure_free(config);
+
+    QVERIFY(gst_buffer_pool_set_active(pool, TRUE));
+
+    //simulate steady state playback, with the sink holding on to up to two frames;
+    //the pool must keep recycling the same buffers instead of allocating new ones
+    QSet<GstBuffer*> allocatedBuffers;
+    GstBuffer *held[2] = { NULL, NULL };
+    for (int i = 0; i < 100; ++i) {
+        GstBuffer *buffer = NULL;
+        QCOMPARE(gst_buffer_pool_acquire_buffer(pool, &buffer, NULL), GST_FLOW_OK);
+        allocatedBuffers.insert(buffer);
+
+        GstMapInfo info;
+        QVERIFY(gst_buffer_map(buffer, &info, GST_MAP_READ));
+        QCOMPARE(reinterpret_cast<quintptr>(info.data) % 16, static_cast<quintptr>(0));
+        gst_buffer_unmap(buffer, &info);
+
+        // the rows of every plane are padded to keep them aligned as well
+        GstVideoMeta *meta = gst_buffer_get_video_meta(buffer);
+        QVERIFY(meta);
+        for (guint plane = 0; plane < meta->n_planes; ++plane) {
+            QCOMPARE(meta->stride[plane] % 16, 0);
+            QCOMPARE(meta->offset[plane] % 16, static_cast<gsize>(0));
+        }
+
+        if (held[i % 2]) {
+            gst_buffer_unref(held[i % 2]);
+        }
+        held[i % 2] = buffer;
+    }
+    gst_buffer_unref(held[0]);
+    gst_buffer_unref(held[1]);
+
+    QVERIFY(static_cast<guint>(allocatedBuffers.size()) <= qMax(minBuffers, 3u));
+
+    QVERIFY(gst_buffer_pool_set_active(pool, FALSE));
+    gst_object_unref(pool);
+}
+
+struct PlaybackAllocationStats
+{
+    PlaybackAllocationStats() : frames(0), pool(NULL), unpooledFrames(0) {}
+
+    QMutex mutex;
+    int frames;
+    QSet<GstBuffer*> buffers;
+    GstBufferPool *pool;
+    int unpooledFrames;
+};
+
+static GstPadProbeReturn playbackAllocationProbe(GstPad*, GstPadProbeInfo *info, gpointer userData)
+{
+    PlaybackAllocationStats *stats = static_cast<PlaybackAllocationStats*>(userData);
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+
+    QMutexLocker lock(&stats->mutex);
+    ++stats->frames;
+    stats->buffers.insert(buffer);
+    if (!buffer->pool) {
+        ++stats->unpooledFrames;
+    } else if (!stats->pool) {
+        stats->pool = GST_BUFFER_POOL(gst_object_ref(buffer->pool));
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+void QtVideoSinkTest::playbackAllocationTest()
+{
+    GstPipelinePtr pipeline(GST_PIPELINE(gst_pipeline_new("playback-allocation-pipeline")));
+    GstElement *videotestsrc = gst_element_factory_make("videotestsrc", NULL);
+    GstElement *capsfilter = gst_element_factory_make("capsfilter", NULL);
+    GstElement *qtvideosink = gst_element_factory_make(G_STRINGIFY(QTVIDEOSINK_NAME), NULL);
+    QVERIFY(videotestsrc && capsfilter && qtvideosink);
+    gst_bin_add_many(GST_BIN(pipeline.data()), videotestsrc, capsfilter, qtvideosink, NULL);
+    QVERIFY(gst_element_link_many(videotestsrc, capsfilter, qtvideosink, NULL));
+
+    const int frameCount = 100;
+    GstCaps *caps = BufferFormat::newCaps(GST_VIDEO_FORMAT_I420, QSize(100, 100),
+                                          Fraction(30, 1), Fraction(1, 1));
+    g_object_set(capsfilter, "caps", caps, NULL);
+    gst_caps_unref(caps);
+    g_object_set(videotestsrc, "num-buffers", frameCount, NULL);
+    g_object_set(qtvideosink, "sync", FALSE, NULL);
+
+    PlaybackAllocationStats stats;
+    GstPad *pad = gst_element_get_static_pad(qtvideosink, "sink");
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, &playbackAllocationProbe, &stats, NULL);
+    gst_object_unref(pad);
+
+    VideoWidget widget;
+    widget.setVideoSink(GST_ELEMENT(gst_object_ref(qtvideosink)));
+    widget.resize(100, 100);
+    widget.show();
+
+    QCOMPARE(gst_element_set_state(GST_ELEMENT(pipeline.data()), GST_STATE_PLAYING),
+             GST_STATE_CHANGE_ASYNC);
+
+    // keep painting the frames until the end of the stream
+    GstBus *bus = gst_element_get_bus(GST_ELEMENT(pipeline.data()));
+    GstMessage *message = NULL;
+    QElapsedTimer timer;
+    timer.start();
+    while (!message && timer.elapsed() < 10000) {
+        QCoreApplication::processEvents();
+        message = gst_bus_timed_pop_filtered(bus, 10 * GST_MSECOND,
+                GstMessageType(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+    }
+    gst_object_unref(bus);
+
+    QVERIFY(message);
+    const GstMessageType messageType = GST_MESSAGE_TYPE(message);
+    gst_message_unref(message);
+    QCOMPARE(messageType, GST_MESSAGE_EOS);
+    gst_element_set_state(GST_ELEMENT(pipeline.data()), GST_STATE_NULL);
+
+    // every frame came from the pool that the sink proposed...
+    QCOMPARE(stats.frames, frameCount);
+    QCOMPARE(stats.unpooledFrames, 0);
+    QVERIFY(stats.pool);
+    GstStructure *config = gst_buffer_pool_get_config(stats.pool);
+    QVERIFY(gst_buffer_pool_config_has_option(config, GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT));
+    gst_structure_free(config);
+    gst_object_unref(stats.pool);
+
+    // ...which kept recycling a handful of buffers instead of allocating one per frame
+    QVERIFY2(stats.buffers.size() <= 8,
+             qPrintable(QString::fromLatin1("%1 buffers were allocated for %2 frames")
+                        .arg(stats.buffers.size()).arg(frameCount)));
+}
+
+//------------------------------------
+
 #define MAKE_ELEMENT(variable, name) \
     GstElement *variable = gst_element_factory_make(name, #variable); \
     if (!variable) { \
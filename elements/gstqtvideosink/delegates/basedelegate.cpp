@@ -32,6 +32,13 @@ BaseDelegate::BaseDelegate(GstElement * sink, QObject * parent)
     , m_formatDirty(true)
     , m_isActive(false)
     , m_buffer(NULL)
+    , m_bufferTime(0)
+    , m_bufferPainted(false)
+    , m_hasFrame(false)
+    , m_pendingBuffer(NULL)
+    , m_pendingBufferTime(0)
+    , m_pendingFormatDirty(false)
+    , m_wakeupPending(false)
     , m_sink(sink)
 {
 }
@@ -39,6 +46,9 @@ BaseDelegate::BaseDelegate(GstElement * sink, QObject * parent)
 BaseDelegate::~BaseDelegate()
 {
     Q_ASSERT(!isActive());
+
+    gst_buffer_replace(&m_pendingBuffer, NULL);
+    gst_buffer_replace(&m_buffer, NULL);
 }
 
 //-------------------------------------
@@ -54,14 +64,83 @@ void BaseDelegate::setActive(bool active)
     GST_INFO_OBJECT(m_sink, active ? "Activating" : "Deactivating");
 
     QWriteLocker l(&m_isActiveLock);
+    if (active && !m_isActive) {
+        m_stats.reset();
+    }
     m_isActive = active;
     if (!active) {
+        QMutexLocker pendingLocker(&m_pendingLock);
+        gst_buffer_replace(&m_pendingBuffer, NULL);
+        pendingLocker.unlock();
+
         QCoreApplication::postEvent(this, new DeactivateEvent());
     }
 }
 
 //-------------------------------------
 
+void BaseDelegate::pushBuffer(GstBuffer *buffer)
+{
+    QMutexLocker l(&m_pendingLock);
+
+    m_stats.frameReceived();
+    if (m_pendingBuffer) {
+        GST_LOG_OBJECT(m_sink, "Dropping buffer %" GST_PTR_FORMAT
+                       " that was not painted in time", m_pendingBuffer);
+        m_stats.frameDropped();
+    }
+
+    gst_buffer_replace(&m_pendingBuffer, buffer);
+    m_pendingBufferTime = RenderingStats::now();
+    postWakeup();
+}
+
+void BaseDelegate::pushBufferFormat(const BufferFormat & format)
+{
+    QMutexLocker l(&m_pendingLock);
+
+    // a pending buffer has the old format and it must not be painted with the new one
+    if (m_pendingBuffer) {
+        GST_LOG_OBJECT(m_sink, "Dropping buffer %" GST_PTR_FORMAT
+                       " because of a format change", m_pendingBuffer);
+        gst_buffer_replace(&m_pendingBuffer, NULL);
+        m_stats.frameDropped();
+    }
+
+    m_pendingFormat = format;
+    m_pendingFormatDirty = true;
+    postWakeup();
+}
+
+void BaseDelegate::postWakeup()
+{
+    if (!m_wakeupPending) {
+        m_wakeupPending = true;
+        QCoreApplication::postEvent(this,
+                new QEvent(static_cast<QEvent::Type>(BufferEventType)));
+    }
+}
+
+quint64 BaseDelegate::droppedFrames() const
+{
+    return m_stats.droppedFrames();
+}
+
+GstStructure *BaseDelegate::stats() const
+{
+    return m_stats.toStructure();
+}
+
+void BaseDelegate::recordPaint(qint64 paintStartTime, qint64 uploadTime)
+{
+    const qint64 now = RenderingStats::now();
+    m_stats.framePainted(!m_bufferPainted, now - m_bufferTime,
+                         uploadTime, now - paintStartTime);
+    m_bufferPainted = true;
+}
+
+//-------------------------------------
+
 int BaseDelegate::brightness() const
 {
     QReadLocker l(&m_colorsLock);
@@ -152,28 +231,35 @@ bool BaseDelegate::event(QEvent *event)
     switch((int) event->type()) {
     case BufferEventType:
     {
-        BufferEvent *bufEvent = dynamic_cast<BufferEvent*>(event);
-        Q_ASSERT(bufEvent);
+        QMutexLocker l(&m_pendingLock);
+        m_wakeupPending = false;
 
-        GST_TRACE_OBJECT(m_sink, "Received buffer %" GST_PTR_FORMAT, bufEvent->buffer);
+        GstBuffer *buffer = m_pendingBuffer;
+        qint64 bufferTime = m_pendingBufferTime;
+        m_pendingBuffer = NULL;
 
-        if (isActive()) {
-            gst_buffer_replace (&m_buffer, bufEvent->buffer);
-            update();
-        }
+        if (m_pendingFormatDirty) {
+            GST_TRACE_OBJECT (m_sink, "Received new buffer format: %s",
+                              gst_video_format_to_string(m_pendingFormat.videoFormat()));
 
-        return true;
-    }
-    case BufferFormatEventType:
-    {
-        BufferFormatEvent *bufFmtEvent = dynamic_cast<BufferFormatEvent*>(event);
-        Q_ASSERT(bufFmtEvent);
-
-        GST_TRACE_OBJECT (m_sink, "Received buffer format event. New format: %s",
-                          gst_video_format_to_string(bufFmtEvent->format.videoFormat()));
-
-        m_formatDirty = true;
-        m_bufferFormat = bufFmtEvent->format;
+            m_formatDirty = true;
+            m_bufferFormat = m_pendingFormat;
+            m_pendingFormatDirty = false;
+        }
+        l.unlock();
+
+        if (buffer) {
+            GST_TRACE_OBJECT(m_sink, "Received buffer %" GST_PTR_FORMAT, buffer);
+
+            if (isActive()) {
+                gst_buffer_replace (&m_buffer, buffer);
+                m_bufferTime = bufferTime;
+                m_bufferPainted = false;
+                m_hasFrame = true;
+                update();
+            }
+            gst_buffer_unref(buffer);
+        }
 
         return true;
     }
@@ -182,6 +268,7 @@ bool BaseDelegate::event(QEvent *event)
         GST_LOG_OBJECT(m_sink, "Received deactivate event");
 
         gst_buffer_replace (&m_buffer, NULL);
+        m_hasFrame = false;
         update();
 
         return true;
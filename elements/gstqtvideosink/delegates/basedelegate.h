@@ -23,9 +23,11 @@
 #include "../gstqtvideosinkplugin.h" //for debug category
 #include "../utils/bufferformat.h"
 #include "../utils/utils.h"
+#include "../utils/renderingstats.h"
 
 #include <QObject>
 #include <QEvent>
+#include <QMutex>
 #include <QReadWriteLock>
 
 class BaseDelegate : public QObject
@@ -34,38 +36,11 @@ class BaseDelegate : public QObject
 public:
     enum EventType {
         BufferEventType = QEvent::User,
-        BufferFormatEventType,
         DeactivateEventType
     };
 
     //-------------------------------------
 
-    class BufferEvent : public QEvent
-    {
-    public:
-        inline BufferEvent(GstBuffer *buf)
-            : QEvent(static_cast<QEvent::Type>(BufferEventType)),
-              buffer(gst_buffer_ref(buf))
-        {}
-
-        virtual ~BufferEvent() {
-            gst_buffer_unref(buffer);
-        }
-
-        GstBuffer *buffer;
-    };
-
-    class BufferFormatEvent : public QEvent
-    {
-    public:
-        inline BufferFormatEvent(const BufferFormat &format)
-            : QEvent(static_cast<QEvent::Type>(BufferFormatEventType)),
-            format(format)
-        {}
-
-        BufferFormat format;
-    };
-
     class DeactivateEvent : public QEvent
     {
     public:
@@ -83,6 +58,18 @@ public:
     bool isActive() const;
     void setActive(bool playing);
 
+    // called from the streaming thread to hand over the latest buffer / format.
+    // the delegate keeps only the latest buffer and wakes up the gui thread
+    // with at most one pending event
+    void pushBuffer(GstBuffer *buffer);
+    void pushBufferFormat(const BufferFormat & format);
+
+    // number of buffers that were replaced by a newer one before being painted
+    quint64 droppedFrames() const;
+
+    // stats property; returns a newly allocated structure
+    GstStructure *stats() const;
+
     // GstColorBalance interface
 
     int brightness() const;
@@ -112,6 +99,14 @@ protected:
     // tells the surface to repaint itself
     virtual void update();
 
+    // to be called by the subclasses after painting m_buffer, with the
+    // time the paint started at and the time spent uploading the frame
+    void recordPaint(qint64 paintStartTime, qint64 uploadTime);
+
+private:
+    // must be called with m_pendingLock held
+    void postWakeup();
+
 protected:
     // colorbalance interface properties
     mutable QReadWriteLock m_colorsLock;
@@ -139,8 +134,26 @@ protected:
     mutable QReadWriteLock m_isActiveLock;
     bool m_isActive;
 
-    // the buffer to be drawn next
+    // the buffer to be drawn next, the time it was pushed at
+    // and whether it has been painted already
     GstBuffer *m_buffer;
+    qint64 m_bufferTime;
+    bool m_bufferPainted;
+
+    // whether a frame has been received since the sink was activated;
+    // subclasses that keep the frame elsewhere may release m_buffer early
+    bool m_hasFrame;
+
+    // mailbox between the streaming thread and the gui thread
+    mutable QMutex m_pendingLock;
+    GstBuffer *m_pendingBuffer;
+    qint64 m_pendingBufferTime;
+    BufferFormat m_pendingFormat;
+    bool m_pendingFormatDirty;
+    bool m_wakeupPending;
+
+    // stats property
+    RenderingStats m_stats;
 
     // the video sink element
     GstElement * const m_sink;
@@ -26,7 +26,9 @@ QtQuick2VideoSinkDelegate::QtQuick2VideoSinkDelegate(GstElement *sink, QObject *
 QSGNode* QtQuick2VideoSinkDelegate::updateNode(QSGNode *node, const QRectF & targetArea)
 {
     GST_TRACE_OBJECT(m_sink, "updateNode called");
+    const qint64 paintStartTime = RenderingStats::now();
     bool sgnodeFormatChanged = false;
+    bool geometryChanged = false;
 
     VideoNode *vnode = dynamic_cast<VideoNode*>(node);
     if (!vnode) {
@@ -35,7 +37,9 @@ QSGNode* QtQuick2VideoSinkDelegate::updateNode(QSGNode *node, const QRectF & tar
         m_formatDirty = true;
     }
 
-    if (!m_buffer) {
+    // m_buffer is released once the material has the frame, so a material
+    // that has to be rebuilt shows black until the next frame arrives
+    if (!m_hasFrame || (!m_buffer && m_formatDirty)) {
         if (vnode->materialType() != VideoNode::MaterialTypeSolidBlack) {
             vnode->setMaterialTypeSolidBlack();
             sgnodeFormatChanged = true;
@@ -44,6 +48,9 @@ QSGNode* QtQuick2VideoSinkDelegate::updateNode(QSGNode *node, const QRectF & tar
             m_areas.targetArea = targetArea;
             vnode->updateGeometry(m_areas);
         }
+        if (m_overlays.update(NULL)) {
+            vnode->updateOverlays(m_overlays, QSize(), m_areas);
+        }
     } else {
         //change format before geometry, so that we change QSGGeometry as well
         if (m_formatDirty) {
@@ -79,6 +86,7 @@ QSGNode* QtQuick2VideoSinkDelegate::updateNode(QSGNode *node, const QRectF & tar
             );
 
             vnode->updateGeometry(m_areas);
+            geometryChanged = true;
         }
         forceAspectRatioLocker.unlock();
 
@@ -96,7 +104,24 @@ QSGNode* QtQuick2VideoSinkDelegate::updateNode(QSGNode *node, const QRectF & tar
         }
         colorsLocker.unlock();
 
-        vnode->setCurrentFrame(m_buffer);
+        // hand the frame to the material only when there is a new one;
+        // re-renders reuse the uploaded textures. The material releases the
+        // frame after uploading it, so the delegate does not keep it either
+        bool overlaysChanged = false;
+        if (m_buffer) {
+            vnode->setCurrentFrame(m_buffer);
+            overlaysChanged = m_overlays.update(m_buffer);
+            gst_buffer_replace(&m_buffer, NULL);
+        }
+
+        // a new node has no overlays yet, but then its geometry changed too
+        if (overlaysChanged || geometryChanged) {
+            vnode->updateOverlays(m_overlays, m_bufferFormat.frameSize(), m_areas);
+        }
+
+        // the textures are uploaded later on, when the scene graph renders
+        // the node, so this can only report how long the previous upload took
+        recordPaint(paintStartTime, vnode->lastUploadTime());
     }
 
     return vnode;
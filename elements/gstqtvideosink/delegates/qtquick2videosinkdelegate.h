@@ -18,6 +18,7 @@
 #define QTQUICK2VIDEOSINKDELEGATE_H
 
 #include "basedelegate.h"
+#include "../utils/overlaycomposition.h"
 #include <QtQuick/QSGNode>
 
 class QtQuick2VideoSinkDelegate : public BaseDelegate
@@ -27,6 +28,10 @@ public:
     explicit QtQuick2VideoSinkDelegate(GstElement * sink, QObject * parent = 0);
 
     QSGNode *updateNode(QSGNode *node, const QRectF & targetArea);
+
+private:
+    // the composition shown by the current node, only used in updateNode()
+    OverlayComposition m_overlays;
 };
 
 #endif // QTQUICK2VIDEOSINKDELEGATE_H
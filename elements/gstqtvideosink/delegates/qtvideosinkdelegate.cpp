@@ -105,10 +105,14 @@ void QtVideoSinkDelegate::paint(QPainter *painter, const QRectF & targetArea)
             }
             colorsLocker.unlock();
 
-            GstMapInfo mem_info;
-            if (gst_buffer_map(m_buffer, &mem_info, GST_MAP_READ)) {
-                m_painter->paint(mem_info.data, m_bufferFormat, painter, m_areas);
-                gst_buffer_unmap(m_buffer, &mem_info);
+            GstVideoFrame frame;
+            if (m_bufferFormat.mapFrame(&frame, m_buffer)) {
+                const qint64 paintStartTime = RenderingStats::now();
+                m_painter->paint(&frame, m_bufferFormat, painter, m_areas);
+                gst_video_frame_unmap(&frame);
+                recordPaint(paintStartTime, m_painter->lastUploadTime());
+            } else {
+                GST_WARNING_OBJECT(m_sink, "Failed to map buffer %" GST_PTR_FORMAT, m_buffer);
             }
         }
     }
@@ -18,9 +18,8 @@
 #include "gstqtglvideosinkbase.h"
 #include "painters/openglsurfacepainter.h"
 #include "delegates/qtvideosinkdelegate.h"
-#include <QCoreApplication>
 
-#define CAPS_FORMATS "{ BGRA, BGRx, ARGB, xRGB, RGB, RGB16, BGR, v308, AYUV, YV12, I420 }"
+#define CAPS_FORMATS "{ BGRA, BGRx, ARGB, xRGB, RGB, RGB16, BGR, v308, AYUV, YV12, I420, NV12, NV21, YUY2, UYVY }"
 
 const char * const GstQtGLVideoSinkBase::s_colorbalance_labels[] = {
     "contrast", "brightness", "hue", "saturation"
@@ -50,7 +49,10 @@ void GstQtGLVideoSinkBase::base_init(gpointer g_class)
 
     static GstStaticPadTemplate sink_pad_template =
         GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
-            GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (CAPS_FORMATS))
+            GST_STATIC_CAPS (
+                GST_VIDEO_CAPS_MAKE_WITH_FEATURES (
+                    GST_CAPS_FEATURE_META_GST_VIDEO_OVERLAY_COMPOSITION, CAPS_FORMATS) "; "
+                GST_VIDEO_CAPS_MAKE (CAPS_FORMATS))
         );
 
     gst_element_class_add_pad_template(
@@ -253,8 +255,7 @@ gboolean GstQtGLVideoSinkBase::set_caps(GstBaseSink *base, GstCaps *caps)
     GST_LOG_OBJECT(sink, "new caps %" GST_PTR_FORMAT, caps);
     BufferFormat format = BufferFormat::fromCaps(caps);
     if (OpenGLSurfacePainter::supportedPixelFormats().contains(format.videoFormat())) {
-        QCoreApplication::postEvent(sink->delegate,
-                                    new BaseDelegate::BufferFormatEvent(format));
+        sink->delegate->pushBufferFormat(format);
         return TRUE;
     } else {
         return FALSE;
@@ -19,13 +19,13 @@
 #include "gstqtvideosinkplugin.h"
 #include "gstqtvideosinkmarshal.h"
 #include "delegates/qtquick2videosinkdelegate.h"
+#include "utils/bufferpool.h"
 
 #include <gst/video/colorbalance.h>
 
 #include <cstring>
-#include <QCoreApplication>
 
-#define CAPS_FORMATS "{ BGRA, BGRx, ARGB, xRGB, RGB, RGB16, BGR, v308, AYUV, YV12, I420 }"
+#define CAPS_FORMATS "{ BGRA, BGRx, ARGB, xRGB, RGB, RGB16, BGR, v308, AYUV, YV12, I420, NV12, NV21, YUY2, UYVY }"
 
 #define GST_QT_QUICK2_VIDEO_SINK_GET_PRIVATE(obj) \
     (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_QT_QUICK2_VIDEO_SINK, GstQtQuick2VideoSinkPrivate))
@@ -52,6 +52,7 @@ enum {
     PROP_BRIGHTNESS,
     PROP_HUE,
     PROP_SATURATION,
+    PROP_STATS,
 };
 
 enum {
@@ -197,6 +198,9 @@ gst_qt_quick2_video_sink_get_property (GObject *object,
     case PROP_SATURATION:
         g_value_set_int(value, self->priv->delegate->saturation());
         break;
+    case PROP_STATS:
+        g_value_take_boxed(value, self->priv->delegate->stats());
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
         break;
@@ -235,14 +239,19 @@ gst_qt_quick2_video_sink_set_caps(GstBaseSink *sink, GstCaps *caps)
     //it should conform to the template caps formats, unless gstreamer
     //core has a bug.
     if (format.videoFormat() != GST_VIDEO_FORMAT_UNKNOWN) {
-        QCoreApplication::postEvent(self->priv->delegate,
-                                    new BaseDelegate::BufferFormatEvent(format));
+        self->priv->delegate->pushBufferFormat(format);
         return TRUE;
     } else {
         return FALSE;
     }
 }
 
+static gboolean
+gst_qt_quick2_video_sink_propose_allocation(GstBaseSink *sink, GstQuery *query)
+{
+    return proposeVideoBufferPool(GST_ELEMENT(sink), query);
+}
+
 static GstFlowReturn
 gst_qt_quick2_video_sink_show_frame(GstVideoSink *sink, GstBuffer *buffer)
 {
@@ -250,7 +259,7 @@ gst_qt_quick2_video_sink_show_frame(GstVideoSink *sink, GstBuffer *buffer)
 
     GST_TRACE_OBJECT(self, "Posting new buffer (%" GST_PTR_FORMAT ") for rendering.", buffer);
 
-    QCoreApplication::postEvent(self->priv->delegate, new BaseDelegate::BufferEvent(buffer));
+    self->priv->delegate->pushBuffer(buffer);
 
     return GST_FLOW_OK;
 }
@@ -345,6 +354,7 @@ gst_qt_quick2_video_sink_class_init (GstQtQuick2VideoSinkClass *klass)
 
     GstBaseSinkClass *base_sink_class = GST_BASE_SINK_CLASS(klass);
     base_sink_class->set_caps = gst_qt_quick2_video_sink_set_caps;
+    base_sink_class->propose_allocation = gst_qt_quick2_video_sink_propose_allocation;
 
     GstVideoSinkClass *video_sink_class = GST_VIDEO_SINK_CLASS(klass);
     video_sink_class->show_frame = gst_qt_quick2_video_sink_show_frame;
@@ -390,6 +400,19 @@ gst_qt_quick2_video_sink_class_init (GstQtQuick2VideoSinkClass *klass)
         g_param_spec_int("saturation", "Saturation", "The saturation of the video",
                          -100, 100, 0, static_cast<GParamFlags>(G_PARAM_READWRITE)));
 
+    /**
+     * GstQtQuick2VideoSink::stats
+     *
+     * Rendering statistics: the number of frames received, rendered and
+     * dropped before being painted, the average and maximum upload and paint
+     * times and a histogram of the latency from show_frame() to the first
+     * paint of each frame. The times are in nanoseconds.
+     **/
+    g_object_class_install_property(gobject_class, PROP_STATS,
+        g_param_spec_boxed("stats", "Statistics",
+                           "Rendering statistics of the sink",
+                           GST_TYPE_STRUCTURE, static_cast<GParamFlags>(G_PARAM_READABLE)));
+
 
     /**
      * GstQtQuick2VideoSink::update-node
@@ -439,7 +462,10 @@ gst_qt_quick2_video_sink_class_init (GstQtQuick2VideoSinkClass *klass)
 
     static GstStaticPadTemplate sink_pad_template =
         GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
-            GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (CAPS_FORMATS))
+            GST_STATIC_CAPS (
+                GST_VIDEO_CAPS_MAKE_WITH_FEATURES (
+                    GST_CAPS_FEATURE_META_GST_VIDEO_OVERLAY_COMPOSITION, CAPS_FORMATS) "; "
+                GST_VIDEO_CAPS_MAKE (CAPS_FORMATS))
         );
 
     gst_element_class_add_pad_template(
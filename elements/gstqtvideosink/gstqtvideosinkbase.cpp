@@ -18,13 +18,13 @@
 #include "gstqtvideosinkbase.h"
 #include "delegates/qtvideosinkdelegate.h"
 #include "painters/genericsurfacepainter.h"
+#include "utils/bufferpool.h"
 #include <cstring>
-#include <QCoreApplication>
 
 #if Q_BYTE_ORDER == Q_BIG_ENDIAN
-# define CAPS_FORMATS "{ ARGB, xRGB, RGB, RGB16 }"
+# define CAPS_FORMATS "{ ARGB, xRGB, RGB, RGB16, I420, YV12, NV12, NV21, YUY2, UYVY }"
 #else
-# define CAPS_FORMATS "{ BGRA, BGRx, RGB, RGB16 }"
+# define CAPS_FORMATS "{ BGRA, BGRx, RGB, RGB16, I420, YV12, NV12, NV21, YUY2, UYVY }"
 #endif
 
 GstVideoSinkClass *GstQtVideoSinkBase::s_parent_class = NULL;
@@ -39,7 +39,10 @@ void GstQtVideoSinkBase::base_init(gpointer g_class)
 
     static GstStaticPadTemplate sink_pad_template =
         GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
-            GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (CAPS_FORMATS))
+            GST_STATIC_CAPS (
+                GST_VIDEO_CAPS_MAKE_WITH_FEATURES (
+                    GST_CAPS_FEATURE_META_GST_VIDEO_OVERLAY_COMPOSITION, CAPS_FORMATS) "; "
+                GST_VIDEO_CAPS_MAKE (CAPS_FORMATS))
         );
 
     gst_element_class_add_pad_template(
@@ -62,6 +65,7 @@ void GstQtVideoSinkBase::class_init(gpointer g_class, gpointer class_data)
 
     GstBaseSinkClass *base_sink_class = GST_BASE_SINK_CLASS(g_class);
     base_sink_class->set_caps = GstQtVideoSinkBase::set_caps;
+    base_sink_class->propose_allocation = GstQtVideoSinkBase::propose_allocation;
 
     GstVideoSinkClass *video_sink_class = GST_VIDEO_SINK_CLASS(g_class);
     video_sink_class->show_frame = GstQtVideoSinkBase::show_frame;
@@ -88,6 +92,18 @@ void GstQtVideoSinkBase::class_init(gpointer g_class, gpointer class_data)
                              "When enabled, scaling will respect original aspect ratio",
                              FALSE, static_cast<GParamFlags>(G_PARAM_READWRITE)));
 
+    /**
+     * GstQtVideoSinkBase::stats
+     *
+     * Rendering statistics: the number of frames received, rendered and
+     * dropped before being painted, the average and maximum upload and paint
+     * times and a histogram of the latency from show_frame() to the first
+     * paint of each frame. The times are in nanoseconds.
+     **/
+    g_object_class_install_property(object_class, PROP_STATS,
+        g_param_spec_boxed("stats", "Statistics",
+                           "Rendering statistics of the sink",
+                           GST_TYPE_STRUCTURE, static_cast<GParamFlags>(G_PARAM_READABLE)));
 }
 
 void GstQtVideoSinkBase::init(GTypeInstance *instance, gpointer g_class)
@@ -158,6 +174,9 @@ void GstQtVideoSinkBase::get_property(GObject *object, guint prop_id,
     case PROP_FORCE_ASPECT_RATIO:
         g_value_set_boolean(value, sink->delegate->forceAspectRatio());
         break;
+    case PROP_STATS:
+        g_value_take_boxed(value, sink->delegate->stats());
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -193,14 +212,18 @@ gboolean GstQtVideoSinkBase::set_caps(GstBaseSink *base, GstCaps *caps)
     GST_LOG_OBJECT(sink, "new caps %" GST_PTR_FORMAT, caps);
     BufferFormat format = BufferFormat::fromCaps(caps);
     if (GenericSurfacePainter::supportedPixelFormats().contains(format.videoFormat())) {
-        QCoreApplication::postEvent(sink->delegate,
-                                    new BaseDelegate::BufferFormatEvent(format));
+        sink->delegate->pushBufferFormat(format);
         return TRUE;
     } else {
         return FALSE;
     }
 }
 
+gboolean GstQtVideoSinkBase::propose_allocation(GstBaseSink *base, GstQuery *query)
+{
+    return proposeVideoBufferPool(GST_ELEMENT(base), query);
+}
+
 //------------------------------
 
 GstFlowReturn GstQtVideoSinkBase::show_frame(GstVideoSink *video_sink, GstBuffer *buffer)
@@ -209,7 +232,7 @@ GstFlowReturn GstQtVideoSinkBase::show_frame(GstVideoSink *video_sink, GstBuffer
 
     GST_TRACE_OBJECT(sink, "Posting new buffer (%" GST_PTR_FORMAT ") for rendering.", buffer);
 
-    QCoreApplication::postEvent(sink->delegate, new BaseDelegate::BufferEvent(buffer));
+    sink->delegate->pushBuffer(buffer);
 
     return GST_FLOW_OK;
 }
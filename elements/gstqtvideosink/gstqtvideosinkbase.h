@@ -44,6 +44,7 @@ private:
         PROP_0,
         PROP_PIXEL_ASPECT_RATIO,
         PROP_FORCE_ASPECT_RATIO,
+        PROP_STATS,
     };
 
     static void base_init(gpointer g_class);
@@ -59,6 +60,7 @@ private:
     static GstStateChangeReturn change_state(GstElement *element, GstStateChange transition);
 
     static gboolean set_caps(GstBaseSink *sink, GstCaps *caps);
+    static gboolean propose_allocation(GstBaseSink *sink, GstQuery *query);
 
     static GstFlowReturn show_frame(GstVideoSink *sink, GstBuffer *buffer);
 
@@ -33,10 +33,16 @@ public:
     virtual void init(const BufferFormat & format) = 0;
     virtual void cleanup() = 0;
 
-    virtual void paint(quint8 *data, const BufferFormat & frameFormat,
+    // paints the frameFormat.cropRect() area of a frame mapped with
+    // frameFormat.mapFrame(), whose strides may differ from the caps
+    virtual void paint(const GstVideoFrame *frame, const BufferFormat & frameFormat,
                        QPainter *painter, const PaintAreas & areas) = 0;
 
     virtual void updateColors(int brightness, int contrast, int hue, int saturation) = 0;
+
+    // time spent in the last paint() getting the frame ready to be drawn,
+    // in microseconds; painters that draw straight from the buffer return 0
+    virtual qint64 lastUploadTime() const { return 0; }
 };
 
 #endif
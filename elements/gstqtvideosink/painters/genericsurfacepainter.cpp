@@ -19,11 +19,13 @@
 
 GenericSurfacePainter::GenericSurfacePainter()
     : m_imageFormat(QImage::Format_Invalid)
+    , m_convert(false)
+    , m_lastConversionTime(0)
 {
 }
 
 //static
-QSet<GstVideoFormat> GenericSurfacePainter::supportedPixelFormats()
+QSet<GstVideoFormat> GenericSurfacePainter::rgbPixelFormats()
 {
     return QSet<GstVideoFormat>()
 #if Q_BYTE_ORDER == Q_BIG_ENDIAN
@@ -38,8 +40,16 @@ QSet<GstVideoFormat> GenericSurfacePainter::supportedPixelFormats()
         ;
 }
 
+//static
+QSet<GstVideoFormat> GenericSurfacePainter::supportedPixelFormats()
+{
+    return rgbPixelFormats() + YuvConverter::supportedPixelFormats();
+}
+
 void GenericSurfacePainter::init(const BufferFormat &format)
 {
+    m_convert = false;
+
     switch (format.videoFormat()) {
     // QImage is shitty and reads integers instead of bytes,
     // thus it is affected by the host's endianness
@@ -67,28 +77,53 @@ void GenericSurfacePainter::init(const BufferFormat &format)
         m_imageFormat = QImage::Format_RGB888;
         break;
     default:
-        throw QString("Unsupported format");
+        // throws if this is not a YUV format either
+        m_converter.init(format);
+        m_imageFormat = QImage::Format_RGB32;
+        m_convert = true;
+        break;
     }
 }
 
 void GenericSurfacePainter::cleanup()
 {
     m_imageFormat = QImage::Format_Invalid;
+    m_convert = false;
+    m_convertedImage = QImage();
+    m_lastConversionTime = 0;
+    m_overlays.clear();
 }
 
-void GenericSurfacePainter::paint(quint8 *data,
+void GenericSurfacePainter::paint(const GstVideoFrame *frame,
         const BufferFormat & frameFormat,
         QPainter *painter,
         const PaintAreas & areas)
 {
     Q_ASSERT(m_imageFormat != QImage::Format_Invalid);
 
-    QImage image(
-        data,
-        frameFormat.frameSize().width(),
-        frameFormat.frameSize().height(),
-        frameFormat.bytesPerLine(),
-        m_imageFormat);
+    const QRect cropRect = frameFormat.cropRect(frame);
+
+    QImage frameImage;
+    if (m_convert) {
+        // converted frames go to the same image every time, so it is only
+        // allocated once; referencing rather than copying it keeps it unshared
+        const qint64 conversionStartTime = g_get_monotonic_time();
+        m_converter.convert(frame, cropRect.topLeft(), m_convertedImage);
+        m_lastConversionTime = g_get_monotonic_time() - conversionStartTime;
+    } else {
+        // RGB frames are painted in place, with the stride of the buffer
+        const int stride = GST_VIDEO_FRAME_PLANE_STRIDE(frame, 0);
+        const quint8 *data = static_cast<const quint8 *>(GST_VIDEO_FRAME_PLANE_DATA(frame, 0))
+                + cropRect.y() * stride
+                + cropRect.x() * GST_VIDEO_FRAME_COMP_PSTRIDE(frame, 0);
+        frameImage = QImage(
+            data,
+            cropRect.width(),
+            cropRect.height(),
+            stride,
+            m_imageFormat);
+    }
+    const QImage & image = m_convert ? m_convertedImage : frameImage;
 
     QRectF sourceRect = areas.sourceRect;
     sourceRect.setX(sourceRect.x() * frameFormat.frameSize().width());
@@ -99,6 +134,18 @@ void GenericSurfacePainter::paint(quint8 *data,
     painter->fillRect(areas.blackArea1, Qt::black);
     painter->drawImage(areas.videoArea, image, sourceRect);
     painter->fillRect(areas.blackArea2, Qt::black);
+
+    m_overlays.update(frame->buffer);
+    Q_FOREACH(const OverlayComposition::Rectangle & rectangle, m_overlays.rectangles()) {
+        QRectF target, source;
+        if (OverlayComposition::mapRectangle(rectangle.renderRect,
+                    frameFormat.frameSize(), areas, &target, &source)) {
+            const QSize imageSize = rectangle.image.size();
+            painter->drawImage(target, rectangle.image,
+                    QRectF(source.x() * imageSize.width(), source.y() * imageSize.height(),
+                           source.width() * imageSize.width(), source.height() * imageSize.height()));
+        }
+    }
 }
 
 void GenericSurfacePainter::updateColors(int, int, int, int)
@@ -18,12 +18,16 @@
 #define GENERICSURFACEPAINTER_H
 
 #include "abstractsurfacepainter.h"
+#include "../utils/yuvconverter.h"
+#include "../utils/overlaycomposition.h"
 #include <QSet>
 #include <QImage>
 
 /**
  * Generic painter that paints using the QPainter API.
- * No colorspace conversion is done and no colors adjustment either.
+ * YUV frames are converted to RGB on the CPU by YuvConverter,
+ * RGB frames are painted as they are. No colors adjustment is done.
+ * Overlay compositions attached to the frames are drawn on top of them.
  */
 class GenericSurfacePainter : public AbstractSurfacePainter
 {
@@ -39,13 +43,23 @@ public:
     virtual void init(const BufferFormat &format);
     virtual void cleanup();
 
-    virtual void paint(quint8 *data, const BufferFormat & frameFormat,
+    virtual void paint(const GstVideoFrame *frame, const BufferFormat & frameFormat,
                        QPainter *painter, const PaintAreas & areas);
 
     virtual void updateColors(int brightness, int contrast, int hue, int saturation);
 
+    // the time spent converting the last YUV frame to RGB
+    virtual qint64 lastUploadTime() const { return m_lastConversionTime; }
+
 private:
+    static QSet<GstVideoFormat> rgbPixelFormats();
+
     QImage::Format m_imageFormat;
+    bool m_convert;
+    YuvConverter m_converter;
+    QImage m_convertedImage;
+    qint64 m_lastConversionTime;
+    OverlayComposition m_overlays;
 };
 
 #endif // GENERICSURFACEPAINTER_H
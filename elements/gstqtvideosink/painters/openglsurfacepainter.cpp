@@ -16,6 +16,7 @@
 */
 #include "openglsurfacepainter.h"
 #include <QtCore/qmath.h>
+#include <cstring>
 
 #ifndef GL_TEXTURE0
 #  define GL_TEXTURE0    0x84C0
@@ -35,6 +36,31 @@
 #  define GL_CLAMP_TO_EDGE 0x812F
 #endif
 
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#  define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+
+#ifndef GL_STREAM_DRAW
+#  define GL_STREAM_DRAW 0x88E0
+#endif
+
+#ifndef GL_WRITE_ONLY
+#  define GL_WRITE_ONLY 0x88B9
+#endif
+
+#ifndef GL_UNPACK_ROW_LENGTH
+#  define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
+// the texture holds the bytes of native endian ARGB words
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+# define OVERLAY_SWIZZLE_GLSL "gbar"
+# define OVERLAY_SWIZZLE_ARBFP "yzwx"
+#else
+# define OVERLAY_SWIZZLE_GLSL "bgra"
+# define OVERLAY_SWIZZLE_ARBFP "zyxw"
+#endif
+
 #define QRECT_TO_GLMATRIX(rect) \
     { \
         GLfloat(rect.left())     , GLfloat(rect.bottom()), \
@@ -44,15 +70,25 @@
     }
 
 OpenGLSurfacePainter::OpenGLSurfacePainter()
-    : m_textureFormat(0)
-    , m_textureInternalFormat(0)
-    , m_textureType(0)
-    , m_textureCount(0)
+    : m_textureCount(0)
+    , m_pixelBufferObjectsEnabled(true)
+    , m_pixelBufferCount(0)
+    , m_pixelBufferIndex(0)
+    , m_lastUploadTime(0)
     , m_videoColorMatrix(GST_VIDEO_COLOR_MATRIX_UNKNOWN)
 {
 #ifndef QT_OPENGL_ES
-    glActiveTexture = (_glActiveTexture) QGLContext::currentContext()->getProcAddress(
+    const QGLContext *context = QGLContext::currentContext();
+
+    glActiveTexture = (_glActiveTexture) context->getProcAddress(
             QLatin1String("glActiveTexture"));
+
+    glGenBuffers = (_glGenBuffers) context->getProcAddress(QLatin1String("glGenBuffers"));
+    glDeleteBuffers = (_glDeleteBuffers) context->getProcAddress(QLatin1String("glDeleteBuffers"));
+    glBindBuffer = (_glBindBuffer) context->getProcAddress(QLatin1String("glBindBuffer"));
+    glBufferData = (_glBufferData) context->getProcAddress(QLatin1String("glBufferData"));
+    glMapBuffer = (_glMapBuffer) context->getProcAddress(QLatin1String("glMapBuffer"));
+    glUnmapBuffer = (_glUnmapBuffer) context->getProcAddress(QLatin1String("glUnmapBuffer"));
 #endif
 }
 
@@ -78,6 +114,10 @@ QSet<GstVideoFormat> OpenGLSurfacePainter::supportedPixelFormats()
         << GST_VIDEO_FORMAT_AYUV
         << GST_VIDEO_FORMAT_YV12
         << GST_VIDEO_FORMAT_I420
+        << GST_VIDEO_FORMAT_NV12
+        << GST_VIDEO_FORMAT_NV21
+        << GST_VIDEO_FORMAT_YUY2
+        << GST_VIDEO_FORMAT_UYVY
         ;
 }
 
@@ -158,12 +198,35 @@ void OpenGLSurfacePainter::updateColors(int brightness, int contrast, int hue, i
                     1.164,  2.017,  0.000, -1.081,
                     0.0,    0.000,  0.000,  1.0000);
         break;
+    case GST_VIDEO_COLOR_MATRIX_FCC:
+        m_colorMatrix *= QMatrix4x4(
+                    1.164,  0.000,  1.594, -0.8699,
+                    1.164, -0.378, -0.810,  0.5210,
+                    1.164,  2.026,  0.000, -1.0862,
+                    0.0,    0.000,  0.000,  1.0000);
+        break;
+    case GST_VIDEO_COLOR_MATRIX_SMPTE240M:
+        m_colorMatrix *= QMatrix4x4(
+                    1.164,  0.000,  1.794, -0.9701,
+                    1.164, -0.258, -0.543,  0.3272,
+                    1.164,  2.079,  0.000, -1.1124,
+                    0.0,    0.000,  0.000,  1.0000);
+        break;
+#if GST_CHECK_VERSION(1, 6, 0)
+    case GST_VIDEO_COLOR_MATRIX_BT2020:
+        m_colorMatrix *= QMatrix4x4(
+                    1.164,  0.000,  1.679, -0.9124,
+                    1.164, -0.187, -0.650,  0.3458,
+                    1.164,  2.142,  0.000, -1.1439,
+                    0.0,    0.000,  0.000,  1.0000);
+        break;
+#endif
     default:
         break;
     }
 }
 
-void OpenGLSurfacePainter::paint(quint8 *data,
+void OpenGLSurfacePainter::paint(const GstVideoFrame *frame,
         const BufferFormat & frameFormat,
         QPainter *painter,
         const PaintAreas & areas)
@@ -195,33 +258,260 @@ void OpenGLSurfacePainter::paint(quint8 *data,
         txRight, txTop
     };
 
+    const qint64 uploadStartTime = g_get_monotonic_time();
+
+    // texture i holds component i of the frame, starting at the crop origin
+    const QRect cropRect = frameFormat.cropRect(frame);
+    const GstVideoFormatInfo *finfo = frame->info.finfo;
+    const quint8 *textureData[3];
+    int textureStrides[3];
+    int textureTexelSizes[3];
+    int textureDataSizes[3];
+    int uploadSize = 0;
+
+    for (int i = 0; i < m_textureCount; ++i) {
+        const int plane = GST_VIDEO_FORMAT_INFO_PLANE(finfo, i);
+        textureStrides[i] = GST_VIDEO_FRAME_PLANE_STRIDE(frame, plane);
+        textureTexelSizes[i] = GST_VIDEO_FORMAT_INFO_PSTRIDE(finfo, i);
+        textureData[i] = static_cast<const quint8 *>(GST_VIDEO_FRAME_PLANE_DATA(frame, plane))
+                + (cropRect.y() >> GST_VIDEO_FORMAT_INFO_H_SUB(finfo, i)) * textureStrides[i]
+                + (cropRect.x() >> GST_VIDEO_FORMAT_INFO_W_SUB(finfo, i)) * textureTexelSizes[i];
+        textureDataSizes[i] = (m_textureHeights[i] - 1) * textureStrides[i]
+                + m_textureWidths[i] * textureTexelSizes[i];
+        uploadSize += GST_ROUND_UP_16(textureDataSizes[i]);
+    }
+
+    bool fromPixelBuffer = false;
+
+#ifndef QT_OPENGL_ES
+    if (m_pixelBufferCount) {
+        // Alternate between the buffers, so that filling this one does not
+        // have to wait for the transfer of the previous frame to complete.
+        // Re-specifying the storage lets the driver orphan the old one too.
+        m_pixelBufferIndex = (m_pixelBufferIndex + 1) % m_pixelBufferCount;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBufferIds[m_pixelBufferIndex]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, uploadSize, NULL, GL_STREAM_DRAW);
+
+        quint8 *mapped = static_cast<quint8 *>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+        if (mapped) {
+            // copy the visible rows of each texture, keeping their stride;
+            // the texture data pointers become offsets into the bound buffer
+            int offset = 0;
+            for (int i = 0; i < m_textureCount; ++i) {
+                memcpy(mapped + offset, textureData[i], textureDataSizes[i]);
+                textureData[i] = static_cast<const quint8 *>(0) + offset;
+                offset += GST_ROUND_UP_16(textureDataSizes[i]);
+            }
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            fromPixelBuffer = true;
+        } else {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+    }
+#endif
+
+    // the storage is allocated in initTextures(), only update its contents here
+    for (int i = 0; i < m_textureCount; ++i) {
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
+        uploadTexture(i, textureData[i], textureStrides[i], textureTexelSizes[i]);
+    }
+
+#ifndef QT_OPENGL_ES
+    if (fromPixelBuffer) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+#endif
+
+    m_lastUploadTime = g_get_monotonic_time() - uploadStartTime;
+
+    paintImpl(painter, vertexCoordArray, textureCoordArray);
+
+    if (m_overlays.update(frame->buffer)) {
+        updateOverlayTextures();
+    }
+    paintOverlays(painter, frameFormat.frameSize(), areas);
+
+    painter->endNativePainting();
+    painter->fillRect(areas.blackArea1, Qt::black);
+    painter->fillRect(areas.blackArea2, Qt::black);
+}
+
+void OpenGLSurfacePainter::updateOverlayTextures()
+{
+    // the textures are only uploaded when a rectangle first shows up;
+    // the ones that stay on screen keep their seqnum, and thus their texture
+    QHash<guint, GLuint> textures;
+    Q_FOREACH(const OverlayComposition::Rectangle & rectangle, m_overlays.rectangles()) {
+        GLuint textureId = m_overlayTextures.take(rectangle.seqnum);
+        if (!textureId) {
+            glGenTextures(1, &textureId);
+            glBindTexture(GL_TEXTURE_2D, textureId);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+                         rectangle.image.width(), rectangle.image.height(),
+                         0, GL_RGBA, GL_UNSIGNED_BYTE, rectangle.image.constBits());
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        textures.insert(rectangle.seqnum, textureId);
+    }
+
+    Q_FOREACH(GLuint textureId, m_overlayTextures) {
+        glDeleteTextures(1, &textureId);
+    }
+    m_overlayTextures = textures;
+}
+
+void OpenGLSurfacePainter::paintOverlays(const QPainter *painter,
+        const QSize & frameSize, const PaintAreas & areas)
+{
+    if (m_overlays.isEmpty()) {
+        return;
+    }
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glActiveTexture(GL_TEXTURE0);
+
+    Q_FOREACH(const OverlayComposition::Rectangle & rectangle, m_overlays.rectangles()) {
+        QRectF target, source;
+        if (!OverlayComposition::mapRectangle(rectangle.renderRect, frameSize,
+                                              areas, &target, &source)) {
+            continue;
+        }
+
+        const GLfloat vertexCoordArray[] = QRECT_TO_GLMATRIX(target);
+        const GLfloat textureCoordArray[] =
+        {
+            GLfloat(source.left()) , GLfloat(source.bottom()),
+            GLfloat(source.right()), GLfloat(source.bottom()),
+            GLfloat(source.left()) , GLfloat(source.top()),
+            GLfloat(source.right()), GLfloat(source.top())
+        };
+
+        glBindTexture(GL_TEXTURE_2D, m_overlayTextures.value(rectangle.seqnum));
+        paintOverlayImpl(painter, vertexCoordArray, textureCoordArray);
+    }
+
+    glDisable(GL_BLEND);
+}
+
+void OpenGLSurfacePainter::uploadTexture(int i, const quint8 *data, int stride, int texelSize)
+{
+    const int rowSize = m_textureWidths[i] * texelSize;
+
+    // the rows are padded to the unpack alignment, so if one of them
+    // gives the stride of the frame, the texture can be uploaded at once
+    for (int alignment = 8; alignment >= 1; alignment /= 2) {
+        if (((rowSize + alignment - 1) & ~(alignment - 1)) == stride) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_textureWidths[i], m_textureHeights[i],
+                            m_textureFormats[i], m_textureTypes[i], data);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            return;
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+#ifndef QT_OPENGL_ES
+    // otherwise, desktop GL can be told the stride, if it is a whole number of texels
+    if (stride % texelSize == 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / texelSize);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_textureWidths[i], m_textureHeights[i],
+                        m_textureFormats[i], m_textureTypes[i], data);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        return;
+    }
+#endif
+
+    // and the odd strides that are left are uploaded row by row
+    for (int y = 0; y < m_textureHeights[i]; ++y) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, m_textureWidths[i], 1,
+                        m_textureFormats[i], m_textureTypes[i], data + y * stride);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void OpenGLSurfacePainter::initTextures(const BufferFormat & format)
+{
+    // texture i holds component i, so it is as big as that component,
+    // rather than as the whole stride, which may include padding
+    GstVideoInfo videoInfo = format.videoInfo();
+    const GstVideoFormatInfo *finfo = videoInfo.finfo;
+    for (int i = 0; i < m_textureCount; ++i) {
+        m_textureWidths[i] = GST_VIDEO_FORMAT_INFO_SCALE_WIDTH(finfo, i,
+                GST_VIDEO_INFO_WIDTH(&videoInfo));
+        m_textureHeights[i] = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT(finfo, i,
+                GST_VIDEO_INFO_HEIGHT(&videoInfo));
+    }
+
+    glGenTextures(m_textureCount, m_textureIds);
+
     for (int i = 0; i < m_textureCount; ++i) {
         glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
         glTexImage2D(
                 GL_TEXTURE_2D,
                 0,
-                m_textureInternalFormat,
+                m_textureInternalFormats[i],
                 m_textureWidths[i],
                 m_textureHeights[i],
                 0,
-                m_textureFormat,
-                m_textureType,
-                data + m_textureOffsets[i]);
+                m_textureFormats[i],
+                m_textureTypes[i],
+                NULL);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
 
-    paintImpl(painter, vertexCoordArray, textureCoordArray);
+    m_pixelBufferCount = 0;
+    m_pixelBufferIndex = 0;
 
-    painter->endNativePainting();
-    painter->fillRect(areas.blackArea1, Qt::black);
-    painter->fillRect(areas.blackArea2, Qt::black);
+#ifndef QT_OPENGL_ES
+    if (!m_pixelBufferObjectsEnabled
+            || !glGenBuffers || !glDeleteBuffers || !glBindBuffer
+            || !glBufferData || !glMapBuffer || !glUnmapBuffer) {
+        return;
+    }
+
+    const QByteArray extensions(reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS)));
+    if (!extensions.contains("ARB_pixel_buffer_object")
+            && !extensions.contains("EXT_pixel_buffer_object")) {
+        return;
+    }
+
+    // their storage is (re)specified for every frame, as the frames
+    // may be laid out differently from one buffer to the next
+    m_pixelBufferCount = 2;
+    glGenBuffers(m_pixelBufferCount, m_pixelBufferIds);
+#endif
+}
+
+void OpenGLSurfacePainter::cleanupTextures()
+{
+    glDeleteTextures(m_textureCount, m_textureIds);
+
+    Q_FOREACH(GLuint textureId, m_overlayTextures) {
+        glDeleteTextures(1, &textureId);
+    }
+    m_overlayTextures.clear();
+    m_overlays.clear();
+
+#ifndef QT_OPENGL_ES
+    if (m_pixelBufferCount) {
+        glDeleteBuffers(m_pixelBufferCount, m_pixelBufferIds);
+    }
+#endif
+
+    m_pixelBufferCount = 0;
 }
 
 void OpenGLSurfacePainter::initRgbTextureInfo(
-        GLenum internalFormat, GLuint format, GLenum type, const QSize &size)
+        GLenum internalFormat, GLuint format, GLenum type)
 {
 #ifndef QT_OPENGL_ES
     //make sure we get 8 bits per component, at least on the desktop GL where we can
@@ -237,53 +527,48 @@ void OpenGLSurfacePainter::initRgbTextureInfo(
     }
 #endif
 
-    m_textureInternalFormat = internalFormat;
-    m_textureFormat = format;
-    m_textureType = type;
+    m_textureInternalFormats[0] = internalFormat;
+    m_textureFormats[0] = format;
+    m_textureTypes[0] = type;
     m_textureCount = 1;
-    m_textureWidths[0] = size.width();
-    m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
 }
 
-void OpenGLSurfacePainter::initYuv420PTextureInfo(const QSize &size)
+void OpenGLSurfacePainter::initYuv420PTextureInfo()
 {
-    int bytesPerLine = (size.width() + 3) & ~3;
-    int bytesPerLine2 = (size.width() / 2 + 3) & ~3;
-
-    m_textureInternalFormat = GL_LUMINANCE;
-    m_textureFormat = GL_LUMINANCE;
-    m_textureType = GL_UNSIGNED_BYTE;
+    // one texture per plane, in Y, U, V order whatever the order of the planes
     m_textureCount = 3;
-    m_textureWidths[0] = bytesPerLine;
-    m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
-    m_textureWidths[1] = bytesPerLine2;
-    m_textureHeights[1] = size.height() / 2;
-    m_textureOffsets[1] = bytesPerLine * size.height();
-    m_textureWidths[2] = bytesPerLine2;
-    m_textureHeights[2] = size.height() / 2;
-    m_textureOffsets[2] = bytesPerLine * size.height() + bytesPerLine2 * size.height()/2;
+    for (int i = 0; i < m_textureCount; ++i) {
+        m_textureInternalFormats[i] = GL_LUMINANCE;
+        m_textureFormats[i] = GL_LUMINANCE;
+        m_textureTypes[i] = GL_UNSIGNED_BYTE;
+    }
 }
 
-void OpenGLSurfacePainter::initYv12TextureInfo(const QSize &size)
+void OpenGLSurfacePainter::initSemiPlanarTextureInfo()
 {
-    int bytesPerLine = (size.width() + 3) & ~3;
-    int bytesPerLine2 = (size.width() / 2 + 3) & ~3;
+    // the interleaved chroma plane is sampled as a half-sized luminance-alpha
+    // texture, with U in the luminance and V in the alpha channel (or vice versa)
+    m_textureCount = 2;
+    m_textureInternalFormats[0] = GL_LUMINANCE;
+    m_textureFormats[0] = GL_LUMINANCE;
+    m_textureTypes[0] = GL_UNSIGNED_BYTE;
+    m_textureInternalFormats[1] = GL_LUMINANCE_ALPHA;
+    m_textureFormats[1] = GL_LUMINANCE_ALPHA;
+    m_textureTypes[1] = GL_UNSIGNED_BYTE;
+}
 
-    m_textureInternalFormat = GL_LUMINANCE;
-    m_textureFormat = GL_LUMINANCE;
-    m_textureType = GL_UNSIGNED_BYTE;
-    m_textureCount = 3;
-    m_textureWidths[0] = bytesPerLine;
-    m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
-    m_textureWidths[1] = bytesPerLine2;
-    m_textureHeights[1] = size.height() / 2;
-    m_textureOffsets[1] = bytesPerLine * size.height() + bytesPerLine2 * size.height()/2;
-    m_textureWidths[2] = bytesPerLine2;
-    m_textureHeights[2] = size.height() / 2;
-    m_textureOffsets[2] = bytesPerLine * size.height();
+void OpenGLSurfacePainter::initPacked422TextureInfo()
+{
+    // both textures are views of the same data: a full-width luminance-alpha
+    // one to get the luma of every pixel and a half-width RGBA one where each
+    // texel holds a complete macropixel, to get the shared chroma
+    m_textureCount = 2;
+    m_textureInternalFormats[0] = GL_LUMINANCE_ALPHA;
+    m_textureFormats[0] = GL_LUMINANCE_ALPHA;
+    m_textureTypes[0] = GL_UNSIGNED_BYTE;
+    m_textureInternalFormats[1] = GL_RGBA;
+    m_textureFormats[1] = GL_RGBA;
+    m_textureTypes[1] = GL_UNSIGNED_BYTE;
 }
 
 #ifndef QT_OPENGL_ES
@@ -375,11 +660,91 @@ static const char *qt_arbfp_yuvPlanarShaderProgram =
     "DP4 result.color.z, yuv, matrix[2];\n"
     "END";
 
+// Paints a NV12 frame.
+static const char *qt_arbfp_nv12ShaderProgram =
+    "!!ARBfp1.0\n"
+    "PARAM matrix[4] = { program.local[0..2],"
+    "{ 0.0, 0.0, 0.0, 1.0 } };\n"
+    "TEMP yuv;\n"
+    "TEMP luma;\n"
+    "TEMP chroma;\n"
+    "TEX luma, fragment.texcoord[0], texture[0], 2D;\n"
+    "TEX chroma, fragment.texcoord[0], texture[1], 2D;\n"
+    "MOV yuv.x, luma.x;\n"
+    "MOV yuv.yz, chroma.xxww;\n"
+    "MOV yuv.w, matrix[3].w;\n"
+    "DP4 result.color.x, yuv, matrix[0];\n"
+    "DP4 result.color.y, yuv, matrix[1];\n"
+    "DP4 result.color.z, yuv, matrix[2];\n"
+    "END";
+
+// Paints a NV21 frame.
+static const char *qt_arbfp_nv21ShaderProgram =
+    "!!ARBfp1.0\n"
+    "PARAM matrix[4] = { program.local[0..2],"
+    "{ 0.0, 0.0, 0.0, 1.0 } };\n"
+    "TEMP yuv;\n"
+    "TEMP luma;\n"
+    "TEMP chroma;\n"
+    "TEX luma, fragment.texcoord[0], texture[0], 2D;\n"
+    "TEX chroma, fragment.texcoord[0], texture[1], 2D;\n"
+    "MOV yuv.x, luma.x;\n"
+    "MOV yuv.yz, chroma.xwxx;\n"
+    "MOV yuv.w, matrix[3].w;\n"
+    "DP4 result.color.x, yuv, matrix[0];\n"
+    "DP4 result.color.y, yuv, matrix[1];\n"
+    "DP4 result.color.z, yuv, matrix[2];\n"
+    "END";
+
+// Paints a YUY2 frame.
+static const char *qt_arbfp_yuy2ShaderProgram =
+    "!!ARBfp1.0\n"
+    "PARAM matrix[4] = { program.local[0..2],"
+    "{ 0.0, 0.0, 0.0, 1.0 } };\n"
+    "TEMP yuv;\n"
+    "TEMP luma;\n"
+    "TEMP chroma;\n"
+    "TEX luma, fragment.texcoord[0], texture[0], 2D;\n"
+    "TEX chroma, fragment.texcoord[0], texture[1], 2D;\n"
+    "MOV yuv.x, luma.x;\n"
+    "MOV yuv.yz, chroma.xyww;\n"
+    "MOV yuv.w, matrix[3].w;\n"
+    "DP4 result.color.x, yuv, matrix[0];\n"
+    "DP4 result.color.y, yuv, matrix[1];\n"
+    "DP4 result.color.z, yuv, matrix[2];\n"
+    "END";
+
+// Paints a UYVY frame.
+static const char *qt_arbfp_uyvyShaderProgram =
+    "!!ARBfp1.0\n"
+    "PARAM matrix[4] = { program.local[0..2],"
+    "{ 0.0, 0.0, 0.0, 1.0 } };\n"
+    "TEMP yuv;\n"
+    "TEMP luma;\n"
+    "TEMP chroma;\n"
+    "TEX luma, fragment.texcoord[0], texture[0], 2D;\n"
+    "TEX chroma, fragment.texcoord[0], texture[1], 2D;\n"
+    "MOV yuv.x, luma.w;\n"
+    "MOV yuv.yz, chroma.xxzz;\n"
+    "MOV yuv.w, matrix[3].w;\n"
+    "DP4 result.color.x, yuv, matrix[0];\n"
+    "DP4 result.color.y, yuv, matrix[1];\n"
+    "DP4 result.color.z, yuv, matrix[2];\n"
+    "END";
+
 
+// Paints a premultiplied overlay rectangle.
+static const char *qt_arbfp_overlayShaderProgram =
+    "!!ARBfp1.0\n"
+    "TEMP argb;\n"
+    "TEX argb, fragment.texcoord[0], texture[0], 2D;\n"
+    "MOV result.color, argb." OVERLAY_SWIZZLE_ARBFP ";\n"
+    "END";
 
 ArbFpSurfacePainter::ArbFpSurfacePainter()
     : OpenGLSurfacePainter()
     , m_programId(0)
+    , m_overlayProgramId(0)
 {
     const QGLContext *context = QGLContext::currentContext();
 
@@ -403,51 +768,67 @@ void ArbFpSurfacePainter::init(const BufferFormat &format)
 
     switch (format.videoFormat()) {
     case GST_VIDEO_FORMAT_BGRx:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         program = qt_arbfp_bgrxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_xRGB:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         program = qt_arbfp_xrgbShaderProgram;
         break;
     case GST_VIDEO_FORMAT_BGRA:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         program = qt_arbfp_bgraShaderProgram;
         break;
     case GST_VIDEO_FORMAT_ARGB:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         program = qt_arbfp_argbShaderProgram;
         break;
     case GST_VIDEO_FORMAT_RGB:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         program = qt_arbfp_rgbxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_BGR:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         program = qt_arbfp_bgrxShaderProgram;
         break;
     //NOTE: unlike the other formats, this is endianness-dependent,
     //but using GL_UNSIGNED_SHORT_5_6_5 ensures that it's handled correctly
     case GST_VIDEO_FORMAT_RGB16:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_SHORT_5_6_5);
         program = qt_arbfp_rgbxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_v308:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         program = qt_arbfp_rgbxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_AYUV:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         program = qt_arbfp_argbShaderProgram;
         break;
     case GST_VIDEO_FORMAT_YV12:
-        initYv12TextureInfo(format.frameSize());
+        initYuv420PTextureInfo();
         program = qt_arbfp_yuvPlanarShaderProgram;
         break;
     case GST_VIDEO_FORMAT_I420:
-        initYuv420PTextureInfo(format.frameSize());
+        initYuv420PTextureInfo();
         program = qt_arbfp_yuvPlanarShaderProgram;
         break;
+    case GST_VIDEO_FORMAT_NV12:
+        initSemiPlanarTextureInfo();
+        program = qt_arbfp_nv12ShaderProgram;
+        break;
+    case GST_VIDEO_FORMAT_NV21:
+        initSemiPlanarTextureInfo();
+        program = qt_arbfp_nv21ShaderProgram;
+        break;
+    case GST_VIDEO_FORMAT_YUY2:
+        initPacked422TextureInfo();
+        program = qt_arbfp_yuy2ShaderProgram;
+        break;
+    case GST_VIDEO_FORMAT_UYVY:
+        initPacked422TextureInfo();
+        program = qt_arbfp_uyvyShaderProgram;
+        break;
     default:
         Q_ASSERT(false);
         break;
@@ -455,43 +836,60 @@ void ArbFpSurfacePainter::init(const BufferFormat &format)
 
     m_videoColorMatrix = format.colorMatrix();
 
-    glGenProgramsARB(1, &m_programId);
+    try {
+        loadProgram(&m_programId, program);
+        loadProgram(&m_overlayProgramId, qt_arbfp_overlayShaderProgram);
+    } catch (const QString &) {
+        if (m_programId) {
+            glDeleteProgramsARB(1, &m_programId);
+            m_programId = 0;
+        }
+        m_textureCount = 0;
+        throw;
+    }
+
+    initTextures(format);
+}
+
+void ArbFpSurfacePainter::loadProgram(GLuint *programId, const char *program)
+{
+    glGenProgramsARB(1, programId);
 
     GLenum glError = glGetError();
     if (glError != GL_NO_ERROR) {
+        *programId = 0;
         throw QString("ARBfb Shader allocation error ") +
             QString::number(static_cast<int>(glError), 16);
-    } else {
-        glBindProgramARB(GL_FRAGMENT_PROGRAM_ARB, m_programId);
-        glProgramStringARB(
-                GL_FRAGMENT_PROGRAM_ARB,
-                GL_PROGRAM_FORMAT_ASCII_ARB,
-                qstrlen(program),
-                reinterpret_cast<const GLvoid *>(program));
+    }
 
-        if ((glError = glGetError()) != GL_NO_ERROR) {
-            const GLubyte* errorString = glGetString(GL_PROGRAM_ERROR_STRING_ARB);
+    glBindProgramARB(GL_FRAGMENT_PROGRAM_ARB, *programId);
+    glProgramStringARB(
+            GL_FRAGMENT_PROGRAM_ARB,
+            GL_PROGRAM_FORMAT_ASCII_ARB,
+            qstrlen(program),
+            reinterpret_cast<const GLvoid *>(program));
 
-            glDeleteProgramsARB(1, &m_programId);
-            m_textureCount = 0;
-            m_programId = 0;
+    if ((glError = glGetError()) != GL_NO_ERROR) {
+        const GLubyte* errorString = glGetString(GL_PROGRAM_ERROR_STRING_ARB);
 
-            throw QString("ARBfp Shader compile error ") +
-                QString::number(static_cast<int>(glError), 16) +
-                reinterpret_cast<const char *>(errorString);
-        } else {
-            glGenTextures(m_textureCount, m_textureIds);
-        }
+        glDeleteProgramsARB(1, programId);
+        *programId = 0;
+
+        throw QString("ARBfp Shader compile error ") +
+            QString::number(static_cast<int>(glError), 16) +
+            reinterpret_cast<const char *>(errorString);
     }
 }
 
 void ArbFpSurfacePainter::cleanup()
 {
-    glDeleteTextures(m_textureCount, m_textureIds);
+    cleanupTextures();
     glDeleteProgramsARB(1, &m_programId);
+    glDeleteProgramsARB(1, &m_overlayProgramId);
 
     m_textureCount = 0;
     m_programId = 0;
+    m_overlayProgramId = 0;
 }
 
 void ArbFpSurfacePainter::paintImpl(const QPainter *painter,
@@ -525,15 +923,9 @@ void ArbFpSurfacePainter::paintImpl(const QPainter *painter,
             m_colorMatrix(2, 2),
             m_colorMatrix(2, 3));
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_textureIds[0]);
-
-    if (m_textureCount == 3) {
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[1]);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[2]);
-        glActiveTexture(GL_TEXTURE0);
+    for (int i = m_textureCount - 1; i >= 0; --i) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
     }
 
     glVertexPointer(2, GL_FLOAT, 0, vertexCoordArray);
@@ -549,6 +941,28 @@ void ArbFpSurfacePainter::paintImpl(const QPainter *painter,
     glDisable(GL_FRAGMENT_PROGRAM_ARB);
 }
 
+void ArbFpSurfacePainter::paintOverlayImpl(const QPainter *painter,
+        const GLfloat *vertexCoordArray,
+        const GLfloat *textureCoordArray)
+{
+    Q_UNUSED(painter);
+
+    glEnable(GL_FRAGMENT_PROGRAM_ARB);
+    glBindProgramARB(GL_FRAGMENT_PROGRAM_ARB, m_overlayProgramId);
+
+    glVertexPointer(2, GL_FLOAT, 0, vertexCoordArray);
+    glTexCoordPointer(2, GL_FLOAT, 0, textureCoordArray);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisable(GL_FRAGMENT_PROGRAM_ARB);
+}
+
 #endif
 
 static const char *qt_glsl_vertexShaderProgram =
@@ -637,6 +1051,107 @@ static const char *qt_glsl_yuvPlanarShaderProgram =
         "}\n";
 
 
+// Paints NV12 frames.
+static const char *qt_glsl_nv12ShaderProgram =
+        "uniform sampler2D texY;\n"
+        "uniform sampler2D texUV;\n"
+        "uniform mediump mat4 colorMatrix;\n"
+        "varying highp vec2 textureCoord;\n"
+        "void main(void)\n"
+        "{\n"
+        "    highp vec4 color = vec4(\n"
+        "           texture2D(texY, textureCoord.st).r,\n"
+        "           texture2D(texUV, textureCoord.st).ra,\n"
+        "           1.0);\n"
+        "    gl_FragColor = colorMatrix * color;\n"
+        "}\n";
+
+// Paints NV21 frames.
+static const char *qt_glsl_nv21ShaderProgram =
+        "uniform sampler2D texY;\n"
+        "uniform sampler2D texUV;\n"
+        "uniform mediump mat4 colorMatrix;\n"
+        "varying highp vec2 textureCoord;\n"
+        "void main(void)\n"
+        "{\n"
+        "    highp vec4 color = vec4(\n"
+        "           texture2D(texY, textureCoord.st).r,\n"
+        "           texture2D(texUV, textureCoord.st).ar,\n"
+        "           1.0);\n"
+        "    gl_FragColor = colorMatrix * color;\n"
+        "}\n";
+
+// Paints YUY2 frames.
+static const char *qt_glsl_yuy2ShaderProgram =
+        "uniform sampler2D texY;\n"
+        "uniform sampler2D texUV;\n"
+        "uniform mediump mat4 colorMatrix;\n"
+        "varying highp vec2 textureCoord;\n"
+        "void main(void)\n"
+        "{\n"
+        "    highp vec4 color = vec4(\n"
+        "           texture2D(texY, textureCoord.st).r,\n"
+        "           texture2D(texUV, textureCoord.st).ga,\n"
+        "           1.0);\n"
+        "    gl_FragColor = colorMatrix * color;\n"
+        "}\n";
+
+// Paints UYVY frames.
+static const char *qt_glsl_uyvyShaderProgram =
+        "uniform sampler2D texY;\n"
+        "uniform sampler2D texUV;\n"
+        "uniform mediump mat4 colorMatrix;\n"
+        "varying highp vec2 textureCoord;\n"
+        "void main(void)\n"
+        "{\n"
+        "    highp vec4 color = vec4(\n"
+        "           texture2D(texY, textureCoord.st).a,\n"
+        "           texture2D(texUV, textureCoord.st).rb,\n"
+        "           1.0);\n"
+        "    gl_FragColor = colorMatrix * color;\n"
+        "}\n";
+
+// Paints a premultiplied overlay rectangle.
+static const char *qt_glsl_overlayShaderProgram =
+        "uniform sampler2D texRgb;\n"
+        "varying highp vec2 textureCoord;\n"
+        "void main(void)\n"
+        "{\n"
+        "    gl_FragColor = texture2D(texRgb, textureCoord.st)." OVERLAY_SWIZZLE_GLSL ";\n"
+        "}\n";
+
+// Maps the painter's coordinates to the clip space, like its paint engine does.
+static void calculatePositionMatrix(const QPainter *painter, GLfloat positionMatrix[4][4])
+{
+    const int deviceWidth = painter->device()->width();
+    const int deviceHeight = painter->device()->height();
+
+    const QTransform transform = painter->deviceTransform();
+
+    const GLfloat wfactor = 2.0 / deviceWidth;
+    const GLfloat hfactor = -2.0 / deviceHeight;
+
+    positionMatrix[0][0] = wfactor * transform.m11() - transform.m13();
+    positionMatrix[0][1] = hfactor * transform.m12() + transform.m13();
+    positionMatrix[0][2] = 0.0;
+    positionMatrix[0][3] = transform.m13();
+
+    positionMatrix[1][0] = wfactor * transform.m21() - transform.m23();
+    positionMatrix[1][1] = hfactor * transform.m22() + transform.m23();
+    positionMatrix[1][2] = 0.0;
+    positionMatrix[1][3] = transform.m23();
+
+    positionMatrix[2][0] = 0.0;
+    positionMatrix[2][1] = 0.0;
+    positionMatrix[2][2] = -1.0;
+    positionMatrix[2][3] = 0.0;
+
+    positionMatrix[3][0] = wfactor * transform.dx() - transform.m33();
+    positionMatrix[3][1] = hfactor * transform.dy() + transform.m33();
+    positionMatrix[3][2] = 0.0;
+    positionMatrix[3][3] = transform.m33();
+}
+
 GlslSurfacePainter::GlslSurfacePainter()
     : OpenGLSurfacePainter()
 {
@@ -650,51 +1165,67 @@ void GlslSurfacePainter::init(const BufferFormat &format)
 
     switch (format.videoFormat()) {
     case GST_VIDEO_FORMAT_BGRx:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_bgrxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_xRGB:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_xrgbShaderProgram;
         break;
     case GST_VIDEO_FORMAT_BGRA:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_bgraShaderProgram;
         break;
     case GST_VIDEO_FORMAT_ARGB:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_argbShaderProgram;
         break;
     case GST_VIDEO_FORMAT_RGB:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_rgbxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_BGR:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_bgrxShaderProgram;
         break;
     //NOTE: unlike the other formats, this is endianness-dependent,
     //but using GL_UNSIGNED_SHORT_5_6_5 ensures that it's handled correctly
     case GST_VIDEO_FORMAT_RGB16:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_SHORT_5_6_5);
         fragmentProgram = qt_glsl_rgbxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_v308:
-        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_rgbxShaderProgram;
         break;
     case GST_VIDEO_FORMAT_AYUV:
-        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         fragmentProgram = qt_glsl_argbShaderProgram;
         break;
     case GST_VIDEO_FORMAT_YV12:
-        initYv12TextureInfo(format.frameSize());
+        initYuv420PTextureInfo();
         fragmentProgram = qt_glsl_yuvPlanarShaderProgram;
         break;
     case GST_VIDEO_FORMAT_I420:
-        initYuv420PTextureInfo(format.frameSize());
+        initYuv420PTextureInfo();
         fragmentProgram = qt_glsl_yuvPlanarShaderProgram;
         break;
+    case GST_VIDEO_FORMAT_NV12:
+        initSemiPlanarTextureInfo();
+        fragmentProgram = qt_glsl_nv12ShaderProgram;
+        break;
+    case GST_VIDEO_FORMAT_NV21:
+        initSemiPlanarTextureInfo();
+        fragmentProgram = qt_glsl_nv21ShaderProgram;
+        break;
+    case GST_VIDEO_FORMAT_YUY2:
+        initPacked422TextureInfo();
+        fragmentProgram = qt_glsl_yuy2ShaderProgram;
+        break;
+    case GST_VIDEO_FORMAT_UYVY:
+        initPacked422TextureInfo();
+        fragmentProgram = qt_glsl_uyvyShaderProgram;
+        break;
     default:
         Q_ASSERT(false);
         break;
@@ -714,13 +1245,21 @@ void GlslSurfacePainter::init(const BufferFormat &format)
         throw QString("Shader link error ") + m_program.log();
     }
 
-    glGenTextures(m_textureCount, m_textureIds);
+    if (!m_overlayProgram.addShaderFromSourceCode(QGLShader::Vertex, qt_glsl_vertexShaderProgram)
+            || !m_overlayProgram.addShaderFromSourceCode(QGLShader::Fragment,
+                                                         qt_glsl_overlayShaderProgram)
+            || !m_overlayProgram.link()) {
+        throw QString("Overlay shader error ") + m_overlayProgram.log();
+    }
+
+    initTextures(format);
 }
 
 void GlslSurfacePainter::cleanup()
 {
-    glDeleteTextures(m_textureCount, m_textureIds);
+    cleanupTextures();
     m_program.removeAllShaders();
+    m_overlayProgram.removeAllShaders();
 
     m_textureCount = 0;
 }
@@ -729,38 +1268,8 @@ void GlslSurfacePainter::paintImpl(const QPainter *painter,
         const GLfloat *vertexCoordArray,
         const GLfloat *textureCoordArray)
 {
-    const int deviceWidth = painter->device()->width();
-    const int deviceHeight = painter->device()->height();
-
-    const QTransform transform = painter->deviceTransform();
-
-    const GLfloat wfactor = 2.0 / deviceWidth;
-    const GLfloat hfactor = -2.0 / deviceHeight;
-
-    const GLfloat positionMatrix[4][4] =
-    {
-        {
-            /*(0,0)*/ GLfloat(wfactor * transform.m11() - transform.m13()),
-            /*(0,1)*/ GLfloat(hfactor * transform.m12() + transform.m13()),
-            /*(0,2)*/ 0.0,
-            /*(0,3)*/ GLfloat(transform.m13())
-        }, {
-            /*(1,0)*/ GLfloat(wfactor * transform.m21() - transform.m23()),
-            /*(1,1)*/ GLfloat(hfactor * transform.m22() + transform.m23()),
-            /*(1,2)*/ 0.0,
-            /*(1,3)*/ GLfloat(transform.m23())
-        }, {
-            /*(2,0)*/ 0.0,
-            /*(2,1)*/ 0.0,
-            /*(2,2)*/ -1.0,
-            /*(2,3)*/ 0.0
-        }, {
-            /*(3,0)*/ GLfloat(wfactor * transform.dx() - transform.m33()),
-            /*(3,1)*/ GLfloat(hfactor * transform.dy() + transform.m33()),
-            /*(3,2)*/ 0.0,
-            /*(3,3)*/ GLfloat(transform.m33())
-        }
-    };
+    GLfloat positionMatrix[4][4];
+    calculatePositionMatrix(painter, positionMatrix);
 
     m_program.bind();
 
@@ -770,22 +1279,19 @@ void GlslSurfacePainter::paintImpl(const QPainter *painter,
     m_program.setAttributeArray("textureCoordArray", textureCoordArray, 2);
     m_program.setUniformValue("positionMatrix", positionMatrix);
 
-    if (m_textureCount == 3) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[0]);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[1]);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[2]);
-        glActiveTexture(GL_TEXTURE0);
+    for (int i = m_textureCount - 1; i >= 0; --i) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
+    }
 
+    if (m_textureCount == 3) {
         m_program.setUniformValue("texY", 0);
         m_program.setUniformValue("texU", 1);
         m_program.setUniformValue("texV", 2);
+    } else if (m_textureCount == 2) {
+        m_program.setUniformValue("texY", 0);
+        m_program.setUniformValue("texUV", 1);
     } else {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[0]);
-
         m_program.setUniformValue("texRgb", 0);
     }
     m_program.setUniformValue("colorMatrix", m_colorMatrix);
@@ -794,3 +1300,24 @@ void GlslSurfacePainter::paintImpl(const QPainter *painter,
 
     m_program.release();
 }
+
+void GlslSurfacePainter::paintOverlayImpl(const QPainter *painter,
+        const GLfloat *vertexCoordArray,
+        const GLfloat *textureCoordArray)
+{
+    GLfloat positionMatrix[4][4];
+    calculatePositionMatrix(painter, positionMatrix);
+
+    m_overlayProgram.bind();
+
+    m_overlayProgram.enableAttributeArray("vertexCoordArray");
+    m_overlayProgram.enableAttributeArray("textureCoordArray");
+    m_overlayProgram.setAttributeArray("vertexCoordArray", vertexCoordArray, 2);
+    m_overlayProgram.setAttributeArray("textureCoordArray", textureCoordArray, 2);
+    m_overlayProgram.setUniformValue("positionMatrix", positionMatrix);
+    m_overlayProgram.setUniformValue("texRgb", 0);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    m_overlayProgram.release();
+}
@@ -20,7 +20,9 @@
 #ifndef GST_QT_VIDEO_SINK_NO_OPENGL
 
 #include "abstractsurfacepainter.h"
+#include "../utils/overlaycomposition.h"
 #include <QGLShaderProgram>
+#include <QHash>
 
 #ifndef Q_WS_MAC
 # ifndef APIENTRYP
@@ -48,31 +50,83 @@ public:
     }
 
     virtual void updateColors(int brightness, int contrast, int hue, int saturation);
-    virtual void paint(quint8 *data, const BufferFormat & frameFormat,
+    virtual void paint(const GstVideoFrame *frame, const BufferFormat & frameFormat,
                        QPainter *painter, const PaintAreas & areas);
 
+    // this is the time it took to submit the texture uploads; the driver
+    // may well carry them out asynchronously after paint() has returned
+    virtual qint64 lastUploadTime() const { return m_lastUploadTime; }
+
+    /*! Enables streaming the frames to the textures through a pair of pixel
+     * buffer objects, if the GL implementation supports them. This is enabled
+     * by default and takes effect on the next call to init(). */
+    void setPixelBufferObjectsEnabled(bool enabled) { m_pixelBufferObjectsEnabled = enabled; }
+    bool pixelBufferObjectsEnabled() const { return m_pixelBufferObjectsEnabled; }
+
 protected:
-    void initRgbTextureInfo(GLenum internalFormat, GLuint format, GLenum type, const QSize &size);
-    void initYuv420PTextureInfo(const QSize &size);
-    void initYv12TextureInfo(const QSize &size);
+    void initRgbTextureInfo(GLenum internalFormat, GLuint format, GLenum type);
+    void initYuv420PTextureInfo();
+    void initSemiPlanarTextureInfo();
+    void initPacked422TextureInfo();
+
+    void initTextures(const BufferFormat & format);
+    void cleanupTextures();
+
+    // uploads the rectangles that are new in m_overlays and drops the old ones
+    void updateOverlayTextures();
+    void paintOverlays(const QPainter *painter, const QSize & frameSize,
+                       const PaintAreas & areas);
+
+    // uploads the texture data for texture i, whose rows are stride bytes apart
+    void uploadTexture(int i, const quint8 *data, int stride, int texelSize);
 
     virtual void paintImpl(const QPainter *painter,
                            const GLfloat *vertexCoordArray,
                            const GLfloat *textureCoordArray) = 0;
 
+    // draws the premultiplied native endian ARGB texture bound to unit 0,
+    // with blending already set up
+    virtual void paintOverlayImpl(const QPainter *painter,
+                                  const GLfloat *vertexCoordArray,
+                                  const GLfloat *textureCoordArray) = 0;
+
 #ifndef QT_OPENGL_ES
     typedef void (APIENTRY *_glActiveTexture) (GLenum);
     _glActiveTexture glActiveTexture;
+
+    typedef void (APIENTRY *_glGenBuffers) (GLsizei, GLuint *);
+    typedef void (APIENTRY *_glDeleteBuffers) (GLsizei, const GLuint *);
+    typedef void (APIENTRY *_glBindBuffer) (GLenum, GLuint);
+    typedef void (APIENTRY *_glBufferData) (GLenum, qptrdiff, const GLvoid *, GLenum);
+    typedef GLvoid* (APIENTRY *_glMapBuffer) (GLenum, GLenum);
+    typedef GLboolean (APIENTRY *_glUnmapBuffer) (GLenum);
+
+    _glGenBuffers glGenBuffers;
+    _glDeleteBuffers glDeleteBuffers;
+    _glBindBuffer glBindBuffer;
+    _glBufferData glBufferData;
+    _glMapBuffer glMapBuffer;
+    _glUnmapBuffer glUnmapBuffer;
 #endif
 
-    GLenum m_textureFormat;
-    GLuint m_textureInternalFormat;
-    GLenum m_textureType;
     int m_textureCount;
+    GLenum m_textureFormats[3];
+    GLuint m_textureInternalFormats[3];
+    GLenum m_textureTypes[3];
     GLuint m_textureIds[3];
     int m_textureWidths[3];
     int m_textureHeights[3];
-    int m_textureOffsets[3];
+
+    bool m_pixelBufferObjectsEnabled;
+    int m_pixelBufferCount;
+    int m_pixelBufferIndex;
+    GLuint m_pixelBufferIds[2];
+
+    qint64 m_lastUploadTime;
+
+    // the overlay textures, by the seqnum of their rectangle
+    OverlayComposition m_overlays;
+    QHash<guint, GLuint> m_overlayTextures;
 
     QMatrix4x4 m_colorMatrix;
     GstVideoColorMatrix m_videoColorMatrix;
@@ -92,8 +146,13 @@ protected:
     virtual void paintImpl(const QPainter *painter,
                            const GLfloat *vertexCoordArray,
                            const GLfloat *textureCoordArray);
+    virtual void paintOverlayImpl(const QPainter *painter,
+                                  const GLfloat *vertexCoordArray,
+                                  const GLfloat *textureCoordArray);
 
 private:
+    void loadProgram(GLuint *programId, const char *program);
+
     typedef void (APIENTRY *_glProgramStringARB) (GLenum, GLenum, GLsizei, const GLvoid *);
     typedef void (APIENTRY *_glBindProgramARB) (GLenum, GLuint);
     typedef void (APIENTRY *_glDeleteProgramsARB) (GLsizei, const GLuint *);
@@ -109,6 +168,7 @@ private:
     _glProgramLocalParameter4fARB glProgramLocalParameter4fARB;
 
     GLuint m_programId;
+    GLuint m_overlayProgramId;
 };
 
 #endif
@@ -125,9 +185,13 @@ protected:
     virtual void paintImpl(const QPainter *painter,
                            const GLfloat *vertexCoordArray,
                            const GLfloat *textureCoordArray);
+    virtual void paintOverlayImpl(const QPainter *painter,
+                                  const GLfloat *vertexCoordArray,
+                                  const GLfloat *textureCoordArray);
 
 private:
     QGLShaderProgram m_program;
+    QGLShaderProgram m_overlayProgram;
 };
 
 #endif // GST_QT_VIDEO_SINK_NO_OPENGL
@@ -0,0 +1,141 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "overlaymaterial.h"
+
+#include <QtQuick/QSGMaterialShader>
+
+static const char * const qtvideosink_glsl_overlayVertexShader =
+    "uniform highp mat4 qt_Matrix;                      \n"
+    "attribute highp vec4 qt_VertexPosition;            \n"
+    "attribute highp vec2 qt_VertexTexCoord;            \n"
+    "varying highp vec2 qt_TexCoord;                    \n"
+    "void main() {                                      \n"
+    "    qt_TexCoord = qt_VertexTexCoord;               \n"
+    "    gl_Position = qt_Matrix * qt_VertexPosition;   \n"
+    "}";
+
+// the texture holds the bytes of native endian ARGB words, which
+// are already premultiplied, like the scene graph wants them
+static const char * const qtvideosink_glsl_overlayFragmentShader =
+    "uniform sampler2D overlayTexture;\n"
+    "uniform lowp float opacity;\n"
+    "varying highp vec2 qt_TexCoord;\n"
+    "void main(void)\n"
+    "{\n"
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    "    gl_FragColor = texture2D(overlayTexture, qt_TexCoord.st).gbar * opacity;\n"
+#else
+    "    gl_FragColor = texture2D(overlayTexture, qt_TexCoord.st).bgra * opacity;\n"
+#endif
+    "}\n";
+
+class OverlayMaterialShader : public QSGMaterialShader
+{
+public:
+    virtual void updateState(const RenderState &state,
+        QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
+    {
+        Q_UNUSED(oldMaterial);
+
+        program()->setUniformValue(m_id_overlayTexture, 0);
+
+        if (state.isOpacityDirty())
+            program()->setUniformValue(m_id_opacity, GLfloat(state.opacity()));
+
+        if (state.isMatrixDirty())
+            program()->setUniformValue(m_id_matrix, state.combinedMatrix());
+
+        static_cast<OverlayMaterial *>(newMaterial)->bind();
+    }
+
+    virtual char const *const *attributeNames() const {
+        static const char *names[] = {
+            "qt_VertexPosition",
+            "qt_VertexTexCoord",
+            0
+        };
+        return names;
+    }
+
+protected:
+    virtual void initialize() {
+        m_id_matrix = program()->uniformLocation("qt_Matrix");
+        m_id_overlayTexture = program()->uniformLocation("overlayTexture");
+        m_id_opacity = program()->uniformLocation("opacity");
+    }
+
+    virtual const char *vertexShader() const {
+        return qtvideosink_glsl_overlayVertexShader;
+    }
+
+    virtual const char *fragmentShader() const {
+        return qtvideosink_glsl_overlayFragmentShader;
+    }
+
+    int m_id_matrix;
+    int m_id_overlayTexture;
+    int m_id_opacity;
+};
+
+OverlayMaterial::OverlayMaterial(const QImage & image)
+    : m_image(image)
+    , m_textureId(0)
+{
+    setFlag(Blending, true);
+}
+
+OverlayMaterial::~OverlayMaterial()
+{
+    if (m_textureId)
+        glDeleteTextures(1, &m_textureId);
+}
+
+QSGMaterialType *OverlayMaterial::type() const
+{
+    static QSGMaterialType theType;
+    return &theType;
+}
+
+QSGMaterialShader *OverlayMaterial::createShader() const
+{
+    return new OverlayMaterialShader;
+}
+
+int OverlayMaterial::compare(const QSGMaterial *other) const
+{
+    return m_textureId - static_cast<const OverlayMaterial *>(other)->m_textureId;
+}
+
+void OverlayMaterial::bind()
+{
+    if (m_textureId) {
+        glBindTexture(GL_TEXTURE_2D, m_textureId);
+        return;
+    }
+
+    glGenTextures(1, &m_textureId);
+    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_image.width(), m_image.height(),
+                 0, GL_RGBA, GL_UNSIGNED_BYTE, m_image.constBits());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // the texture is all that is needed from now on
+    m_image = QImage();
+}
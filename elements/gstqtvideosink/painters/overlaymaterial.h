@@ -0,0 +1,45 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OVERLAYMATERIAL_H
+#define OVERLAYMATERIAL_H
+
+#include <QImage>
+#include <QtQuick/QSGMaterial>
+
+/**
+ * Material of the nodes that draw the rectangles of an overlay composition
+ * on top of a VideoNode. The image, a premultiplied ARGB32 one, is uploaded
+ * to a texture the first time that the material is bound and never again.
+ */
+class OverlayMaterial : public QSGMaterial
+{
+public:
+    explicit OverlayMaterial(const QImage & image);
+    virtual ~OverlayMaterial();
+
+    virtual QSGMaterialType *type() const;
+    virtual QSGMaterialShader *createShader() const;
+    virtual int compare(const QSGMaterial *other) const;
+
+    void bind();
+
+private:
+    QImage m_image;
+    GLuint m_textureId;
+};
+
+#endif // OVERLAYMATERIAL_H
@@ -95,6 +95,78 @@ inline const char * const qtvideosink_glsl_yuvPlanarFragmentShader()
     "}\n";
 }
 
+inline const char * const qtvideosink_glsl_nv12FragmentShader()
+{
+    return
+    "uniform sampler2D yTexture;\n"
+    "uniform sampler2D uvTexture;\n"
+    "uniform mediump mat4 colorMatrix;\n"
+    "uniform lowp float opacity;\n"
+    "varying highp vec2 qt_TexCoord;\n"
+    "void main(void)\n"
+    "{\n"
+    "    highp vec4 color = vec4(\n"
+    "           texture2D(yTexture, qt_TexCoord.st).r,\n"
+    "           texture2D(uvTexture, qt_TexCoord.st).ra,\n"
+    "           1.0);\n"
+    "    gl_FragColor = colorMatrix * color * opacity;\n"
+    "}\n";
+}
+
+inline const char * const qtvideosink_glsl_nv21FragmentShader()
+{
+    return
+    "uniform sampler2D yTexture;\n"
+    "uniform sampler2D uvTexture;\n"
+    "uniform mediump mat4 colorMatrix;\n"
+    "uniform lowp float opacity;\n"
+    "varying highp vec2 qt_TexCoord;\n"
+    "void main(void)\n"
+    "{\n"
+    "    highp vec4 color = vec4(\n"
+    "           texture2D(yTexture, qt_TexCoord.st).r,\n"
+    "           texture2D(uvTexture, qt_TexCoord.st).ar,\n"
+    "           1.0);\n"
+    "    gl_FragColor = colorMatrix * color * opacity;\n"
+    "}\n";
+}
+
+inline const char * const qtvideosink_glsl_yuy2FragmentShader()
+{
+    return
+    "uniform sampler2D yTexture;\n"
+    "uniform sampler2D uvTexture;\n"
+    "uniform mediump mat4 colorMatrix;\n"
+    "uniform lowp float opacity;\n"
+    "varying highp vec2 qt_TexCoord;\n"
+    "void main(void)\n"
+    "{\n"
+    "    highp vec4 color = vec4(\n"
+    "           texture2D(yTexture, qt_TexCoord.st).r,\n"
+    "           texture2D(uvTexture, qt_TexCoord.st).ga,\n"
+    "           1.0);\n"
+    "    gl_FragColor = colorMatrix * color * opacity;\n"
+    "}\n";
+}
+
+inline const char * const qtvideosink_glsl_uyvyFragmentShader()
+{
+    return
+    "uniform sampler2D yTexture;\n"
+    "uniform sampler2D uvTexture;\n"
+    "uniform mediump mat4 colorMatrix;\n"
+    "uniform lowp float opacity;\n"
+    "varying highp vec2 qt_TexCoord;\n"
+    "void main(void)\n"
+    "{\n"
+    "    highp vec4 color = vec4(\n"
+    "           texture2D(yTexture, qt_TexCoord.st).a,\n"
+    "           texture2D(uvTexture, qt_TexCoord.st).rb,\n"
+    "           1.0);\n"
+    "    gl_FragColor = colorMatrix * color * opacity;\n"
+    "}\n";
+}
+
 class VideoMaterialShader : public QSGMaterialShader
 {
 public:
@@ -110,6 +182,7 @@ public:
             program()->setUniformValue(m_id_yTexture, 0);
             program()->setUniformValue(m_id_uTexture, 1);
             program()->setUniformValue(m_id_vTexture, 2);
+            program()->setUniformValue(m_id_uvTexture, 1);
         }
 
         if (state.isOpacityDirty()) {
@@ -142,6 +215,7 @@ protected:
         m_id_yTexture = program()->uniformLocation("yTexture");
         m_id_uTexture = program()->uniformLocation("uTexture");
         m_id_vTexture = program()->uniformLocation("vTexture");
+        m_id_uvTexture = program()->uniformLocation("uvTexture");
         m_id_colorMatrix = program()->uniformLocation("colorMatrix");
         m_id_opacity = program()->uniformLocation("opacity");
     }
@@ -155,6 +229,7 @@ protected:
     int m_id_yTexture;
     int m_id_uTexture;
     int m_id_vTexture;
+    int m_id_uvTexture;
     int m_id_colorMatrix;
     int m_id_opacity;
 };
@@ -191,11 +266,11 @@ VideoMaterial *VideoMaterial::create(const BufferFormat & format)
     case GST_VIDEO_FORMAT_BGRx:
     case GST_VIDEO_FORMAT_BGRA:
         material = new VideoMaterialImpl<qtvideosink_glsl_bgrxFragmentShader>;
-        material->initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        material->initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         break;
     case GST_VIDEO_FORMAT_BGR:
         material = new VideoMaterialImpl<qtvideosink_glsl_bgrxFragmentShader>;
-        material->initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        material->initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         break;
 
     // xRGB
@@ -203,27 +278,45 @@ VideoMaterial *VideoMaterial::create(const BufferFormat & format)
     case GST_VIDEO_FORMAT_ARGB:
     case GST_VIDEO_FORMAT_AYUV:
         material = new VideoMaterialImpl<qtvideosink_glsl_xrgbFragmentShader>;
-        material->initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, format.frameSize());
+        material->initRgbTextureInfo(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
         break;
 
     // RGBx
     case GST_VIDEO_FORMAT_RGB:
     case GST_VIDEO_FORMAT_v308:
         material = new VideoMaterialImpl<qtvideosink_glsl_rgbxFragmentShader>;
-        material->initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, format.frameSize());
+        material->initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
         break;
     case GST_VIDEO_FORMAT_RGB16:
         material = new VideoMaterialImpl<qtvideosink_glsl_rgbxFragmentShader>;
-        material->initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, format.frameSize());
+        material->initRgbTextureInfo(GL_RGB, GL_RGB, GL_UNSIGNED_SHORT_5_6_5);
         break;
 
     // YUV 420 planar
     case GST_VIDEO_FORMAT_I420:
     case GST_VIDEO_FORMAT_YV12:
         material = new VideoMaterialImpl<qtvideosink_glsl_yuvPlanarFragmentShader>;
-        material->initYuv420PTextureInfo(
-            (format.videoFormat() == GST_VIDEO_FORMAT_YV12) /* uvSwapped */,
-            format.frameSize());
+        material->initYuv420PTextureInfo();
+        break;
+
+    // YUV 420 semi-planar
+    case GST_VIDEO_FORMAT_NV12:
+        material = new VideoMaterialImpl<qtvideosink_glsl_nv12FragmentShader>;
+        material->initSemiPlanarTextureInfo();
+        break;
+    case GST_VIDEO_FORMAT_NV21:
+        material = new VideoMaterialImpl<qtvideosink_glsl_nv21FragmentShader>;
+        material->initSemiPlanarTextureInfo();
+        break;
+
+    // YUV 422 packed
+    case GST_VIDEO_FORMAT_YUY2:
+        material = new VideoMaterialImpl<qtvideosink_glsl_yuy2FragmentShader>;
+        material->initPacked422TextureInfo();
+        break;
+    case GST_VIDEO_FORMAT_UYVY:
+        material = new VideoMaterialImpl<qtvideosink_glsl_uyvyFragmentShader>;
+        material->initPacked422TextureInfo();
         break;
 
     default:
@@ -231,26 +324,27 @@ VideoMaterial *VideoMaterial::create(const BufferFormat & format)
         break;
     }
 
-    material->init(format.colorMatrix());
+    material->init(format);
     return material;
 }
 
 VideoMaterial::VideoMaterial() :
     m_frame(0),
+    m_lastUploadTime(0),
     m_textureCount(0),
-    m_format(GST_VIDEO_FORMAT_UNKNOWN),
-    m_textureFormat(0),
-    m_textureInternalFormat(0),
-    m_textureType(0),
     m_colorMatrixType(GST_VIDEO_COLOR_MATRIX_UNKNOWN)
 {
     memset(m_textureIds, 0, sizeof(m_textureIds));
+    memset(m_texturesAllocated, 0, sizeof(m_texturesAllocated));
+    memset(m_textureFormats, 0, sizeof(m_textureFormats));
+    memset(m_textureInternalFormats, 0, sizeof(m_textureInternalFormats));
+    memset(m_textureTypes, 0, sizeof(m_textureTypes));
     setFlag(Blending, false);
 }
 
 VideoMaterial::~VideoMaterial()
 {
-    if (!m_textureSize.isEmpty())
+    if (m_textureCount)
         glDeleteTextures(m_textureCount, m_textureIds);
     gst_buffer_replace(&m_frame, NULL);
 }
@@ -268,7 +362,7 @@ int VideoMaterial::compare(const QSGMaterial *other) const
 }
 
 void VideoMaterial::initRgbTextureInfo(
-        GLenum internalFormat, GLuint format, GLenum type, const QSize &size)
+        GLenum internalFormat, GLuint format, GLenum type)
 {
 #ifndef QT_OPENGL_ES
     //make sure we get 8 bits per component, at least on the desktop GL where we can
@@ -284,42 +378,65 @@ void VideoMaterial::initRgbTextureInfo(
     }
 #endif
 
-    m_textureInternalFormat = internalFormat;
-    m_textureFormat = format;
-    m_textureType = type;
+    m_textureInternalFormats[0] = internalFormat;
+    m_textureFormats[0] = format;
+    m_textureTypes[0] = type;
     m_textureCount = 1;
-    m_textureWidths[0] = size.width();
-    m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
 }
 
-void VideoMaterial::initYuv420PTextureInfo(bool uvSwapped, const QSize &size)
+void VideoMaterial::initYuv420PTextureInfo()
 {
-    int bytesPerLine = (size.width() + 3) & ~3;
-    int bytesPerLine2 = (size.width() / 2 + 3) & ~3;
-
-    m_textureInternalFormat = GL_LUMINANCE;
-    m_textureFormat = GL_LUMINANCE;
-    m_textureType = GL_UNSIGNED_BYTE;
+    // one texture per plane, in Y, U, V order whatever the order of the planes
     m_textureCount = 3;
-    m_textureWidths[0] = bytesPerLine;
-    m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
-    m_textureWidths[1] = bytesPerLine2;
-    m_textureHeights[1] = size.height() / 2;
-    m_textureOffsets[1] = bytesPerLine * size.height();
-    m_textureWidths[2] = bytesPerLine2;
-    m_textureHeights[2] = size.height() / 2;
-    m_textureOffsets[2] = bytesPerLine * size.height() + bytesPerLine2 * size.height()/2;
-
-    if (uvSwapped)
-      qSwap (m_textureOffsets[1], m_textureOffsets[2]);
+    for (int i = 0; i < m_textureCount; ++i) {
+        m_textureInternalFormats[i] = GL_LUMINANCE;
+        m_textureFormats[i] = GL_LUMINANCE;
+        m_textureTypes[i] = GL_UNSIGNED_BYTE;
+    }
+}
+
+void VideoMaterial::initSemiPlanarTextureInfo()
+{
+    // the interleaved chroma plane is sampled as a half-sized luminance-alpha
+    // texture; the shader picks U and V out of it in the right order
+    m_textureCount = 2;
+    m_textureInternalFormats[0] = GL_LUMINANCE;
+    m_textureFormats[0] = GL_LUMINANCE;
+    m_textureTypes[0] = GL_UNSIGNED_BYTE;
+    m_textureInternalFormats[1] = GL_LUMINANCE_ALPHA;
+    m_textureFormats[1] = GL_LUMINANCE_ALPHA;
+    m_textureTypes[1] = GL_UNSIGNED_BYTE;
+}
+
+void VideoMaterial::initPacked422TextureInfo()
+{
+    // both textures look at the same data: the luminance-alpha one gives the
+    // luma of every pixel and the half-width RGBA one gives a whole macropixel
+    m_textureCount = 2;
+    m_textureInternalFormats[0] = GL_LUMINANCE_ALPHA;
+    m_textureFormats[0] = GL_LUMINANCE_ALPHA;
+    m_textureTypes[0] = GL_UNSIGNED_BYTE;
+    m_textureInternalFormats[1] = GL_RGBA;
+    m_textureFormats[1] = GL_RGBA;
+    m_textureTypes[1] = GL_UNSIGNED_BYTE;
 }
 
-void VideoMaterial::init(GstVideoColorMatrix colorMatrixType)
+void VideoMaterial::init(const BufferFormat & format)
 {
+    // texture i holds component i, so it is as big as that component,
+    // rather than as the whole stride, which may include padding
+    GstVideoInfo videoInfo = format.videoInfo();
+    const GstVideoFormatInfo *finfo = videoInfo.finfo;
+    for (int i = 0; i < m_textureCount; ++i) {
+        m_textureWidths[i] = GST_VIDEO_FORMAT_INFO_SCALE_WIDTH(finfo, i,
+                GST_VIDEO_INFO_WIDTH(&videoInfo));
+        m_textureHeights[i] = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT(finfo, i,
+                GST_VIDEO_INFO_HEIGHT(&videoInfo));
+    }
+
     glGenTextures(m_textureCount, m_textureIds);
-    m_colorMatrixType = colorMatrixType;
+    m_bufferFormat = format;
+    m_colorMatrixType = format.colorMatrix();
     updateColors(0, 0, 0, 0);
 }
 
@@ -329,6 +446,12 @@ void VideoMaterial::setCurrentFrame(GstBuffer *buffer)
     gst_buffer_replace(&m_frame, buffer);
 }
 
+qint64 VideoMaterial::lastUploadTime() const
+{
+    QMutexLocker lock(&m_frameMutex);
+    return m_lastUploadTime;
+}
+
 void VideoMaterial::updateColors(int brightness, int contrast, int hue, int saturation)
 {
     const qreal b = brightness / 200.0;
@@ -396,6 +519,29 @@ void VideoMaterial::updateColors(int brightness, int contrast, int hue, int satu
                     1.164,  2.017,  0.000, -1.081,
                     0.0,    0.000,  0.000,  1.0000);
         break;
+    case GST_VIDEO_COLOR_MATRIX_FCC:
+        m_colorMatrix *= QMatrix4x4(
+                    1.164,  0.000,  1.594, -0.8699,
+                    1.164, -0.378, -0.810,  0.5210,
+                    1.164,  2.026,  0.000, -1.0862,
+                    0.0,    0.000,  0.000,  1.0000);
+        break;
+    case GST_VIDEO_COLOR_MATRIX_SMPTE240M:
+        m_colorMatrix *= QMatrix4x4(
+                    1.164,  0.000,  1.794, -0.9701,
+                    1.164, -0.258, -0.543,  0.3272,
+                    1.164,  2.079,  0.000, -1.1124,
+                    0.0,    0.000,  0.000,  1.0000);
+        break;
+#if GST_CHECK_VERSION(1, 6, 0)
+    case GST_VIDEO_COLOR_MATRIX_BT2020:
+        m_colorMatrix *= QMatrix4x4(
+                    1.164,  0.000,  1.679, -0.9124,
+                    1.164, -0.187, -0.650,  0.3458,
+                    1.164,  2.142,  0.000, -1.1439,
+                    0.0,    0.000,  0.000,  1.0000);
+        break;
+#endif
     default:
         break;
     }
@@ -404,58 +550,113 @@ void VideoMaterial::updateColors(int brightness, int contrast, int hue, int satu
 void VideoMaterial::bind()
 {
     QOpenGLFunctions *functions = QOpenGLContext::currentContext()->functions();
-    GstBuffer *frame = NULL;
 
+    // take the frame over, so that it is uploaded only once no matter how
+    // many times the scene graph renders it, and so that the material does
+    // not keep it from going back to the upstream pool after the upload.
+    // re-renders without a new frame only bind the textures again
     m_frameMutex.lock();
-    if (m_frame)
-      frame = gst_buffer_ref(m_frame);
+    GstBuffer *frame = m_frame;
+    m_frame = NULL;
     m_frameMutex.unlock();
 
+    const qint64 uploadStartTime = g_get_monotonic_time();
+    GstVideoFrame videoFrame;
+    if (frame && !m_bufferFormat.mapFrame(&videoFrame, frame)) {
+        gst_buffer_unref(frame);
+        frame = NULL;
+    }
+
+    QRect cropRect;
     if (frame) {
-        GstMapInfo info;
-        gst_buffer_map(frame, &info, GST_MAP_READ);
-        if (m_textureCount > 1) {
-            functions->glActiveTexture(GL_TEXTURE1);
-            bindTexture(1, info.data);
-        }
-        if (m_textureCount > 2) {
-            functions->glActiveTexture(GL_TEXTURE2);
-            bindTexture(2, info.data);
+        cropRect = m_bufferFormat.cropRect(&videoFrame);
+    }
+
+    // finish with 0 as the default texture unit
+    for (int i = m_textureCount - 1; i >= 0; --i) {
+        functions->glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
+        if (frame) {
+            uploadTexture(i, &videoFrame, cropRect.topLeft());
         }
-        functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
-        bindTexture(0, info.data);
-        gst_buffer_unmap(frame, &info);
+    }
+
+    if (frame) {
+        // glTexSubImage2D() is done with the client memory once it returns,
+        // so there is nothing to wait for before releasing the buffer
+        gst_video_frame_unmap(&videoFrame);
         gst_buffer_unref(frame);
-    } else {
-        if (m_textureCount > 1) {
-            functions->glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, m_textureIds[1]);
-        }
-        if (m_textureCount > 2) {
-            functions->glActiveTexture(GL_TEXTURE2);
-            glBindTexture(GL_TEXTURE_2D, m_textureIds[2]);
-        }
-        functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
-        glBindTexture(GL_TEXTURE_2D, m_textureIds[0]);
+
+        const qint64 uploadTime = g_get_monotonic_time() - uploadStartTime;
+        m_frameMutex.lock();
+        m_lastUploadTime = uploadTime;
+        m_frameMutex.unlock();
     }
 }
 
-void VideoMaterial::bindTexture(int i, const quint8 *data)
+void VideoMaterial::uploadTexture(int i, const GstVideoFrame *frame, const QPoint & origin)
 {
-    glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        m_textureInternalFormat,
-        m_textureWidths[i],
-        m_textureHeights[i],
-        0,
-        m_textureFormat,
-        m_textureType,
-        data + m_textureOffsets[i]);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-}
+    // texture i holds component i of the frame, starting at the crop origin
+    const GstVideoFormatInfo *finfo = frame->info.finfo;
+    const int plane = GST_VIDEO_FORMAT_INFO_PLANE(finfo, i);
+    const int stride = GST_VIDEO_FRAME_PLANE_STRIDE(frame, plane);
+    const int texelSize = GST_VIDEO_FORMAT_INFO_PSTRIDE(finfo, i);
+    const quint8 *data = static_cast<const quint8 *>(GST_VIDEO_FRAME_PLANE_DATA(frame, plane))
+            + (origin.y() >> GST_VIDEO_FORMAT_INFO_H_SUB(finfo, i)) * stride
+            + (origin.x() >> GST_VIDEO_FORMAT_INFO_W_SUB(finfo, i)) * texelSize;
+
+    // the texture size only changes together with the format, in which case
+    // a new material is created, so the storage needs to be allocated once
+    if (!m_texturesAllocated[i]) {
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            m_textureInternalFormats[i],
+            m_textureWidths[i],
+            m_textureHeights[i],
+            0,
+            m_textureFormats[i],
+            m_textureTypes[i],
+            NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        m_texturesAllocated[i] = true;
+    }
+
+    const int rowSize = m_textureWidths[i] * texelSize;
+
+    // the rows are padded to the unpack alignment, so if one of them
+    // gives the stride of the frame, the texture can be uploaded at once
+    for (int alignment = 8; alignment >= 1; alignment /= 2) {
+        if (((rowSize + alignment - 1) & ~(alignment - 1)) == stride) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_textureWidths[i], m_textureHeights[i],
+                            m_textureFormats[i], m_textureTypes[i], data);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            return;
+        }
+    }
 
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+#ifndef QT_OPENGL_ES
+    // otherwise, desktop GL can be told the stride, if it is a whole number of texels
+    if (stride % texelSize == 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / texelSize);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_textureWidths[i], m_textureHeights[i],
+                        m_textureFormats[i], m_textureTypes[i], data);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        return;
+    }
+#endif
+
+    // and the odd strides that are left are uploaded row by row
+    for (int y = 0; y < m_textureHeights[i]; ++y) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, m_textureWidths[i], 1,
+                        m_textureFormats[i], m_textureTypes[i], data + y * stride);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
@@ -37,37 +37,43 @@ public:
 
     virtual int compare(const QSGMaterial *other) const;
 
+    // the frame is uploaded on the next bind() and released right after
     void setCurrentFrame(GstBuffer *buffer);
     void updateColors(int brightness, int contrast, int hue, int saturation);
 
     void bind();
 
+    // time the last bind() spent uploading the frame, in microseconds
+    qint64 lastUploadTime() const;
+
 protected:
     VideoMaterial();
-    void initRgbTextureInfo(GLenum internalFormat, GLuint format,
-                            GLenum type, const QSize &size);
-    void initYuv420PTextureInfo(bool uvSwapped, const QSize &size);
-    void init(GstVideoColorMatrix colorMatrixType);
+    void initRgbTextureInfo(GLenum internalFormat, GLuint format, GLenum type);
+    void initYuv420PTextureInfo();
+    void initSemiPlanarTextureInfo();
+    void initPacked422TextureInfo();
+    void init(const BufferFormat & format);
 
 private:
-    void bindTexture(int i, const quint8 *data);
+    // uploads component i of the frame, from origin on, to the bound texture
+    void uploadTexture(int i, const GstVideoFrame *frame, const QPoint & origin);
 
 
     GstBuffer *m_frame;
-    QMutex m_frameMutex;
+    qint64 m_lastUploadTime;
+    mutable QMutex m_frameMutex;
 
     static const int Num_Texture_IDs = 3;
     int m_textureCount;
     GLuint m_textureIds[Num_Texture_IDs];
     int m_textureWidths[Num_Texture_IDs];
     int m_textureHeights[Num_Texture_IDs];
-    int m_textureOffsets[Num_Texture_IDs];
-    QSize m_textureSize;
+    bool m_texturesAllocated[Num_Texture_IDs];
 
-    GstVideoFormat m_format;
-    GLenum m_textureFormat;
-    GLuint m_textureInternalFormat;
-    GLenum m_textureType;
+    BufferFormat m_bufferFormat;
+    GLenum m_textureFormats[Num_Texture_IDs];
+    GLuint m_textureInternalFormats[Num_Texture_IDs];
+    GLenum m_textureTypes[Num_Texture_IDs];
 
     QMatrix4x4 m_colorMatrix;
     GstVideoColorMatrix m_colorMatrixType;
@@ -18,6 +18,7 @@
 
 #include "videonode.h"
 #include "videomaterial.h"
+#include "overlaymaterial.h"
 
 #include <QtQuick/QSGFlatColorMaterial>
 
@@ -51,6 +52,13 @@ void VideoNode::setCurrentFrame(GstBuffer* buffer)
     markDirty(DirtyMaterial);
 }
 
+qint64 VideoNode::lastUploadTime() const
+{
+    if (m_materialType != MaterialTypeVideo)
+        return 0;
+    return static_cast<VideoMaterial*>(material())->lastUploadTime();
+}
+
 void VideoNode::updateColors(int brightness, int contrast, int hue, int saturation)
 {
     Q_ASSERT (m_materialType == MaterialTypeVideo);
@@ -112,3 +120,45 @@ void VideoNode::updateGeometry(const PaintAreas & areas)
 
     markDirty(DirtyGeometry);
 }
+
+void VideoNode::updateOverlays(const OverlayComposition & overlays,
+        const QSize & frameSize, const PaintAreas & areas)
+{
+    // the children are appended again in the order of the composition,
+    // reusing the nodes, and thus the textures, of the known rectangles
+    QHash<guint, QSGGeometryNode*> nodes;
+    removeAllChildNodes();
+
+    Q_FOREACH(const OverlayComposition::Rectangle & rectangle, overlays.rectangles()) {
+        QSGGeometryNode *node = m_overlayNodes.take(rectangle.seqnum);
+        if (!node) {
+            node = new QSGGeometryNode;
+            node->setFlags(OwnsGeometry | OwnsMaterial, true);
+            node->setGeometry(new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4));
+            node->setMaterial(new OverlayMaterial(rectangle.image));
+        }
+        nodes.insert(rectangle.seqnum, node);
+        appendChildNode(node);
+
+        // rectangles that are out of the video area collapse to a point
+        QRectF target, source;
+        if (!OverlayComposition::mapRectangle(rectangle.renderRect, frameSize,
+                                              areas, &target, &source)) {
+            target = source = QRectF();
+        }
+
+        QSGGeometry::TexturedPoint2D *v = node->geometry()->vertexDataAsTexturedPoint2D();
+        setGeom(v + 0, target.topLeft());
+        setGeom(v + 1, target.bottomLeft());
+        setGeom(v + 2, target.topRight());
+        setGeom(v + 3, target.bottomRight());
+        setTex(v + 0, source.topLeft());
+        setTex(v + 1, source.bottomLeft());
+        setTex(v + 2, source.topRight());
+        setTex(v + 3, source.bottomRight());
+        node->markDirty(DirtyGeometry);
+    }
+
+    qDeleteAll(m_overlayNodes);
+    m_overlayNodes = nodes;
+}
@@ -20,7 +20,9 @@
 #define VIDEONODE_H
 
 #include "../utils/bufferformat.h"
+#include "../utils/overlaycomposition.h"
 
+#include <QHash>
 #include <QtQuick/QSGGeometryNode>
 
 class VideoNode : public QSGGeometryNode
@@ -39,13 +41,20 @@ public:
     void setMaterialTypeSolidBlack();
 
     void setCurrentFrame(GstBuffer *buffer);
+    qint64 lastUploadTime() const;
     void updateColors(int brightness, int contrast, int hue, int saturation);
 
     void updateGeometry(const PaintAreas & areas);
 
+    // shows the rectangles of overlays on top of the video, as child nodes
+    // that keep their texture for as long as their rectangle is shown
+    void updateOverlays(const OverlayComposition & overlays,
+                        const QSize & frameSize, const PaintAreas & areas);
+
 private:
     MaterialType m_materialType;
     bool m_validGeometry;
+    QHash<guint, QSGGeometryNode*> m_overlayNodes;
 };
 
 #endif // VIDEONODE_H
@@ -48,6 +48,34 @@ int BufferFormat::bytesPerLine(int component) const
     return GST_VIDEO_INFO_PLANE_STRIDE(&(d->videoInfo), component);
 }
 
+bool BufferFormat::mapFrame(GstVideoFrame *frame, GstBuffer *buffer) const
+{
+    GstVideoInfo info = d->videoInfo;
+    return gst_video_frame_map(frame, &info, buffer, GST_MAP_READ);
+}
+
+QRect BufferFormat::cropRect(const GstVideoFrame *frame) const
+{
+    QRect rect(QPoint(0, 0), frameSize());
+
+    GstVideoCropMeta *crop = gst_buffer_get_video_crop_meta(frame->buffer);
+    if (crop) {
+        // the frame may be larger than the caps, but the area must fit in it
+        int x = qBound<int>(0, crop->x, GST_VIDEO_FRAME_WIDTH(frame) - rect.width());
+        int y = qBound<int>(0, crop->y, GST_VIDEO_FRAME_HEIGHT(frame) - rect.height());
+
+        // subsampled planes can only be cropped at whole chroma samples
+        const GstVideoFormatInfo *finfo = frame->info.finfo;
+        for (guint i = 0; i < GST_VIDEO_FORMAT_INFO_N_COMPONENTS(finfo); ++i) {
+            x &= ~((1 << GST_VIDEO_FORMAT_INFO_W_SUB(finfo, i)) - 1);
+            y &= ~((1 << GST_VIDEO_FORMAT_INFO_H_SUB(finfo, i)) - 1);
+        }
+        rect.moveTo(x, y);
+    }
+
+    return rect;
+}
+
 bool operator==(BufferFormat a, BufferFormat b)
 {
     return a.d == b.d;
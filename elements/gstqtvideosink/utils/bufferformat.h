@@ -48,6 +48,14 @@ public:
 
     int bytesPerLine(int component = 0) const;
 
+    // maps a buffer of this format for reading; the plane offsets and
+    // strides come from the buffer's GstVideoMeta, if it has one
+    bool mapFrame(GstVideoFrame *frame, GstBuffer *buffer) const;
+
+    // the area of a mapped frame that is to be displayed: frameSize() big
+    // and moved to the origin of the buffer's GstVideoCropMeta, if any
+    QRect cropRect(const GstVideoFrame *frame) const;
+
 private:
     friend bool operator==(BufferFormat a, BufferFormat b);
     friend bool operator!=(BufferFormat a, BufferFormat b);
@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "bufferpool.h"
+#include "../gstqtvideosinkplugin.h" //for debug category
+#include <gst/video/video.h>
+
+// the buffers that a sink may hold at the same time: the one being painted,
+// the one waiting in the delegate to be painted and the last sample of basesink
+static const guint MIN_BUFFERS = 3;
+
+gboolean proposeVideoBufferPool(GstElement *sink, GstQuery *query)
+{
+    GstCaps *caps;
+    gboolean needPool;
+    gst_query_parse_allocation(query, &caps, &needPool);
+
+    if (!caps) {
+        GST_DEBUG_OBJECT(sink, "No caps specified in the allocation query");
+        return FALSE;
+    }
+
+    GstVideoInfo info;
+    if (!gst_video_info_from_caps(&info, caps)) {
+        GST_DEBUG_OBJECT(sink, "Invalid caps specified in the allocation query");
+        return FALSE;
+    }
+
+    // 16-byte aligned memory and rows suit both SIMD color conversion and
+    // texture upload. The pool pads the rows of every plane to a multiple of
+    // 16 bytes and describes the resulting layout with a video meta, which
+    // the painters honor, so the metas are advertised as well.
+    GstAllocationParams params;
+    gst_allocation_params_init(&params);
+    params.align = 15;
+
+    GstBufferPool *pool = NULL;
+    guint size = info.size;
+    if (needPool) {
+        pool = gst_video_buffer_pool_new();
+
+        GstVideoAlignment alignment;
+        gst_video_alignment_reset(&alignment);
+        for (guint i = 0; i < GST_VIDEO_MAX_PLANES; ++i) {
+            alignment.stride_align[i] = 15;
+        }
+
+        GstStructure *config = gst_buffer_pool_get_config(pool);
+        gst_buffer_pool_config_set_params(config, caps, info.size, MIN_BUFFERS, 0);
+        gst_buffer_pool_config_set_allocator(config, NULL, &params);
+        gst_buffer_pool_config_add_option(config, GST_BUFFER_POOL_OPTION_VIDEO_META);
+        gst_buffer_pool_config_add_option(config, GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT);
+        gst_buffer_pool_config_set_video_alignment(config, &alignment);
+
+        if (!gst_buffer_pool_set_config(pool, config)) {
+            GST_WARNING_OBJECT(sink, "Failed to configure the proposed buffer pool");
+            gst_object_unref(pool);
+            return FALSE;
+        }
+
+        // the padded rows make the buffers larger than the caps alone say
+        config = gst_buffer_pool_get_config(pool);
+        gst_buffer_pool_config_get_params(config, NULL, &size, NULL, NULL);
+        gst_structure_free(config);
+
+        GST_DEBUG_OBJECT(sink, "Proposing buffer pool %" GST_PTR_FORMAT
+                         " with buffers of %u bytes for caps %" GST_PTR_FORMAT,
+                         pool, size, caps);
+    }
+
+    gst_query_add_allocation_pool(query, pool, size, MIN_BUFFERS, 0);
+    gst_query_add_allocation_param(query, NULL, &params);
+    gst_query_add_allocation_meta(query, GST_VIDEO_META_API_TYPE, NULL);
+    gst_query_add_allocation_meta(query, GST_VIDEO_CROP_META_API_TYPE, NULL);
+    // subtitles and OSD are drawn on top of the frames by the painters,
+    // instead of being blended into them by upstream
+    gst_query_add_allocation_meta(query, GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE, NULL);
+
+    if (pool) {
+        gst_object_unref(pool);
+    }
+
+    return TRUE;
+}
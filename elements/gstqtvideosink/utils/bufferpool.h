@@ -0,0 +1,28 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <gst/gst.h>
+
+/**
+ * Answers an ALLOCATION query on behalf of a video sink by proposing a
+ * GstVideoBufferPool for the caps of the query, so that upstream elements
+ * render into recycled buffers instead of allocating new ones for every frame.
+ */
+gboolean proposeVideoBufferPool(GstElement *sink, GstQuery *query);
+
+#endif
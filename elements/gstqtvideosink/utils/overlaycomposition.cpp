@@ -0,0 +1,139 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "overlaycomposition.h"
+
+OverlayComposition::OverlayComposition()
+    : m_composition(NULL)
+    , m_seqnum(0)
+{
+}
+
+OverlayComposition::~OverlayComposition()
+{
+    clear();
+}
+
+void OverlayComposition::clear()
+{
+    if (m_composition) {
+        gst_video_overlay_composition_unref(m_composition);
+        m_composition = NULL;
+    }
+    m_rectangles.clear();
+}
+
+bool OverlayComposition::update(GstBuffer *buffer)
+{
+    GstVideoOverlayCompositionMeta *meta = buffer ?
+            gst_buffer_get_video_overlay_composition_meta(buffer) : NULL;
+
+    if (!meta) {
+        const bool changed = m_composition != NULL;
+        clear();
+        return changed;
+    }
+
+    // the reference that is kept makes sure that the pointer is not reused
+    // by another composition, and the seqnum changes if this one is modified
+    const guint seqnum = gst_video_overlay_composition_get_seqnum(meta->overlay);
+    if (meta->overlay == m_composition && seqnum == m_seqnum) {
+        return false;
+    }
+
+    QList<Rectangle> rectangles;
+    const guint n = gst_video_overlay_composition_n_rectangles(meta->overlay);
+    for (guint i = 0; i < n; ++i) {
+        GstVideoOverlayRectangle *rectangle =
+                gst_video_overlay_composition_get_rectangle(meta->overlay, i);
+
+        Rectangle r;
+        r.seqnum = gst_video_overlay_rectangle_get_seqnum(rectangle);
+
+        gint x, y;
+        guint width, height;
+        gst_video_overlay_rectangle_get_render_rectangle(rectangle, &x, &y, &width, &height);
+        r.renderRect = QRect(x, y, width, height);
+
+        // rectangles that stay on screen from one composition to the
+        // next keep their seqnum, so they need not be converted again
+        Q_FOREACH(const Rectangle & old, m_rectangles) {
+            if (old.seqnum == r.seqnum) {
+                r.image = old.image;
+                break;
+            }
+        }
+
+        if (r.image.isNull()) {
+            // the pixels are scaled when painting, and the global alpha of
+            // the rectangle is already applied to them by GStreamer
+            GstBuffer *pixels = gst_video_overlay_rectangle_get_pixels_unscaled_argb(
+                    rectangle, GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA);
+            GstVideoMeta *videoMeta = pixels ? gst_buffer_get_video_meta(pixels) : NULL;
+            GstMapInfo info;
+            if (!videoMeta || !gst_buffer_map(pixels, &info, GST_MAP_READ)) {
+                continue;
+            }
+
+            // the native endian ARGB of GStreamer is what QImage expects;
+            // the image is copied so that it outlives the mapping
+            r.image = QImage(info.data + videoMeta->offset[0],
+                             videoMeta->width, videoMeta->height, videoMeta->stride[0],
+                             QImage::Format_ARGB32_Premultiplied).copy();
+            gst_buffer_unmap(pixels, &info);
+        }
+
+        rectangles.append(r);
+    }
+
+    clear();
+    m_composition = gst_video_overlay_composition_ref(meta->overlay);
+    m_seqnum = seqnum;
+    m_rectangles = rectangles;
+    return true;
+}
+
+//static
+bool OverlayComposition::mapRectangle(const QRect & renderRect, const QSize & frameSize,
+        const PaintAreas & areas, QRectF *target, QRectF *source)
+{
+    if (renderRect.isEmpty() || frameSize.isEmpty() || areas.sourceRect.isEmpty()) {
+        return false;
+    }
+
+    // sourceRect is the part of the frame, in normalized coordinates,
+    // that is shown on videoArea
+    const qreal xScale = areas.videoArea.width()
+            / (areas.sourceRect.width() * frameSize.width());
+    const qreal yScale = areas.videoArea.height()
+            / (areas.sourceRect.height() * frameSize.height());
+
+    const QRectF mapped(
+            areas.videoArea.x() + (renderRect.x() - areas.sourceRect.x() * frameSize.width()) * xScale,
+            areas.videoArea.y() + (renderRect.y() - areas.sourceRect.y() * frameSize.height()) * yScale,
+            renderRect.width() * xScale,
+            renderRect.height() * yScale);
+
+    *target = mapped & areas.videoArea;
+    if (target->isEmpty()) {
+        return false;
+    }
+
+    *source = QRectF((target->x() - mapped.x()) / mapped.width(),
+                     (target->y() - mapped.y()) / mapped.height(),
+                     target->width() / mapped.width(),
+                     target->height() / mapped.height());
+    return true;
+}
@@ -0,0 +1,71 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OVERLAYCOMPOSITION_H
+#define OVERLAYCOMPOSITION_H
+
+#include "utils.h"
+#include <gst/video/video.h>
+#include <QList>
+#include <QImage>
+
+/**
+ * Keeps the rectangles of the GstVideoOverlayCompositionMeta of the last
+ * buffer as premultiplied ARGB32 images, so that subtitles and OSD can be
+ * drawn on top of the video instead of being blended into every frame.
+ *
+ * The images of the rectangles are only converted when their sequence
+ * number changes, so the painters may use it as a key to cache whatever
+ * they make out of them, such as textures.
+ */
+class OverlayComposition
+{
+public:
+    struct Rectangle
+    {
+        // see gst_video_overlay_rectangle_get_seqnum()
+        guint seqnum;
+        // where the image is to be rendered, in frame coordinates
+        QRect renderRect;
+        QImage image;
+    };
+
+    OverlayComposition();
+    ~OverlayComposition();
+
+    // takes the composition attached to the buffer, if any;
+    // returns true if the rectangles changed since the last call
+    bool update(GstBuffer *buffer);
+    void clear();
+
+    bool isEmpty() const { return m_rectangles.isEmpty(); }
+    const QList<Rectangle> & rectangles() const { return m_rectangles; }
+
+    /* Maps renderRect from the coordinates of a frame of frameSize to the
+     * painting coordinates of areas, clipped to the video area. source
+     * receives the part of the image that remains, in the normalized (0,1]
+     * range. Returns false if the rectangle is not visible at all. */
+    static bool mapRectangle(const QRect & renderRect, const QSize & frameSize,
+                             const PaintAreas & areas, QRectF *target, QRectF *source);
+
+private:
+    Q_DISABLE_COPY(OverlayComposition)
+
+    GstVideoOverlayComposition *m_composition;
+    guint m_seqnum;
+    QList<Rectangle> m_rectangles;
+};
+
+#endif
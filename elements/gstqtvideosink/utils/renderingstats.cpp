@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "renderingstats.h"
+
+RenderingStats::RenderingStats()
+{
+    reset();
+}
+
+void RenderingStats::reset()
+{
+    QMutexLocker l(&m_lock);
+    m_received = 0;
+    m_rendered = 0;
+    m_dropped = 0;
+    m_paints = 0;
+    m_uploadTimeTotal = 0;
+    m_uploadTimeMax = 0;
+    m_paintTimeTotal = 0;
+    m_paintTimeMax = 0;
+    m_latencyTotal = 0;
+    m_latencyMax = 0;
+    for (int i = 0; i < LatencyBuckets; ++i) {
+        m_latencyHistogram[i] = 0;
+    }
+}
+
+void RenderingStats::frameReceived()
+{
+    QMutexLocker l(&m_lock);
+    m_received++;
+}
+
+void RenderingStats::frameDropped()
+{
+    QMutexLocker l(&m_lock);
+    m_dropped++;
+}
+
+quint64 RenderingStats::droppedFrames() const
+{
+    QMutexLocker l(&m_lock);
+    return m_dropped;
+}
+
+void RenderingStats::framePainted(bool newFrame, qint64 latency,
+                                  qint64 uploadTime, qint64 paintTime)
+{
+    QMutexLocker l(&m_lock);
+
+    m_paints++;
+    m_paintTimeTotal += paintTime;
+    m_paintTimeMax = qMax(m_paintTimeMax, paintTime);
+
+    // repaints of the same frame upload nothing new, so averaging over
+    // them would only make the upload and latency figures look better
+    if (newFrame) {
+        m_rendered++;
+        m_uploadTimeTotal += uploadTime;
+        m_uploadTimeMax = qMax(m_uploadTimeMax, uploadTime);
+        m_latencyTotal += latency;
+        m_latencyMax = qMax(m_latencyMax, latency);
+        m_latencyHistogram[latencyBucket(latency)]++;
+    }
+}
+
+int RenderingStats::latencyBucket(qint64 latency)
+{
+    // bucket i holds latencies below 2^i ms, the last one everything else
+    int i = 0;
+    qint64 limit = 1000;
+    while (i < LatencyBuckets - 1 && latency >= limit) {
+        limit *= 2;
+        i++;
+    }
+    return i;
+}
+
+static void appendUInt64(GValue *array, guint64 value)
+{
+    GValue v = G_VALUE_INIT;
+    g_value_init(&v, G_TYPE_UINT64);
+    g_value_set_uint64(&v, value);
+    gst_value_array_append_value(array, &v);
+    g_value_unset(&v);
+}
+
+GstStructure *RenderingStats::toStructure() const
+{
+    QMutexLocker l(&m_lock);
+
+    const quint64 rendered = qMax<quint64>(m_rendered, 1);
+    const quint64 paints = qMax<quint64>(m_paints, 1);
+
+    GstStructure *s = gst_structure_new("application/x-qt-video-sink-stats",
+            "frames-received", G_TYPE_UINT64, (guint64) m_received,
+            "frames-rendered", G_TYPE_UINT64, (guint64) m_rendered,
+            "frames-dropped", G_TYPE_UINT64, (guint64) m_dropped,
+            "paints", G_TYPE_UINT64, (guint64) m_paints,
+            "upload-time-average", G_TYPE_UINT64,
+                (guint64) (m_uploadTimeTotal / rendered * GST_USECOND),
+            "upload-time-max", G_TYPE_UINT64,
+                (guint64) (m_uploadTimeMax * GST_USECOND),
+            "paint-time-average", G_TYPE_UINT64,
+                (guint64) (m_paintTimeTotal / paints * GST_USECOND),
+            "paint-time-max", G_TYPE_UINT64,
+                (guint64) (m_paintTimeMax * GST_USECOND),
+            "latency-average", G_TYPE_UINT64,
+                (guint64) (m_latencyTotal / rendered * GST_USECOND),
+            "latency-max", G_TYPE_UINT64,
+                (guint64) (m_latencyMax * GST_USECOND),
+            NULL);
+
+    GValue histogram = G_VALUE_INIT;
+    GValue limits = G_VALUE_INIT;
+    g_value_init(&histogram, GST_TYPE_ARRAY);
+    g_value_init(&limits, GST_TYPE_ARRAY);
+
+    GstClockTime limit = GST_MSECOND;
+    for (int i = 0; i < LatencyBuckets; ++i) {
+        appendUInt64(&histogram, m_latencyHistogram[i]);
+        appendUInt64(&limits, i < LatencyBuckets - 1 ? limit : GST_CLOCK_TIME_NONE);
+        limit *= 2;
+    }
+
+    gst_structure_take_value(s, "latency-histogram", &histogram);
+    gst_structure_take_value(s, "latency-histogram-limits", &limits);
+
+    return s;
+}
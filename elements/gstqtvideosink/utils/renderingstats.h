@@ -0,0 +1,75 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef RENDERINGSTATS_H
+#define RENDERINGSTATS_H
+
+#include <gst/gst.h>
+#include <QMutex>
+
+/**
+ * Rendering statistics of a video sink, exposed on its "stats" property.
+ *
+ * Frames are counted as they arrive in show_frame(), as they are dropped
+ * before being painted and as they are painted for the first time. Times
+ * are taken with g_get_monotonic_time() and kept in microseconds; the
+ * latency from show_frame() to the first paint of a frame is also sorted
+ * into a histogram of power-of-two millisecond buckets.
+ *
+ * All the methods are thread safe.
+ */
+class RenderingStats
+{
+public:
+    enum { LatencyBuckets = 10 };
+
+    RenderingStats();
+
+    void reset();
+
+    // called from the streaming thread
+    void frameReceived();
+    void frameDropped();
+
+    // called from the gui thread after every paint; latency is only
+    // taken into account on the first paint of a frame (newFrame == true)
+    void framePainted(bool newFrame, qint64 latency,
+                      qint64 uploadTime, qint64 paintTime);
+
+    quint64 droppedFrames() const;
+
+    // returns a newly allocated structure with the current values
+    GstStructure *toStructure() const;
+
+    static inline qint64 now() { return g_get_monotonic_time(); }
+
+private:
+    static int latencyBucket(qint64 latency);
+
+    mutable QMutex m_lock;
+    quint64 m_received;
+    quint64 m_rendered;
+    quint64 m_dropped;
+    quint64 m_paints;
+    qint64 m_uploadTimeTotal;
+    qint64 m_uploadTimeMax;
+    qint64 m_paintTimeTotal;
+    qint64 m_paintTimeMax;
+    qint64 m_latencyTotal;
+    qint64 m_latencyMax;
+    quint64 m_latencyHistogram[LatencyBuckets];
+};
+
+#endif // RENDERINGSTATS_H
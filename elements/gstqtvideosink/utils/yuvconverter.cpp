@@ -0,0 +1,430 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "yuvconverter.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define YUVCONVERTER_HAVE_SSE2
+# include <emmintrin.h>
+#endif
+
+// the AVX2 kernel is compiled with a target attribute, so that the rest of
+// the plugin does not need to be built for AVX2 capable CPUs only
+#if defined(YUVCONVERTER_HAVE_SSE2) && (defined(__x86_64__) || defined(__i386__)) \
+    && ((defined(__clang__) && (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ >= 8))) \
+        || (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+# define YUVCONVERTER_HAVE_AVX2
+# include <immintrin.h>
+#endif
+
+// 1.164 * 64, 1.596 * 64, 0.392 * 64, 0.813 * 64, 2.017 * 64
+static const YuvConverter::Coefficients BT601_COEFFICIENTS = { 75, 102, 25, 52, 129 };
+// 1.164 * 64, 1.793 * 64, 0.213 * 64, 0.533 * 64, 2.112 * 64
+static const YuvConverter::Coefficients BT709_COEFFICIENTS = { 75, 115, 14, 34, 135 };
+
+typedef void (*RowKernel)(const quint8 *y, const quint8 *u, const quint8 *v,
+                          quint32 *dst, int width, const YuvConverter::Coefficients & c);
+
+//BEGIN row kernels
+
+static inline int clampToByte(int value)
+{
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+// u and v are horizontally subsampled by two in every supported format
+static void convertRowC(const quint8 *y, const quint8 *u, const quint8 *v,
+                        quint32 *dst, int width, const YuvConverter::Coefficients & c)
+{
+    for (int x = 0; x < width; ++x) {
+        const int luma = (y[x] - 16) * c.y + 32;
+        const int cb = u[x / 2] - 128;
+        const int cr = v[x / 2] - 128;
+
+        dst[x] = qRgb(clampToByte((luma + c.rv * cr) >> 6),
+                      clampToByte((luma - c.gu * cb - c.gv * cr) >> 6),
+                      clampToByte((luma + c.bu * cb) >> 6));
+    }
+}
+
+#ifdef YUVCONVERTER_HAVE_SSE2
+
+// Interleaves 8 pixels worth of 16-bit r, g, b values into B, G, R, A bytes,
+// which is what QImage::Format_RGB32 looks like in memory on x86
+static inline void storeRgb32(__m128i r, __m128i g, __m128i b, quint32 *dst)
+{
+    const __m128i alpha = _mm_set1_epi8(char(0xff));
+    const __m128i r8 = _mm_packus_epi16(r, r);
+    const __m128i g8 = _mm_packus_epi16(g, g);
+    const __m128i b8 = _mm_packus_epi16(b, b);
+
+    const __m128i bg = _mm_unpacklo_epi8(b8, g8);
+    const __m128i ra = _mm_unpacklo_epi8(r8, alpha);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 4), _mm_unpackhi_epi16(bg, ra));
+}
+
+// The products fit in 16 bits and the sums saturate, which only ever happens
+// for values that are clamped to 0 or 255 anyway, so the results are
+// identical to those of convertRowC().
+static void convertRowSse2(const quint8 *y, const quint8 *u, const quint8 *v,
+                           quint32 *dst, int width, const YuvConverter::Coefficients & c)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lumaOffset = _mm_set1_epi16(16);
+    const __m128i chromaOffset = _mm_set1_epi16(128);
+    const __m128i rounding = _mm_set1_epi16(32);
+    const __m128i yCoeff = _mm_set1_epi16(c.y);
+    const __m128i rvCoeff = _mm_set1_epi16(c.rv);
+    const __m128i guCoeff = _mm_set1_epi16(c.gu);
+    const __m128i gvCoeff = _mm_set1_epi16(c.gv);
+    const __m128i buCoeff = _mm_set1_epi16(c.bu);
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        int chroma;
+
+        __m128i luma = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x));
+        luma = _mm_sub_epi16(_mm_unpacklo_epi8(luma, zero), lumaOffset);
+        luma = _mm_add_epi16(_mm_mullo_epi16(luma, yCoeff), rounding);
+
+        memcpy(&chroma, u + x / 2, sizeof(chroma));
+        __m128i cb = _mm_unpacklo_epi8(_mm_cvtsi32_si128(chroma), zero);
+        cb = _mm_sub_epi16(cb, chromaOffset);
+        cb = _mm_unpacklo_epi16(cb, cb);
+
+        memcpy(&chroma, v + x / 2, sizeof(chroma));
+        __m128i cr = _mm_unpacklo_epi8(_mm_cvtsi32_si128(chroma), zero);
+        cr = _mm_sub_epi16(cr, chromaOffset);
+        cr = _mm_unpacklo_epi16(cr, cr);
+
+        const __m128i r = _mm_adds_epi16(luma, _mm_mullo_epi16(cr, rvCoeff));
+        const __m128i g = _mm_subs_epi16(_mm_subs_epi16(luma, _mm_mullo_epi16(cb, guCoeff)),
+                                         _mm_mullo_epi16(cr, gvCoeff));
+        const __m128i b = _mm_adds_epi16(luma, _mm_mullo_epi16(cb, buCoeff));
+
+        storeRgb32(_mm_srai_epi16(r, 6), _mm_srai_epi16(g, 6), _mm_srai_epi16(b, 6), dst + x);
+    }
+
+    convertRowC(y + x, u + x / 2, v + x / 2, dst + x, width - x, c);
+}
+
+#endif // YUVCONVERTER_HAVE_SSE2
+
+#ifdef YUVCONVERTER_HAVE_AVX2
+
+__attribute__((target("avx2")))
+static void convertRowAvx2(const quint8 *y, const quint8 *u, const quint8 *v,
+                           quint32 *dst, int width, const YuvConverter::Coefficients & c)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m256i alpha = _mm256_set1_epi8(char(0xff));
+    const __m256i lumaOffset = _mm256_set1_epi16(16);
+    const __m128i chromaOffset = _mm_set1_epi16(128);
+    const __m256i rounding = _mm256_set1_epi16(32);
+    const __m256i yCoeff = _mm256_set1_epi16(c.y);
+    const __m256i rvCoeff = _mm256_set1_epi16(c.rv);
+    const __m256i guCoeff = _mm256_set1_epi16(c.gu);
+    const __m256i gvCoeff = _mm256_set1_epi16(c.gv);
+    const __m256i buCoeff = _mm256_set1_epi16(c.bu);
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m256i luma = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x)));
+        luma = _mm256_sub_epi16(luma, lumaOffset);
+        luma = _mm256_add_epi16(_mm256_mullo_epi16(luma, yCoeff), rounding);
+
+        // widen 8 chroma samples and duplicate each of them for two pixels
+        __m128i cb8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x / 2));
+        cb8 = _mm_sub_epi16(_mm_unpacklo_epi8(cb8, zero), chromaOffset);
+        const __m256i cb = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_unpacklo_epi16(cb8, cb8)),
+                _mm_unpackhi_epi16(cb8, cb8), 1);
+
+        __m128i cr8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x / 2));
+        cr8 = _mm_sub_epi16(_mm_unpacklo_epi8(cr8, zero), chromaOffset);
+        const __m256i cr = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_unpacklo_epi16(cr8, cr8)),
+                _mm_unpackhi_epi16(cr8, cr8), 1);
+
+        __m256i r = _mm256_adds_epi16(luma, _mm256_mullo_epi16(cr, rvCoeff));
+        __m256i g = _mm256_subs_epi16(_mm256_subs_epi16(luma, _mm256_mullo_epi16(cb, guCoeff)),
+                                      _mm256_mullo_epi16(cr, gvCoeff));
+        __m256i b = _mm256_adds_epi16(luma, _mm256_mullo_epi16(cb, buCoeff));
+
+        r = _mm256_srai_epi16(r, 6);
+        g = _mm256_srai_epi16(g, 6);
+        b = _mm256_srai_epi16(b, 6);
+
+        // packing and unpacking work within 128-bit lanes, so the low lane
+        // ends up with pixels 0-7 and the high lane with pixels 8-15
+        const __m256i r8 = _mm256_packus_epi16(r, r);
+        const __m256i g8 = _mm256_packus_epi16(g, g);
+        const __m256i b8 = _mm256_packus_epi16(b, b);
+        const __m256i bg = _mm256_unpacklo_epi8(b8, g8);
+        const __m256i ra = _mm256_unpacklo_epi8(r8, alpha);
+        const __m256i lo = _mm256_unpacklo_epi16(bg, ra); // pixels 0-3, 8-11
+        const __m256i hi = _mm256_unpackhi_epi16(bg, ra); // pixels 4-7, 12-15
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    convertRowSse2(y + x, u + x / 2, v + x / 2, dst + x, width - x, c);
+}
+
+#endif // YUVCONVERTER_HAVE_AVX2
+
+static bool cpuSupportsAvx2()
+{
+#ifdef YUVCONVERTER_HAVE_AVX2
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// all the compiled kernels, the preferred one last
+static const struct { const char *name; RowKernel kernel; } s_rowKernels[] = {
+    { "c", convertRowC },
+#ifdef YUVCONVERTER_HAVE_SSE2
+    { "sse2", convertRowSse2 },
+#endif
+#ifdef YUVCONVERTER_HAVE_AVX2
+    { "avx2", convertRowAvx2 },
+#endif
+};
+
+static RowKernel findRowKernel(const char *name)
+{
+    if (qstrcmp(name, "avx2") == 0 && !cpuSupportsAvx2()) {
+        return NULL;
+    }
+
+    for (uint i = 0; i < G_N_ELEMENTS(s_rowKernels); ++i) {
+        if (qstrcmp(name, s_rowKernels[i].name) == 0) {
+            return s_rowKernels[i].kernel;
+        }
+    }
+    return NULL;
+}
+
+static RowKernel selectRowKernel(const char **name)
+{
+    for (int i = G_N_ELEMENTS(s_rowKernels) - 1; i >= 0; --i) {
+        if (findRowKernel(s_rowKernels[i].name)) {
+            *name = s_rowKernels[i].name;
+            return s_rowKernels[i].kernel;
+        }
+    }
+    *name = "c";
+    return convertRowC;
+}
+
+static const char *s_rowKernelName = NULL;
+static RowKernel s_rowKernel = selectRowKernel(&s_rowKernelName);
+
+//END row kernels
+
+//BEGIN deinterleaving
+
+// Splits pairs of bytes into two rows, the first byte of each pair into
+// @a even and the second into @a odd
+static void splitPairs(const quint8 *src, quint8 *even, quint8 *odd, int pairs)
+{
+    int i = 0;
+
+#ifdef YUVCONVERTER_HAVE_SSE2
+    const __m128i mask = _mm_set1_epi16(0x00ff);
+    for (; i + 16 <= pairs; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * i + 16));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(even + i),
+                         _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(odd + i),
+                         _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    }
+#endif
+
+    for (; i < pairs; ++i) {
+        even[i] = src[2 * i];
+        odd[i] = src[2 * i + 1];
+    }
+}
+
+//END deinterleaving
+
+YuvConverter::YuvConverter()
+    : m_layout(Planar)
+    , m_coefficients(BT601_COEFFICIENTS)
+{
+    gst_video_info_init(&m_videoInfo);
+}
+
+//static
+QSet<GstVideoFormat> YuvConverter::supportedPixelFormats()
+{
+    return QSet<GstVideoFormat>()
+        << GST_VIDEO_FORMAT_I420
+        << GST_VIDEO_FORMAT_YV12
+        << GST_VIDEO_FORMAT_NV12
+        << GST_VIDEO_FORMAT_NV21
+        << GST_VIDEO_FORMAT_YUY2
+        << GST_VIDEO_FORMAT_UYVY
+        ;
+}
+
+//static
+const char *YuvConverter::kernelName()
+{
+    return s_rowKernelName;
+}
+
+//static
+QList<QByteArray> YuvConverter::availableKernels()
+{
+    QList<QByteArray> kernels;
+    for (uint i = 0; i < G_N_ELEMENTS(s_rowKernels); ++i) {
+        if (findRowKernel(s_rowKernels[i].name)) {
+            kernels.append(s_rowKernels[i].name);
+        }
+    }
+    return kernels;
+}
+
+//static
+bool YuvConverter::convertRow(const QByteArray & kernel, const quint8 *y, const quint8 *u,
+                              const quint8 *v, quint32 *dst, int width,
+                              const Coefficients & coefficients)
+{
+    RowKernel rowKernel = findRowKernel(kernel.constData());
+    if (!rowKernel) {
+        return false;
+    }
+    rowKernel(y, u, v, dst, width, coefficients);
+    return true;
+}
+
+void YuvConverter::init(const BufferFormat & format)
+{
+    m_videoInfo = format.videoInfo();
+
+    switch (format.videoFormat()) {
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_YV12:
+        m_layout = Planar;
+        break;
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV21:
+        m_layout = SemiPlanar;
+        break;
+    case GST_VIDEO_FORMAT_YUY2:
+    case GST_VIDEO_FORMAT_UYVY:
+        m_layout = Packed;
+        break;
+    default:
+        throw QString("Unsupported format");
+    }
+
+    m_coefficients = format.colorMatrix() == GST_VIDEO_COLOR_MATRIX_BT709 ?
+            BT709_COEFFICIENTS : BT601_COEFFICIENTS;
+
+    // rows for the deinterleaved luma, chroma pairs, u and v, with some
+    // slack so that kernels never read past the end of them
+    const int width = GST_ROUND_UP_2(GST_VIDEO_INFO_WIDTH(&m_videoInfo));
+    m_scratch.resize(4 * (width + 32));
+}
+
+// returns the address of pixel (x, y) of a component, x and y being
+// in luma samples and already aligned to the chroma subsampling
+static inline const quint8 *componentPixel(const GstVideoFrame *frame,
+                                           int component, int x, int y)
+{
+    const GstVideoFormatInfo *finfo = frame->info.finfo;
+    return static_cast<const quint8 *>(GST_VIDEO_FRAME_COMP_DATA(frame, component))
+            + (y >> GST_VIDEO_FORMAT_INFO_H_SUB(finfo, component))
+                * GST_VIDEO_FRAME_COMP_STRIDE(frame, component)
+            + (x >> GST_VIDEO_FORMAT_INFO_W_SUB(finfo, component))
+                * GST_VIDEO_FRAME_COMP_PSTRIDE(frame, component);
+}
+
+void YuvConverter::convert(const GstVideoFrame *frame, const QPoint & origin, QImage & image)
+{
+    const int width = GST_VIDEO_INFO_WIDTH(&m_videoInfo);
+    const int height = GST_VIDEO_INFO_HEIGHT(&m_videoInfo);
+    const int pairs = GST_ROUND_UP_2(width);
+    const int chromaWidth = pairs / 2;
+
+    if (image.width() != width || image.height() != height
+            || image.format() != QImage::Format_RGB32) {
+        image = QImage(width, height, QImage::Format_RGB32);
+    }
+
+    const int stride = width + 32;
+    quint8 *lumaRow = reinterpret_cast<quint8 *>(m_scratch.data());
+    quint8 *chromaRow = lumaRow + stride;
+    quint8 *uRow = chromaRow + stride;
+    quint8 *vRow = uRow + stride;
+
+    const GstVideoFormatInfo *finfo = frame->info.finfo;
+
+    // the strides come from the frame, as they may differ from the caps
+    const int yStride = GST_VIDEO_FRAME_COMP_STRIDE(frame, 0);
+    const int uStride = GST_VIDEO_FRAME_COMP_STRIDE(frame, 1);
+    const int vStride = GST_VIDEO_FRAME_COMP_STRIDE(frame, 2);
+    const quint8 *yOrigin = componentPixel(frame, 0, origin.x(), origin.y());
+    const quint8 *uOrigin = componentPixel(frame, 1, origin.x(), origin.y());
+    const quint8 *vOrigin = componentPixel(frame, 2, origin.x(), origin.y());
+    const bool uFirst = uOrigin < vOrigin;
+
+    for (int line = 0; line < height; ++line) {
+        const int chromaLine = line >> GST_VIDEO_FORMAT_INFO_H_SUB(finfo, 1);
+
+        const quint8 *y = yOrigin + line * yStride;
+        const quint8 *u = uOrigin + chromaLine * uStride;
+        const quint8 *v = vOrigin + chromaLine * vStride;
+
+        switch (m_layout) {
+        case Planar:
+            break;
+        case SemiPlanar:
+            splitPairs(uFirst ? u : v, uFirst ? uRow : vRow, uFirst ? vRow : uRow, chromaWidth);
+            u = uRow;
+            v = vRow;
+            break;
+        case Packed:
+            // YUY2 has the luma in the first byte of each pixel, UYVY in the second
+            if (GST_VIDEO_FORMAT_INFO_POFFSET(finfo, 0) == 0) {
+                splitPairs(y, lumaRow, chromaRow, pairs);
+            } else {
+                splitPairs(qMin(u, v), chromaRow, lumaRow, pairs);
+            }
+            splitPairs(chromaRow, uFirst ? uRow : vRow, uFirst ? vRow : uRow, chromaWidth);
+            y = lumaRow;
+            u = uRow;
+            v = vRow;
+            break;
+        }
+
+        s_rowKernel(y, u, v, reinterpret_cast<quint32 *>(image.scanLine(line)), width, m_coefficients);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License version 2.1
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef YUVCONVERTER_H
+#define YUVCONVERTER_H
+
+#include "bufferformat.h"
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QSet>
+
+/**
+ * Converts YUV frames to RGB32 images on the CPU, for painting without GL.
+ * The rows are converted by AVX2 or SSE2 kernels when the CPU has them,
+ * with a plain C fallback, selected once at runtime.
+ */
+class YuvConverter
+{
+public:
+    /** Fixed point YUV -> RGB coefficients, with 6 fractional bits */
+    struct Coefficients
+    {
+        qint16 y;
+        qint16 rv;
+        qint16 gu;
+        qint16 gv;
+        qint16 bu;
+    };
+
+    YuvConverter();
+
+    static QSet<GstVideoFormat> supportedPixelFormats();
+
+    /** The name of the row kernel in use: "avx2", "sse2" or "c" */
+    static const char *kernelName();
+
+    /** The names of all the row kernels that can run on this CPU */
+    static QList<QByteArray> availableKernels();
+
+    /** Converts @a width pixels of a row with the kernel called @a kernel,
+     * so that the kernels can be compared with each other. @a u and @a v
+     * hold one sample per two pixels. Returns false if there is no such
+     * kernel or if it cannot run on this CPU. */
+    static bool convertRow(const QByteArray & kernel, const quint8 *y, const quint8 *u,
+                           const quint8 *v, quint32 *dst, int width,
+                           const Coefficients & coefficients);
+
+    void init(const BufferFormat & format);
+
+    /** Converts the area of the mapped @a frame that starts at @a origin
+     * and has the size given to init() into @a image, reallocating the
+     * image only if its size is wrong. The frame must be in the format
+     * given to init(), but its strides and size may differ. */
+    void convert(const GstVideoFrame *frame, const QPoint & origin, QImage & image);
+
+private:
+    enum Layout { Planar, SemiPlanar, Packed };
+
+    GstVideoInfo m_videoInfo;
+    Layout m_layout;
+    Coefficients m_coefficients;
+    QByteArray m_scratch;
+};
+
+#endif // YUVCONVERTER_H
@@ -17,9 +17,16 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "connect.h"
+#include "value_p.h"
 #include <glib-object.h>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
 #include <QtCore/QHash>
 #include <QtCore/QMutex>
+#include <QtCore/QPointer>
+#include <QtCore/QQueue>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
 #include <boost/multi_index_container.hpp>
 #ifndef Q_MOC_RUN  // See: https://bugreports.qt-project.org/browse/QTBUG-22829
 #include <boost/multi_index/sequenced_index.hpp>
@@ -39,20 +46,18 @@ static void c_marshaller(GClosure *closure, GValue *returnValue, uint paramValue
 
     ClosureDataBase *cdata = static_cast<ClosureDataBase*>(closure->data);
 
-    QList<Value> params;
     //the signal sender is always the first argument. if we are instructed not to pass it
     //as an argument to the slot, begin converting from paramValues[1]
-    for(uint i = cdata->passSender ? 0 : 1; i<paramValuesCount; ++i) {
-        params.append(Value(&paramValues[i]));
-    }
+    const uint firstParam = (cdata->passSender || paramValuesCount == 0) ? 0 : 1;
 
-    try {
-        Value result(returnValue);
-        cdata->marshaller(result, params);
+    //the arguments are handed to the slot without copying them or allocating memory
+    BorrowedValues params(paramValues + firstParam, paramValuesCount - firstParam);
 
-        if (returnValue && G_IS_VALUE(returnValue)) {
-            g_value_copy(result, returnValue);
-        }
+    try {
+        //the closure sets its result directly on returnValue
+        GValue noResult = {0, {{0}, {0}}};
+        BorrowedValues result(returnValue ? returnValue : &noResult, 1, BorrowedValues::ReadWrite);
+        cdata->marshaller(result[0], params.constData(), params.size());
     } catch (const std::exception & e) {
         QString signalName;
         if (hint != NULL) {
@@ -69,7 +74,7 @@ static void c_marshaller(GClosure *closure, GValue *returnValue, uint paramValue
             }
         }
 
-        QString instanceName = params.at(0).get<QString>();
+        QString instanceName = params.size() > 0 ? params[0].get<QString>() : QString();
 
         //attempt to determine the cause of the failure
         QString msg;
@@ -119,6 +124,167 @@ static inline GClosure *createCppClosure(ClosureDataBase *closureData)
 }
 
 //END ******** Closure internals ********
+//BEGIN ******** QueuedClosureData ********
+
+/* Lives in the thread of the receiver and invokes the closure from its event loop
+ * with the arguments that QueuedClosureData has queued from the emitting thread.
+ * Only one invocation event is posted at a time; it drains all the pending invocations.
+ */
+class QueuedInvoker : public QObject
+{
+public:
+    QueuedInvoker(ClosureDataBase *closureData, QObject *receiver, bool coalesce);
+    virtual ~QueuedInvoker();
+
+    void post(const Value *params, uint count);
+    void detach();
+
+protected:
+    virtual bool event(QEvent *event);
+
+private:
+    enum { InvokeEventType = QEvent::User };
+
+    inline void postInvokeEvent()
+    {
+        QCoreApplication::postEvent(this, new QEvent(static_cast<QEvent::Type>(InvokeEventType)));
+    }
+
+    ClosureDataBase *m_closureData;
+    QPointer<QObject> m_receiver;
+    bool m_coalesce;
+
+    QMutex m_mutex;
+    QQueue< QVector<Value> > m_pending;
+    bool m_eventPosted;
+    bool m_detached;
+};
+
+QueuedInvoker::QueuedInvoker(ClosureDataBase *closureData, QObject *receiver, bool coalesce)
+    : QObject(),
+      m_closureData(closureData),
+      m_receiver(receiver),
+      m_coalesce(coalesce),
+      m_eventPosted(false),
+      m_detached(false)
+{
+    moveToThread(receiver->thread());
+}
+
+QueuedInvoker::~QueuedInvoker()
+{
+    delete m_closureData;
+}
+
+void QueuedInvoker::post(const Value *params, uint count)
+{
+    //the params are only valid during the emission, so keep copies of them
+    QVector<Value> args;
+    args.reserve(count);
+    for (uint i = 0; i < count; ++i) {
+        args.append(params[i]);
+    }
+
+    //declared after args, so that the replaced arguments are released after unlocking
+    QMutexLocker l(&m_mutex);
+    if (m_detached) {
+        return;
+    }
+
+    if (m_coalesce && !m_pending.isEmpty()) {
+        qSwap(m_pending.last(), args);
+    } else {
+        m_pending.enqueue(args);
+    }
+
+    if (!m_eventPosted) {
+        m_eventPosted = true;
+        postInvokeEvent();
+    }
+}
+
+void QueuedInvoker::detach()
+{
+    QQueue< QVector<Value> > pending;
+    QMutexLocker l(&m_mutex);
+    m_detached = true;
+    qSwap(pending, m_pending);
+}
+
+bool QueuedInvoker::event(QEvent *event)
+{
+    if (event->type() != static_cast<QEvent::Type>(InvokeEventType)) {
+        return QObject::event(event);
+    }
+
+    QObject *receiver = m_receiver.data();
+    if (receiver && receiver->thread() != thread()) {
+        //the receiver has been moved to another thread since the connection was made
+        moveToThread(receiver->thread());
+        postInvokeEvent();
+        return true;
+    }
+
+    QQueue< QVector<Value> > pending;
+    {
+        QMutexLocker l(&m_mutex);
+        m_eventPosted = false;
+        qSwap(pending, m_pending);
+    }
+
+    while (!pending.isEmpty()) {
+        QVector<Value> args = pending.dequeue();
+
+        //the slot may have disconnected or destroyed the receiver
+        {
+            QMutexLocker l(&m_mutex);
+            if (m_detached || m_receiver.isNull()) {
+                break;
+            }
+        }
+
+        try {
+            Value result;
+            m_closureData->marshaller(result, args.constData(), args.size());
+        } catch (const std::exception & e) {
+            qCritical() << "Error during queued invocation of closure:" << e.what();
+        }
+    }
+
+    return true;
+}
+
+
+class QueuedClosureData : public ClosureDataBase
+{
+public:
+    inline QueuedClosureData(ClosureDataBase *closureData, QObject *receiver, bool coalesce)
+        : ClosureDataBase(closureData->passSender),
+          m_invoker(new QueuedInvoker(closureData, receiver, coalesce)) {}
+
+    virtual ~QueuedClosureData()
+    {
+        //invocations may still be pending in the thread of the receiver
+        m_invoker->detach();
+        m_invoker->deleteLater();
+    }
+
+    virtual void marshaller(Value &, const Value *params, uint count)
+    {
+        m_invoker->post(params, count);
+    }
+
+private:
+    QueuedInvoker *m_invoker;
+};
+
+ClosureDataBase *createQueuedClosureData(ClosureDataBase *closureData,
+                                         QObject *receiver, ConnectFlags flags)
+{
+    return new QueuedClosureData(closureData, receiver, flags & ConnectCoalesced);
+}
+
+//END ******** QueuedClosureData ********
 //BEGIN ******** QObjectDestroyNotifier ********
 
 Q_GLOBAL_STATIC(QWeakPointer<DestroyNotifierIface>, s_qobjDestroyNotifier)
@@ -152,11 +318,18 @@ bool QObjectDestroyNotifier::disconnect(void* receiver, QObject *notificationRec
 //END ******** QObjectDestroyNotifier ********
 //BEGIN ******** ConnectionsStore ********
 
+/* The connections are partitioned by sender instance and the receiver watches by
+ * receiver, in independently locked shards, so that threads connecting to and
+ * disconnecting from different objects do not contend on a single lock and the
+ * cost of each operation only depends on the connections of the objects involved.
+ * When both kinds of shards need to be locked, the instance shard is always
+ * locked first.
+ */
 class ConnectionsStore : public QObject
 {
     Q_OBJECT
 public:
-    inline ConnectionsStore() : QObject(), m_handlerIdInRemoval(0) {}
+    inline ConnectionsStore() : QObject() {}
 
     ulong connect(void *instance, uint signal, Quark detail,
                   void *receiver, const DestroyNotifierIfacePtr & notifier,
@@ -169,12 +342,15 @@ private:
     struct Connection
     {
         inline Connection(uint signal, Quark detail, void *receiver,
-                          uint slotHash, ulong handlerId)
+                          uint slotHash, ulong handlerId,
+                          GClosure *closure, void *closureWatchData)
             : signal(signal),
               detail(detail),
               receiver(receiver),
               slotHash(slotHash),
-              handlerId(handlerId)
+              handlerId(handlerId),
+              closure(closure),
+              closureWatchData(closureWatchData)
         {
         }
 
@@ -183,6 +359,8 @@ private:
         void *receiver;
         uint slotHash;
         ulong handlerId;
+        GClosure *closure; //owned by the signal handler
+        void *closureWatchData;
     };
 
     bool lookupAndExec(void *instance, uint signal, Quark detail, void *receiver, uint slotHash,
@@ -191,7 +369,7 @@ private:
     void disconnectHandler(void *instance, const Connection & c);
     void disconnectAndDestroyRcvrWatch(void *instance, const Connection & c);
 
-    void setupClosureWatch(void *instance, ulong handlerId, GClosure *closure);
+    void *setupClosureWatch(void *instance, ulong handlerId, GClosure *closure);
     void onClosureDestroyedAction(void *instance, ulong handlerId);
     static void onClosureDestroyed(void *data, GClosure *closure);
 
@@ -243,12 +421,38 @@ private:
         QHash<void*, int> senders; //<sender, refcount>
     };
 
-    QMutex m_mutex;
-    QHash<void*, ConnectionsContainer> m_connections; // <sender, connections>
-    QHash<void*, ReceiverData> m_receivers; // <receiver, data>
+    enum { ShardCount = 32 };
 
-    QMutex m_handlerIdInRemovalMutex;
-    ulong m_handlerIdInRemoval;
+    struct InstanceShard
+    {
+        QMutex mutex;
+        QHash<void*, ConnectionsContainer> connections; // <sender, connections>
+    };
+
+    struct ReceiverShard
+    {
+        QMutex mutex;
+        QHash<void*, ReceiverData> receivers; // <receiver, data>
+    };
+
+    static inline uint shardIndex(void *ptr)
+    {
+        quintptr key = reinterpret_cast<quintptr>(ptr);
+        return ((key >> 4) ^ (key >> 10)) % ShardCount;
+    }
+
+    inline InstanceShard & instanceShard(void *instance)
+    {
+        return m_instanceShards[shardIndex(instance)];
+    }
+
+    inline ReceiverShard & receiverShard(void *receiver)
+    {
+        return m_receiverShards[shardIndex(receiver)];
+    }
+
+    InstanceShard m_instanceShards[ShardCount];
+    ReceiverShard m_receiverShards[ShardCount];
 };
 
 Q_GLOBAL_STATIC(ConnectionsStore, s_connectionsStore)
@@ -257,18 +461,20 @@ ulong ConnectionsStore::connect(void *instance, uint signal, Quark detail,
                                 void *receiver, const DestroyNotifierIfacePtr & notifier,
                                 uint slotHash, ClosureDataBase *closureData, ConnectFlags flags)
 {
-    QMutexLocker l(&m_mutex);
+    InstanceShard & shard = instanceShard(instance);
+    QMutexLocker l(&shard.mutex);
     GClosure *closure = createCppClosure(closureData);
 
     ulong handlerId = g_signal_connect_closure_by_id(instance, signal, detail, closure,
                                                      (flags & ConnectAfter) ? TRUE : FALSE);
 
     if (handlerId) {
-        m_connections[instance].get<sequential>().push_back(
-            Connection(signal, detail, receiver, slotHash, handlerId)
+        void *closureWatchData = setupClosureWatch(instance, handlerId, closure);
+
+        shard.connections[instance].get<sequential>().push_back(
+            Connection(signal, detail, receiver, slotHash, handlerId, closure, closureWatchData)
         );
 
-        setupClosureWatch(instance, handlerId, closure);
         setupReceiverWatch(instance, receiver, notifier);
     }
 
@@ -279,19 +485,22 @@ ulong ConnectionsStore::connect(void *instance, uint signal, Quark detail,
 bool ConnectionsStore::disconnect(void *instance, uint signal, Quark detail,
                                   void *receiver, uint slotHash, ulong handlerId)
 {
-    QMutexLocker l(&m_mutex);
+    QMutexLocker l(&instanceShard(instance).mutex);
     return lookupAndExec(instance, signal, detail, receiver, slotHash, handlerId,
                          &ConnectionsStore::disconnectAndDestroyRcvrWatch);
 }
 
+//must be called with the shard of the instance locked
 bool ConnectionsStore::lookupAndExec(void *instance, uint signal, Quark detail,
                                      void *receiver, uint slotHash, ulong handlerId,
                                      void (ConnectionsStore::*func)(void*, const Connection &))
 {
     bool executed = false;
+    QHash<void*, ConnectionsContainer> & connections = instanceShard(instance).connections;
+    QHash<void*, ConnectionsContainer>::iterator containerIt = connections.find(instance);
 
-    if (m_connections.contains(instance)) {
-        ConnectionsContainer & container = m_connections[instance];
+    if (containerIt != connections.end()) {
+        ConnectionsContainer & container = containerIt.value();
 
         if (handlerId) {
             ByHandlerIterator it = container.get<by_handlerId>().find(handlerId);
@@ -348,7 +557,7 @@ bool ConnectionsStore::lookupAndExec(void *instance, uint signal, Quark detail,
         }
 
         if (container.get<sequential>().empty()) {
-            m_connections.remove(instance);
+            connections.erase(containerIt);
         }
     }
 
@@ -357,16 +566,13 @@ bool ConnectionsStore::lookupAndExec(void *instance, uint signal, Quark detail,
 
 void ConnectionsStore::disconnectHandler(void *instance, const Connection & c)
 {
-    m_handlerIdInRemovalMutex.lock();
-    m_handlerIdInRemoval = c.handlerId;
-    m_handlerIdInRemovalMutex.unlock();
+    /* We are removing the connection ourselves, so there is no need to be notified
+     * when disconnecting the handler destroys the closure. */
+    g_closure_remove_finalize_notifier(c.closure, c.closureWatchData,
+                                       &ConnectionsStore::onClosureDestroyed);
+    delete static_cast< QPair<void*, ulong>* >(c.closureWatchData);
 
-    /* This will unref the closure and cause onClosureDestroyed to be invoked. */
     g_signal_handler_disconnect(instance, c.handlerId);
-
-    m_handlerIdInRemovalMutex.lock();
-    m_handlerIdInRemoval = 0;
-    m_handlerIdInRemovalMutex.unlock();
 }
 
 void ConnectionsStore::disconnectAndDestroyRcvrWatch(void *instance, const Connection & c)
@@ -375,10 +581,11 @@ void ConnectionsStore::disconnectAndDestroyRcvrWatch(void *instance, const Conne
     destroyReceiverWatch(instance, c);
 }
 
-void ConnectionsStore::setupClosureWatch(void *instance, ulong handlerId, GClosure *closure)
+void *ConnectionsStore::setupClosureWatch(void *instance, ulong handlerId, GClosure *closure)
 {
     void *data = new QPair<void*, ulong>(instance, handlerId);
     g_closure_add_finalize_notifier(closure, data, &ConnectionsStore::onClosureDestroyed);
+    return data;
 }
 
 //static
@@ -392,52 +599,70 @@ void ConnectionsStore::onClosureDestroyed(void *data, GClosure *closure)
 
 void ConnectionsStore::onClosureDestroyedAction(void *instance, ulong handlerId)
 {
-    /* Do not do any action if we are being invoked from disconnectHandler() */
-    m_handlerIdInRemovalMutex.lock();
-    register bool ok = (m_handlerIdInRemoval != handlerId);
-    m_handlerIdInRemovalMutex.unlock();
-
-    if (ok) {
-        QMutexLocker l(&m_mutex);
-        lookupAndExec(instance, 0, Quark(), 0, 0, handlerId, &ConnectionsStore::destroyReceiverWatch);
-    }
+    QMutexLocker l(&instanceShard(instance).mutex);
+    lookupAndExec(instance, 0, Quark(), 0, 0, handlerId, &ConnectionsStore::destroyReceiverWatch);
 }
 
 void ConnectionsStore::setupReceiverWatch(void *instance, void *receiver,
                                           const DestroyNotifierIfacePtr & notifier)
 {
-    if (!m_receivers.contains(receiver)) {
+    ReceiverShard & shard = receiverShard(receiver);
+    QMutexLocker l(&shard.mutex);
+
+    QHash<void*, ReceiverData>::iterator it = shard.receivers.find(receiver);
+    if (it == shard.receivers.end()) {
         ReceiverData data;
         data.notifier = notifier;
         if (!notifier->connect(receiver, this, SLOT(onReceiverDestroyed(QObject*)))) {
             notifier->connect(receiver, this, SLOT(onReceiverDestroyed(void*)));
         }
-        m_receivers.insert(receiver, data);
+        it = shard.receivers.insert(receiver, data);
     }
 
-    m_receivers[receiver].senders[instance]++;
+    it.value().senders[instance]++;
 }
 
 void ConnectionsStore::destroyReceiverWatch(void *instance, const Connection & c)
 {
-    if (--m_receivers[c.receiver].senders[instance] == 0) {
-        m_receivers[c.receiver].senders.remove(instance);
-        if (m_receivers[c.receiver].senders.isEmpty()) {
-            m_receivers[c.receiver].notifier->disconnect(c.receiver, this);
-            m_receivers.remove(c.receiver);
+    ReceiverShard & shard = receiverShard(c.receiver);
+    QMutexLocker l(&shard.mutex);
+
+    //the receiver may be in the process of being destroyed, see onReceiverDestroyed()
+    QHash<void*, ReceiverData>::iterator it = shard.receivers.find(c.receiver);
+    if (it == shard.receivers.end()) {
+        return;
+    }
+
+    ReceiverData & data = it.value();
+    if (--data.senders[instance] == 0) {
+        data.senders.remove(instance);
+        if (data.senders.isEmpty()) {
+            data.notifier->disconnect(c.receiver, this);
+            shard.receivers.erase(it);
         }
     }
 }
 
 void ConnectionsStore::onReceiverDestroyed(void *receiver)
 {
-    QMutexLocker l(&m_mutex);
-    QHashIterator<void*, int> it(m_receivers[receiver].senders);
-    while (it.hasNext()) {
-        it.next();
-        lookupAndExec(it.key(), 0, Quark(), receiver, 0, 0, &ConnectionsStore::disconnectHandler);
+    QList<void*> senders;
+    {
+        ReceiverShard & shard = receiverShard(receiver);
+        QMutexLocker l(&shard.mutex);
+
+        QHash<void*, ReceiverData>::iterator it = shard.receivers.find(receiver);
+        if (it == shard.receivers.end()) {
+            return;
+        }
+        senders = it.value().senders.keys();
+        shard.receivers.erase(it);
+    }
+
+    //the receiver shard must not be locked here, as the instance shards are locked first
+    Q_FOREACH(void *instance, senders) {
+        QMutexLocker l(&instanceShard(instance).mutex);
+        lookupAndExec(instance, 0, Quark(), receiver, 0, 0, &ConnectionsStore::disconnectHandler);
     }
-    m_receivers.remove(receiver);
 }
 
 //optimization hack, to avoid making QObjectDestroyNotifier inherit
@@ -47,7 +47,23 @@ enum ConnectFlag { //codegen: skip=true
      * void mySlot(const QGlib::ObjectPtr & sender, const Foo & firstArgument, ...);
      * \endcode
      */
-    PassSender = 2
+    PassSender = 2,
+    /*! If ConnectQueued is specified, the slot passed to connect() is not invoked
+     * in the thread that emits the signal, but later, from the event loop of the thread
+     * that the receiver lives in, like a Qt::QueuedConnection. The arguments of the signal
+     * are copied, so that they remain valid until the slot is invoked. This is useful
+     * for signals that are emitted from GStreamer's streaming threads, as the streaming
+     * thread only has to queue the arguments and does not wait for the slot to finish.
+     * Since the emitter does not wait, the slot must return void.
+     */
+    ConnectQueued = 4,
+    /*! Like ConnectQueued, but when the signal is emitted again before the slot has
+     * been invoked, the pending invocation is replaced by the new one, so that only
+     * the arguments of the latest emission are delivered. This ensures that a receiver
+     * that cannot keep up with the rate of the emissions never causes invocations to
+     * pile up in its event queue. Specifying ConnectCoalesced implies ConnectQueued.
+     */
+    ConnectCoalesced = 8
 };
 Q_DECLARE_FLAGS(ConnectFlags, ConnectFlag);
 Q_DECLARE_OPERATORS_FOR_FLAGS(ConnectFlags)
@@ -127,6 +143,8 @@ Q_DECLARE_OPERATORS_FOR_FLAGS(ConnectFlags)
  * preprocessor, function and bind libraries will be compiled instead. That version has a
  * limit of 9 slot arguments.
  * \li This function is thread-safe.
+ * \li When using ConnectQueued or ConnectCoalesced, the \a slot is invoked from the event
+ * loop of the thread that \a receiver lives in and its return type must be void.
  *
  * \returns whether the connection was successfully made or not
  * \sa disconnect(), ConnectFlag, \ref connect_design
@@ -201,7 +219,10 @@ class QTGLIB_EXPORT ClosureDataBase
 {
 public:
     inline virtual ~ClosureDataBase() {}
-    virtual void marshaller(Value &, const QList<Value> &) = 0;
+
+    /* Converts the \a count signal arguments in \a params to the types of the slot
+     * arguments and invokes the slot. The arguments are only valid during this call. */
+    virtual void marshaller(Value & result, const Value *params, uint count) = 0;
 
     bool passSender; //whether to pass the sender instance as the first slot argument
 
@@ -255,6 +276,29 @@ struct GetDestroyNotifier<T, typename boost::enable_if< boost::is_base_of<QObjec
 };
 
 
+/* Wraps \a closureData in a closure that invokes it from the event loop of the
+ * thread of \a receiver, as requested by the ConnectQueued and ConnectCoalesced flags. */
+QTGLIB_EXPORT ClosureDataBase *createQueuedClosureData(ClosureDataBase *closureData,
+                                                       QObject *receiver, ConnectFlags flags);
+
+/* This method is used internally from QGlib::connect() to apply the flags
+ * that change the way that the closure is invoked. */
+template <typename R, typename T>
+inline ClosureDataBase *applyConnectFlags(ClosureDataBase *closureData,
+                                          T *receiver, ConnectFlags flags)
+{
+    if (flags & (ConnectQueued | ConnectCoalesced)) {
+        if (boost::is_void<R>::value) {
+            return createQueuedClosureData(closureData, receiver, flags);
+        } else {
+            qWarning("QGlib::connect: Queued connections can only be made to slots "
+                     "that return void. Making a direct connection instead.");
+        }
+    }
+    return closureData;
+}
+
+
 /* This method is used internally from QGlib::connect(). */
 QTGLIB_EXPORT ulong connect(void *instance, const char *signal, Quark detail,
                             void *receiver, const DestroyNotifierIfacePtr & notifier,
@@ -52,6 +52,14 @@ struct invoker<Function, void>
     static inline void invoke(const Function & f, Value &) { f(); }
 };
 
+/* Invokes f, deducing its type, so that the result of boost::bind() can be
+ * called directly instead of being stored in a heap-allocated boost::function */
+template <typename R, typename Function>
+inline void invokeBound(const Function & f, Value & result)
+{
+    invoker<Function, R>::invoke(f, result);
+}
+
 //END ******** invoker ********
 
 } //namespace Private
@@ -120,16 +128,14 @@ inline BoundArgumentFunction<F, R, Arg1, Args...> partial_bind(F && f, Arg1 && a
 
 template <typename F, typename R>
 inline void unpackAndInvoke(F && function, Value & result,
-                            QList<Value>::const_iterator &&,
-                            QList<Value>::const_iterator &&)
+                            const Value *, const Value *)
 {
     invoker<F, R>::invoke(function, result);
 }
 
 template <typename F, typename R, typename Arg1, typename... Args>
 inline void unpackAndInvoke(F && function, Value & result,
-                            QList<Value>::const_iterator && argsBegin,
-                            QList<Value>::const_iterator && argsEnd)
+                            const Value *argsBegin, const Value *argsEnd)
 {
     typedef typename boost::remove_const<
                 typename boost::remove_reference<Arg1>::type
@@ -139,9 +145,7 @@ inline void unpackAndInvoke(F && function, Value & result,
     CleanArg1 && boundArg = ValueImpl<CleanArg1>::get(*argsBegin);
     F1 && f = partial_bind<F, R, Arg1, Args...>(std::forward<F>(function), std::forward<Arg1>(boundArg));
 
-    unpackAndInvoke< F1, R, Args... >(std::forward<F1>(f), result,
-                                      std::forward<QList<Value>::const_iterator>(++argsBegin),
-                                      std::forward<QList<Value>::const_iterator>(argsEnd));
+    unpackAndInvoke< F1, R, Args... >(std::forward<F1>(f), result, argsBegin + 1, argsEnd);
 }
 
 //END ******** unpackAndInvoke ********
@@ -156,14 +160,14 @@ struct CppClosure<F, R (Args...)>
         inline ClosureData(const F & func, bool passSender)
             : ClosureDataBase(passSender), m_function(func) {}
 
-        virtual void marshaller(Value & result, const QList<Value> & params)
+        virtual void marshaller(Value & result, const Value *params, uint count)
         {
-            if (static_cast<size_t>(params.size()) < sizeof...(Args)) {
+            if (static_cast<size_t>(count) < sizeof...(Args)) {
                 throw std::logic_error("The signal provides less arguments than what the closure expects");
             }
 
             unpackAndInvoke<F, R, Args...>(std::forward<F>(m_function), result,
-                                           params.constBegin(), params.constEnd());
+                                           params, params + count);
         }
 
     private:
@@ -189,8 +193,9 @@ bool connect(void *instance, const char *detailedSignal,
     typedef Private::MemberFunction<T, R, Args...> F;
 
     F && f = Private::mem_fn(slot, receiver);
-    Private::ClosureDataBase* && closure
-        = Private::CppClosure<F, R (Args...)>::create(f, flags & PassSender);
+    Private::ClosureDataBase* && closure = Private::applyConnectFlags<R>(
+            Private::CppClosure<F, R (Args...)>::create(f, flags & PassSender),
+            receiver, flags);
 
     return Private::connect(instance, detailedSignal, Quark(),
                             receiver, Private::GetDestroyNotifier<T>(),
@@ -253,7 +258,7 @@ namespace Private {
         typename boost::remove_const< \
             typename boost::remove_reference<A ##n>::type \
         >::type \
-    >::get(list.at(n))
+    >::get(list[n])
 
 # define QGLIB_CONNECT_IMPL_UNPACK_ARGS(list) \
     BOOST_PP_REPEAT(QGLIB_CONNECT_IMPL_NUM_ARGS, QGLIB_CONNECT_IMPL_UNPACK_ARGS_STEP, list)
@@ -267,16 +272,15 @@ struct QGLIB_CONNECT_IMPL_CPPCLOSUREN
         inline ClosureData(const F & func, bool passSender)
             : ClosureDataBase(passSender), m_function(func) {}
 
-        virtual void marshaller(Value & result, const QList<Value> & params)
+        virtual void marshaller(Value & result, const Value *params, uint count)
         {
-            if (params.size() < QGLIB_CONNECT_IMPL_NUM_ARGS) {
+            if (static_cast<int>(count) < QGLIB_CONNECT_IMPL_NUM_ARGS) {
                 throw std::logic_error("The signal provides less arguments than what the closure expects");
             }
 
 # if QGLIB_CONNECT_IMPL_NUM_ARGS > 0
-            boost::function<R ()> callback = boost::bind<R>(m_function
-                                                            QGLIB_CONNECT_IMPL_UNPACK_ARGS(params));
-            invoker< boost::function<R ()>, R >::invoke(callback, result);
+            invokeBound<R>(boost::bind<R>(m_function QGLIB_CONNECT_IMPL_UNPACK_ARGS(params)),
+                           result);
 # else
             invoker< F, R >::invoke(m_function, result);
 # endif
@@ -324,6 +328,7 @@ bool connect(void *instance, const char *detailedSignal,
             boost::function<R (QGLIB_CONNECT_IMPL_TEMPLATE_ARGS)>,
             R (QGLIB_CONNECT_IMPL_TEMPLATE_ARGS)
         >::create(f, flags & PassSender);
+    closure = Private::applyConnectFlags<R>(closure, receiver, flags);
 
     return Private::connect(instance, detailedSignal, Quark(),
                             receiver, Private::GetDestroyNotifier<T>(),
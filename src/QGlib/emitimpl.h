@@ -38,6 +38,28 @@ QTGLIB_EXPORT Value emit(void *instance, const char *signal, Quark detail, const
 template <typename Signature>
 struct EmitImpl {};
 
+template <typename Signature>
+struct HandleEmitImpl {};
+
+/* Type-erased helpers that convert the arguments of an emission through a SignalHandle */
+template <typename T>
+struct ArgumentSetterImpl
+{
+    static void set(Value & value, const void *data)
+    {
+        ValueImpl<T>::set(value, *static_cast<const T*>(data));
+    }
+};
+
+template <typename T>
+struct ResultGetterImpl
+{
+    static void get(const Value & value, void *result)
+    {
+        *static_cast<T*>(result) = ValueImpl<T>::get(value);
+    }
+};
+
 } //namespace Private
 } //namespace QGlib
 
@@ -102,6 +124,38 @@ struct EmitImpl<void (Args...)>
 };
 
 //END ******** EmitImpl ********
+//BEGIN ******** HandleEmitImpl ********
+
+//the leading NULL entries of the arrays avoid zero-sized arrays when there are no arguments
+
+template <typename R, typename... Args>
+struct HandleEmitImpl<R (Args...)>
+{
+    static inline R emit(const SignalHandle & handle, void *instance, const Args & ... args)
+    {
+        const void *argv[] = { NULL, &args... };
+        const ArgumentSetter setters[] = { NULL, &ArgumentSetterImpl<Args>::set... };
+
+        R result = R();
+        handle.emitv(instance, argv + 1, setters + 1, sizeof...(Args),
+                     &result, &ResultGetterImpl<R>::get);
+        return result;
+    }
+};
+
+template <typename... Args>
+struct HandleEmitImpl<void (Args...)>
+{
+    static inline void emit(const SignalHandle & handle, void *instance, const Args & ... args)
+    {
+        const void *argv[] = { NULL, &args... };
+        const ArgumentSetter setters[] = { NULL, &ArgumentSetterImpl<Args>::set... };
+
+        handle.emitv(instance, argv + 1, setters + 1, sizeof...(Args), NULL, NULL);
+    }
+};
+
+//END ******** HandleEmitImpl ********
 
 } //namespace Private
 
@@ -119,6 +173,12 @@ R emitWithDetail(void *instance, const char *signal, Quark detail, const Args &
     return Private::EmitImpl<R (Args...)>::emit(instance, signal, detail, args...);
 }
 
+template <typename R, typename... Args>
+R emit(const SignalHandle & handle, void *instance, const Args & ... args)
+{
+    return Private::HandleEmitImpl<R (Args...)>::emit(handle, instance, args...);
+}
+
 //END ******** QGlib::emit ********
 
 } //namespace QGlib
@@ -224,6 +284,51 @@ struct EmitImpl<void (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
 # undef QGLIB_SIGNAL_IMPL_PACK_ARGS_STEP
 
 //END ******** boostpp EmitImpl ********
+//BEGIN ******** boostpp HandleEmitImpl ********
+
+# define QGLIB_SIGNAL_IMPL_ARG_POINTERS \
+    BOOST_PP_ENUM_TRAILING_PARAMS(QGLIB_SIGNAL_IMPL_NUM_ARGS, &a)
+
+# define QGLIB_SIGNAL_IMPL_ARG_SETTERS_STEP(z, n, data) \
+    , &ArgumentSetterImpl<A##n>::set
+
+# define QGLIB_SIGNAL_IMPL_ARG_SETTERS \
+    BOOST_PP_REPEAT(QGLIB_SIGNAL_IMPL_NUM_ARGS, QGLIB_SIGNAL_IMPL_ARG_SETTERS_STEP, ~)
+
+template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
+struct HandleEmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
+{
+    static inline R emit(const SignalHandle & handle, void *instance
+                         QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
+    {
+        const void *argv[] = { NULL QGLIB_SIGNAL_IMPL_ARG_POINTERS };
+        const ArgumentSetter setters[] = { NULL QGLIB_SIGNAL_IMPL_ARG_SETTERS };
+
+        R result = R();
+        handle.emitv(instance, argv + 1, setters + 1, QGLIB_SIGNAL_IMPL_NUM_ARGS,
+                     &result, &ResultGetterImpl<R>::get);
+        return result;
+    }
+};
+
+template <QGLIB_SIGNAL_IMPL_TEMPLATE_PARAMS>
+struct HandleEmitImpl<void (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
+{
+    static inline void emit(const SignalHandle & handle, void *instance
+                            QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
+    {
+        const void *argv[] = { NULL QGLIB_SIGNAL_IMPL_ARG_POINTERS };
+        const ArgumentSetter setters[] = { NULL QGLIB_SIGNAL_IMPL_ARG_SETTERS };
+
+        handle.emitv(instance, argv + 1, setters + 1, QGLIB_SIGNAL_IMPL_NUM_ARGS, NULL, NULL);
+    }
+};
+
+# undef QGLIB_SIGNAL_IMPL_ARG_SETTERS
+# undef QGLIB_SIGNAL_IMPL_ARG_SETTERS_STEP
+# undef QGLIB_SIGNAL_IMPL_ARG_POINTERS
+
+//END ******** boostpp HandleEmitImpl ********
 
 } //namespace Private
 
@@ -243,6 +348,13 @@ R emitWithDetail(void *instance, const char *signal, Quark detail QGLIB_SIGNAL_I
                 ::emit(instance, signal, detail QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
 }
 
+template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
+R emit(const SignalHandle & handle, void *instance QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
+{
+    return Private::HandleEmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
+                ::emit(handle, instance QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
+}
+
 //END ******** boostpp QGlib::emit ********
 
 } //namespace QGlib
@@ -52,6 +52,7 @@ class Value;
 class Quark;
 class Type;
 class Signal;
+class SignalHandle;
 class SignalHandler;
 template <class T> class RefPointer;
 class ParamSpec;
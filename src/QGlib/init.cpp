@@ -16,6 +16,7 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "init.h"
+#include "wrap.h"
 #include <glib-object.h>
 
 namespace QGlib {
@@ -28,6 +29,7 @@ void init()
 {
     g_type_init();
     Private::registerWrapperConstructors();
+    Private::invalidateWrapperConstructorCache();
 }
 
 } //namespace QGlib
@@ -19,6 +19,8 @@
 #include "object.h"
 #include "quark.h"
 #include <glib-object.h>
+#include <QtCore/QDebug>
+#include <QtCore/QVarLengthArray>
 
 namespace QGlib {
 namespace Private {
@@ -35,6 +37,109 @@ QList< RefPointer<T> > arrayToList(typename T::CType **array, uint n)
 
 } //namespace Private
 
+//BEGIN ******** PropertyHandle ********
+
+#ifndef DOXYGEN_RUN
+
+struct QTGLIB_NO_EXPORT PropertyHandle::Data : public QSharedData
+{
+    Data() : param(NULL), valueType(G_TYPE_INVALID) {}
+    Data(const Data & other)
+        : QSharedData(other),
+          param(other.param ? g_param_spec_ref(other.param) : NULL),
+          valueType(other.valueType) {}
+    ~Data() { if (param) g_param_spec_unref(param); }
+
+    /* Returns whether the property can be accessed with the given access \a flag
+     * on \a object, printing a warning if it cannot. */
+    bool checkAccess(GObject *object, GParamFlags flag, const char *caller) const;
+
+    GParamSpec *param;
+    GType valueType;
+};
+
+bool PropertyHandle::Data::checkAccess(GObject *object, GParamFlags flag, const char *caller) const
+{
+    if (!param) {
+        qWarning() << caller << ": The property handle is not valid";
+        return false;
+    }
+    if (!g_type_is_a(G_OBJECT_TYPE(object), param->owner_type)) {
+        qWarning() << caller << ": Property" << param->name << "does not exist on objects of type"
+                   << G_OBJECT_TYPE_NAME(object);
+        return false;
+    }
+    if (!(param->flags & flag)) {
+        qWarning() << caller << ": Property" << param->name << "is not"
+                   << (flag == G_PARAM_READABLE ? "readable" : "writable");
+        return false;
+    }
+    return true;
+}
+
+#endif //DOXYGEN_RUN
+
+PropertyHandle::PropertyHandle()
+    : d(new Data)
+{
+}
+
+PropertyHandle::PropertyHandle(Type type, const char *name)
+    : d(new Data)
+{
+    GParamSpec *param = NULL;
+
+    if (type.isInterface()) {
+        gpointer iface = g_type_default_interface_ref(type);
+        param = g_object_interface_find_property(iface, name);
+        g_type_default_interface_unref(iface);
+    } else if (type.isA(Type::Object)) {
+        gpointer klass = g_type_class_ref(type);
+        param = g_object_class_find_property(G_OBJECT_CLASS(klass), name);
+        g_type_class_unref(klass);
+    }
+
+    if (param) {
+        d->param = g_param_spec_ref_sink(param);
+        d->valueType = param->value_type;
+    } else {
+        qWarning() << "QGlib::PropertyHandle: Could not find property" << name
+                   << "on type" << type.name();
+    }
+}
+
+PropertyHandle::PropertyHandle(const PropertyHandle & other)
+    : d(other.d)
+{
+}
+
+PropertyHandle & PropertyHandle::operator=(const PropertyHandle & other)
+{
+    d = other.d;
+    return *this;
+}
+
+PropertyHandle::~PropertyHandle()
+{
+}
+
+bool PropertyHandle::isValid() const
+{
+    return d->param != NULL;
+}
+
+ParamSpecPtr PropertyHandle::paramSpec() const
+{
+    return ParamSpecPtr::wrap(d->param);
+}
+
+Type PropertyHandle::valueType() const
+{
+    return d->valueType;
+}
+
+//END ******** PropertyHandle ********
+//BEGIN ******** ObjectBase ********
 
 ParamSpecPtr ObjectBase::findProperty(const char *name) const
 {
@@ -75,6 +180,94 @@ void ObjectBase::setProperty(const char *name, const Value & value)
     g_object_set_property(object<GObject>(), name, value);
 }
 
+Value ObjectBase::property(const PropertyHandle & handle) const
+{
+    Value result;
+    if (handle.d->checkAccess(object<GObject>(), G_PARAM_READABLE, "QGlib::ObjectBase::property")) {
+        result.init(handle.d->valueType);
+        g_object_get_property(object<GObject>(), handle.d->param->name, result);
+    }
+    return result;
+}
+
+void ObjectBase::setProperty(const PropertyHandle & handle, const Value & value)
+{
+    if (!handle.d->checkAccess(object<GObject>(), G_PARAM_WRITABLE, "QGlib::ObjectBase::setProperty")) {
+        return;
+    }
+    if (!value.isValid()) {
+        qWarning() << "QGlib::ObjectBase::setProperty: Invalid value for property"
+                   << handle.d->param->name;
+        return;
+    }
+    g_object_set_property(object<GObject>(), handle.d->param->name, value);
+}
+
+QList<Value> ObjectBase::properties(const QList<PropertyHandle> & handles) const
+{
+    GObject *obj = object<GObject>();
+    QList<Value> result;
+    result.reserve(handles.size());
+
+    /* g_object_getv() would require an extra copy of every value from its GValue array
+     * to the returned Values, which is expensive for boxed properties like structures.
+     * Reading directly into the Values gives the same single pass without copies. */
+    g_object_ref(obj);
+    for (int i = 0; i < handles.size(); ++i) {
+        result.append(Value());
+        const PropertyHandle::Data *d = handles[i].d.constData();
+        if (d->checkAccess(obj, G_PARAM_READABLE, "QGlib::ObjectBase::properties")) {
+            result.last().init(d->valueType);
+            g_object_get_property(obj, d->param->name, result.last());
+        }
+    }
+    g_object_unref(obj);
+
+    return result;
+}
+
+void ObjectBase::setProperties(const QList<PropertyHandle> & handles, const QList<Value> & values)
+{
+    if (handles.size() != values.size()) {
+        qWarning() << "QGlib::ObjectBase::setProperties: The number of handles"
+                      " differs from the number of values";
+        return;
+    }
+
+    GObject *obj = object<GObject>();
+    QVarLengthArray<const char*, 8> names;
+    QVarLengthArray<GValue, 8> gvalues;
+
+    for (int i = 0; i < handles.size(); ++i) {
+        const PropertyHandle::Data *d = handles[i].d.constData();
+        if (!d->checkAccess(obj, G_PARAM_WRITABLE, "QGlib::ObjectBase::setProperties")) {
+            continue;
+        }
+        if (!values[i].isValid()) {
+            qWarning() << "QGlib::ObjectBase::setProperties: Skipping invalid value for property"
+                       << d->param->name;
+            continue;
+        }
+        names.append(d->param->name);
+        //shallow copy; the GValue is only read and it remains owned by the Value
+        gvalues.append(*static_cast<const GValue*>(values[i]));
+    }
+
+    if (names.isEmpty()) {
+        return;
+    }
+
+#if GLIB_CHECK_VERSION(2,54,0)
+    g_object_setv(obj, names.size(), names.data(), gvalues.constData());
+#else
+    g_object_freeze_notify(obj);
+    for (int i = 0; i < names.size(); ++i) {
+        g_object_set_property(obj, names[i], &gvalues[i]);
+    }
+    g_object_thaw_notify(obj);
+#endif
+}
+
 void *ObjectBase::data(const char *key) const
 {
     return g_object_get_data(object<GObject>(), key);
@@ -117,4 +310,6 @@ void ObjectBase::unref()
     g_object_unref(m_object);
 }
 
+//END ******** ObjectBase ********
+
 }
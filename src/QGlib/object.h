@@ -25,9 +25,62 @@
 #include "value.h"
 #include "type.h"
 #include <QtCore/QList>
+#include <QtCore/QSharedDataPointer>
 
 namespace QGlib {
 
+/*! \headerfile QGlib/object.h <QGlib/Object>
+ * \brief A pre-resolved property of a class, for fast repeated access
+ *
+ * Accessing a property by name requires looking up its ParamSpec in the class
+ * of the object every time. A PropertyHandle does this only once, when it is
+ * constructed, and keeps the ParamSpec and the type of the property's value.
+ * It can then be used with ObjectBase::property(), ObjectBase::setProperty(),
+ * ObjectBase::properties() and ObjectBase::setProperties() on any instance
+ * of the class or of its subclasses.
+ *
+ * \note The handle saves the class reference and ParamSpec lookup that
+ * ObjectBase::findProperty() does, and the access checks are made on the
+ * cached ParamSpec. The value is still read and written through GObject,
+ * which looks the property up again by its interned name, because only
+ * GObject can dispatch to overridden properties and queue change
+ * notifications correctly. That lookup is a single hash table lookup.
+ *
+ * \code
+ * QGlib::PropertyHandle volume(QGlib::GetType<QGst::StreamVolume>(), "volume");
+ * ...
+ * double level = element->property(volume).get<double>();
+ * \endcode
+ */
+class QTGLIB_EXPORT PropertyHandle
+{
+public:
+    /*! Creates an invalid PropertyHandle \sa isValid() */
+    PropertyHandle();
+
+    /*! Looks up the property called \a name on the class or interface \a type.
+     * If the property cannot be found, an invalid handle is created. */
+    PropertyHandle(Type type, const char *name);
+
+    PropertyHandle(const PropertyHandle & other);
+    PropertyHandle & operator=(const PropertyHandle & other);
+    virtual ~PropertyHandle();
+
+    /*! Returns true if the property was found when this handle was created */
+    bool isValid() const;
+
+    /*! Returns the ParamSpec that describes the property */
+    ParamSpecPtr paramSpec() const;
+
+    /*! Returns the type of the values that the property holds */
+    Type valueType() const;
+
+private:
+    friend class ObjectBase;
+    struct Data;
+    QSharedDataPointer<Data> d;
+};
+
 /*! \headerfile QGlib/object.h <QGlib/Object>
  * \brief Common virtual base class for Object and Interface
  *
@@ -64,6 +117,35 @@ public:
      */
     void setProperty(const char *name, const Value & value);
 
+    /*! Returns the value of the property that \a handle refers to. This avoids
+     * looking up its ParamSpec with findProperty(). If the handle is invalid or
+     * the property is not readable, an invalid Value will be returned.
+     */
+    Value property(const PropertyHandle & handle) const;
+
+    /*! Sets the property that \a handle refers to, to hold the given \a value,
+     * converting it to the type of the property using Value::set().
+     */
+    template <class T> void setProperty(const PropertyHandle & handle, const T & value);
+
+    /*! \overload
+     * \a value must hold a type that can be transformed to the type of the property.
+     */
+    void setProperty(const PropertyHandle & handle, const Value & value);
+
+    /*! Returns the values of all the properties that \a handles refer to, in the same
+     * order. This is faster than calling property() repeatedly. Properties that cannot
+     * be read result in an invalid Value.
+     */
+    QList<Value> properties(const QList<PropertyHandle> & handles) const;
+
+    /*! Sets the properties that \a handles refer to, to the respective \a values,
+     * in one call. Change notifications are emitted once all the properties have
+     * been set. \a handles and \a values must have the same size. Properties
+     * that cannot be written and invalid values are skipped with a warning.
+     */
+    void setProperties(const QList<PropertyHandle> & handles, const QList<Value> & values);
+
     void *data(const char *key) const;
     void *stealData(const char *key) const;
     void setData(const char *key, void *data, void (*destroyCallback)(void*) = NULL);
@@ -114,6 +196,17 @@ void ObjectBase::setProperty(const char *name, const T & value)
     }
 }
 
+template <class T>
+void ObjectBase::setProperty(const PropertyHandle & handle, const T & value)
+{
+    if (handle.isValid()) {
+        Value v;
+        v.init(handle.valueType());
+        v.set<T>(value);
+        setProperty(handle, v);
+    }
+}
+
 } //namespace QGlib
 
 QGLIB_REGISTER_TYPE(QGlib::Object)
@@ -98,6 +98,7 @@ public:
     static QList<Signal> listSignals(Type type);
 
 private:
+    friend class SignalHandle;
     QTGLIB_NO_EXPORT Signal(uint id);
 
     struct Private;
@@ -106,6 +107,67 @@ private:
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Signal::SignalFlags)
 
+
+namespace Private {
+    template <typename Signature> struct HandleEmitImpl;
+    typedef void (*ArgumentSetter)(Value & value, const void *data);
+    typedef void (*ResultGetter)(const Value & value, void *result);
+}
+
+/*! \headerfile qglib_signal.h <QGlib/Signal>
+ * \brief A signal of a specific instance Type, resolved once for repeated emission
+ *
+ * emit() parses the signal name and looks up the signal every time it is called.
+ * A SignalHandle does this only once, when it is constructed, and keeps the signal id,
+ * the detail quark and the types of the signal parameters. Emitting through a handle
+ * converts the arguments directly into GValues on the stack, so this is well suited
+ * for action signals that are emitted very often, for example once per video frame.
+ *
+ * \code
+ * QGlib::SignalHandle pullSample(QGlib::Type::fromInstance(appsink), "pull-sample");
+ * ...
+ * QGst::SamplePtr sample = QGlib::emit<QGst::SamplePtr>(pullSample, appsink);
+ * \endcode
+ *
+ * A handle can be used to emit the signal on any instance of the Type that it was
+ * created for, or of a Type that derives from it.
+ *
+ * \note This class is implicitly shared.
+ * \sa emit()
+ */
+class QTGLIB_EXPORT SignalHandle
+{
+public:
+    /*! Creates an invalid SignalHandle \sa isValid() */
+    SignalHandle();
+
+    /*! Looks up \a detailedSignal on the given \a instanceType. The signal name may
+     * include a detail, using the "signal::detail" syntax. If the signal cannot be found,
+     * a warning is printed and the handle is invalid.
+     */
+    SignalHandle(Type instanceType, const char *detailedSignal);
+
+    SignalHandle(const SignalHandle & other);
+    SignalHandle & operator=(const SignalHandle & other);
+    virtual ~SignalHandle();
+
+    /*! Returns true if the signal was found when this handle was created */
+    bool isValid() const;
+
+    Signal signal() const; ///< Returns the Signal that this handle emits.
+    Quark detail() const; ///< Returns the detail that this handle emits the signal with.
+
+private:
+    template <typename Signature>
+    friend struct Private::HandleEmitImpl;
+
+    void emitv(void *instance, const void * const *args, const Private::ArgumentSetter *setters,
+               uint count, void *result, Private::ResultGetter getter) const;
+
+    struct Data;
+    QSharedDataPointer<Data> d;
+};
+
 #if defined(DOXYGEN_RUN)
 
 /*! Emits a signal on a specified \a instance with the specified arguments.
@@ -163,6 +225,16 @@ R emit(void *instance, const char *detailedSignal, const Args & ... args);
 template <typename R, typename... Args>
 R emitWithDetail(void *instance, const char *signal, Quark detail, const Args & ... args);
 
+/*! \overload
+ * This method emits the signal that the given \a handle has resolved, with the detail of
+ * the \a handle, on \a instance. The arguments are converted straight to the parameter
+ * types of the signal, without looking up the signal again and without allocating
+ * memory for the arguments.
+ * \sa SignalHandle
+ */
+template <typename R, typename... Args>
+R emit(const SignalHandle & handle, void *instance, const Args & ... args);
+
 #endif //DOXYGEN_RUN
 
 } //namespace QGlib
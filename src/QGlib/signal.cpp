@@ -18,8 +18,11 @@
 */
 #include "qglib_signal.h"
 #include "quark.h"
+#include "value_p.h"
 #include <glib-object.h>
 #include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <QtCore/QVarLengthArray>
 #include <QtCore/QDebug>
 
 //proper initializer for GValue structs on the stack
@@ -133,6 +136,174 @@ QList<Signal> Signal::listSignals(Type type)
 }
 
 //END ******** Signal ********
+//BEGIN ******** SignalHandle ********
+
+#ifndef DOXYGEN_RUN
+
+struct QTGLIB_NO_EXPORT SignalHandle::Data : public QSharedData
+{
+    Data() : id(0), detail(0), returnType(G_TYPE_NONE) {}
+
+    uint id;
+    GQuark detail;
+    GType returnType;
+    QVector<GType> paramTypes;
+};
+
+namespace {
+
+/* Unsets all the initialized GValues of an array when going out of scope */
+class GValueArrayGuard
+{
+public:
+    inline GValueArrayGuard(GValue *values, uint count)
+        : m_values(values), m_count(count) {}
+
+    inline ~GValueArrayGuard()
+    {
+        for (uint i = 0; i < m_count; ++i) {
+            if (G_IS_VALUE(&m_values[i])) {
+                g_value_unset(&m_values[i]);
+            }
+        }
+    }
+
+private:
+    GValue *m_values;
+    uint m_count;
+};
+
+inline QString signalName(uint id)
+{
+    return id ? QString::fromUtf8(g_signal_name(id)) : QString(QLatin1String("(invalid)"));
+}
+
+} //anonymous namespace
+
+#endif //DOXYGEN_RUN
+
+SignalHandle::SignalHandle()
+    : d(new Data)
+{
+}
+
+SignalHandle::SignalHandle(Type instanceType, const char *detailedSignal)
+    : d(new Data)
+{
+    //the signals of a class are only registered once the class has been initialized
+    gpointer klass = G_TYPE_IS_CLASSED(instanceType) ? g_type_class_ref(instanceType) : NULL;
+
+    guint signalId;
+    GQuark detailQuark;
+    if (g_signal_parse_name(detailedSignal, instanceType, &signalId, &detailQuark, FALSE)) {
+        GSignalQuery query;
+        g_signal_query(signalId, &query);
+
+        d->id = signalId;
+        d->detail = detailQuark;
+        d->returnType = query.return_type & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+        d->paramTypes.reserve(query.n_params);
+        for (uint i = 0; i < query.n_params; ++i) {
+            d->paramTypes.append(query.param_types[i] & ~G_SIGNAL_TYPE_STATIC_SCOPE);
+        }
+    } else {
+        qWarning() << "QGlib::SignalHandle: Could not parse signal:" << detailedSignal
+                   << "- Either it does not exist on this type, or a detail "
+                      "was specified but the signal is not detailed";
+    }
+
+    if (klass) {
+        g_type_class_unref(klass);
+    }
+}
+
+SignalHandle::SignalHandle(const SignalHandle & other)
+    : d(other.d)
+{
+}
+
+SignalHandle & SignalHandle::operator=(const SignalHandle & other)
+{
+    d = other.d;
+    return *this;
+}
+
+SignalHandle::~SignalHandle()
+{
+}
+
+bool SignalHandle::isValid() const
+{
+    return d->id != 0;
+}
+
+Signal SignalHandle::signal() const
+{
+    return Signal(d->id);
+}
+
+Quark SignalHandle::detail() const
+{
+    return d->detail;
+}
+
+void SignalHandle::emitv(void *instance, const void * const *args,
+                         const Private::ArgumentSetter *setters, uint count,
+                         void *result, Private::ResultGetter getter) const
+{
+    //instance, arguments and return value, in this order
+    QVarLengthArray<GValue, 8> values(count + 2);
+    memset(values.data(), 0, sizeof(GValue) * (count + 2));
+    GValueArrayGuard guard(values.data(), count + 2);
+    GValue *returnValue = &values[count + 1];
+
+    try {
+        if (!isValid()) {
+            throw QString(QLatin1String("The signal handle is not valid"));
+        }
+
+        if (static_cast<uint>(d->paramTypes.size()) != count) {
+            throw QString(QLatin1String("The number of arguments that the signal accepts differ "
+                                        "from the number of arguments provided to emit"));
+        }
+
+        g_value_init(&values[0], G_TYPE_FROM_INSTANCE(instance));
+        g_value_set_instance(&values[0], instance);
+
+        //set the arguments directly on the GValues that will be passed to the signal
+        for (uint i = 0; i < count; ++i) {
+            g_value_init(&values[i+1], d->paramTypes[i]);
+        }
+        Private::BorrowedValues arguments(&values[1], count, Private::BorrowedValues::ReadWrite);
+        for (uint i = 0; i < count; ++i) {
+            setters[i](arguments[i], args[i]);
+        }
+
+        if (d->returnType != G_TYPE_NONE) {
+            g_value_init(returnValue, d->returnType);
+        }
+
+        g_signal_emitv(values.data(), d->id, d->detail, returnValue);
+
+        if (getter) {
+            if (!G_IS_VALUE(returnValue)) {
+                throw QString(QLatin1String("The signal does not return a value"));
+            }
+            Private::BorrowedValues returned(returnValue, 1);
+            getter(returned[0], result);
+        } else if (G_IS_VALUE(returnValue)) {
+            qWarning() << "Ignoring return value from emission of signal" << signalName(d->id);
+        }
+    } catch (const QString & msg) {
+        qCritical() << "Error during emission of signal" << signalName(d->id)
+                    << "on object" << Type::fromInstance(instance).name() << ":" << msg;
+    } catch (const std::exception & e) {
+        qCritical() << "Error during emission of signal" << signalName(d->id)
+                    << "on object" << Type::fromInstance(instance).name() << ":" << e.what();
+    }
+}
+
+//END ******** SignalHandle ********
 
 namespace Private {
 
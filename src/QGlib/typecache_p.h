@@ -0,0 +1,224 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGLIB_TYPECACHE_P_H
+#define QGLIB_TYPECACHE_P_H
+
+#include "type.h"
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QMutex>
+
+/* WARNING: This header should only be included from
+ * QtGStreamer source files and should not be installed */
+
+namespace QGlib {
+namespace Private {
+
+/* Memoizes a value per GType, for values that are expensive to resolve and
+ * looked up far more often than they change.
+ *
+ * find() takes no lock. Entries live in an open addressing table whose slots
+ * are filled in place by insert(), with the value written before the key is
+ * published, and are never modified afterwards. When the table gets too full,
+ * its entries are rehashed into one of twice the size, which replaces it.
+ * A replaced table may still be in use by a reader, so it is only freed when
+ * the cache is destroyed; since the sizes double, all the replaced tables
+ * together take less memory than the current one. clear() also replaces
+ * the table and is meant for the rare changes of the resolved values,
+ * such as the registrations that happen on initialization.
+ */
+template <typename V>
+class TypeCache
+{
+public:
+    TypeCache();
+    ~TypeCache();
+
+    /* Stores the value cached for \a type in \a value and returns true,
+     * or returns false if there is none. */
+    inline bool find(Type type, V *value) const;
+    /* Caches \a value for \a type. If \a type is already cached,
+     * the value that is already there is kept. */
+    void insert(Type type, const V & value);
+    /* Drops all the cached values. */
+    void clear();
+
+private:
+    Q_DISABLE_COPY(TypeCache)
+
+    enum { InitialCapacity = 64 };
+
+    struct Slot
+    {
+        QAtomicPointer<void> key; //null for an empty slot
+        V value;
+    };
+
+    struct Table
+    {
+        explicit Table(uint capacity)
+            : mask(capacity - 1), count(0), slots(new Slot[capacity]), retired(NULL) {}
+        ~Table() { delete[] slots; }
+
+        const uint mask; //the capacity is a power of 2
+        uint count;      //guarded by m_writeLock
+        Slot *slots;
+        Table *retired;  //the table that this one replaced
+    };
+
+    static inline void *keyOf(Type type)
+    {
+        return reinterpret_cast<void*>(static_cast<quintptr>(static_cast<GType>(type)));
+    }
+
+    static inline uint hashOf(void *key)
+    {
+        //GTypes of classes are pointers, whose low bits are always zero
+        quint64 h = reinterpret_cast<quintptr>(key);
+        h ^= h >> 33;
+        h *= Q_UINT64_C(0xff51afd7ed558ccd);
+        h ^= h >> 33;
+        return static_cast<uint>(h);
+    }
+
+    static inline void *loadKey(const Slot & slot)
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        return slot.key.loadAcquire();
+#else
+        return slot.key;
+#endif
+    }
+
+    inline Table *table() const
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        return m_table.loadAcquire();
+#else
+        return m_table;
+#endif
+    }
+
+    static void insert(Table *table, void *key, const V & value);
+    void replace(Table *table);
+
+    QMutex m_writeLock;
+    QAtomicPointer<Table> m_table;
+};
+
+template <typename V>
+TypeCache<V>::TypeCache()
+    : m_table(new Table(InitialCapacity))
+{
+}
+
+template <typename V>
+TypeCache<V>::~TypeCache()
+{
+    Table *table = m_table.fetchAndStoreOrdered(NULL);
+    while (table) {
+        Table *retired = table->retired;
+        delete table;
+        table = retired;
+    }
+}
+
+template <typename V>
+inline bool TypeCache<V>::find(Type type, V *value) const
+{
+    void *key = keyOf(type);
+    if (!key) {
+        return false;
+    }
+
+    const Table *t = table();
+    for (uint i = hashOf(key) & t->mask; ; i = (i + 1) & t->mask) {
+        void *slotKey = loadKey(t->slots[i]);
+        if (slotKey == key) {
+            *value = t->slots[i].value;
+            return true;
+        } else if (!slotKey) {
+            return false;
+        }
+    }
+}
+
+template <typename V>
+void TypeCache<V>::insert(Type type, const V & value)
+{
+    void *key = keyOf(type);
+    if (!key) {
+        return;
+    }
+
+    QMutexLocker l(&m_writeLock);
+    Table *t = table();
+
+    //keep at least a quarter of the slots empty, so that probing stays short
+    if ((t->count + 1) * 4 > (t->mask + 1) * 3) {
+        Table *grown = new Table((t->mask + 1) * 2);
+        for (uint i = 0; i <= t->mask; ++i) {
+            void *slotKey = loadKey(t->slots[i]);
+            if (slotKey) {
+                insert(grown, slotKey, t->slots[i].value);
+            }
+        }
+        replace(grown);
+        t = grown;
+    }
+
+    insert(t, key, value);
+}
+
+//must be called with m_writeLock held
+template <typename V>
+void TypeCache<V>::insert(Table *table, void *key, const V & value)
+{
+    for (uint i = hashOf(key) & table->mask; ; i = (i + 1) & table->mask) {
+        Slot & slot = table->slots[i];
+        void *slotKey = loadKey(slot);
+        if (slotKey == key) {
+            return;
+        } else if (!slotKey) {
+            slot.value = value;
+            //publishes the value together with the key
+            slot.key.fetchAndStoreRelease(key);
+            ++table->count;
+            return;
+        }
+    }
+}
+
+template <typename V>
+void TypeCache<V>::clear()
+{
+    QMutexLocker l(&m_writeLock);
+    if (table()->count > 0) {
+        replace(new Table(InitialCapacity));
+    }
+}
+
+//must be called with m_writeLock held
+template <typename V>
+void TypeCache<V>::replace(Table *table)
+{
+    table->retired = m_table.fetchAndStoreRelease(table);
+}
+
+} //namespace Private
+} //namespace QGlib
+
+#endif
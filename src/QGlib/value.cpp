@@ -17,16 +17,24 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "value.h"
+#include "value_p.h"
+#include "typecache_p.h"
 #include "string.h"
 #include <cstring>
+#include <new>
 #include <boost/type_traits.hpp>
 #include <glib-object.h>
 #include <QtCore/QDebug>
-#include <QtCore/QReadWriteLock>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 
 namespace QGlib {
 namespace Private {
 
+/* The dispatcher memoizes the vtable that is resolved for each type that was asked
+ * for, so that getVTable() does not need to walk the type hierarchy more than once
+ * per type, and looks it up without locking.
+ */
 class Dispatcher
 {
 public:
@@ -36,8 +44,11 @@ public:
     void setVTable(Type t, const ValueVTable & vtable);
 
 private:
-    mutable QReadWriteLock lock;
-    QHash<Type, ValueVTable> dispatchTable;
+    ValueVTable resolveVTable(Type t) const;
+
+    mutable QMutex writeLock;
+    QHash<Type, ValueVTable> registeredTable; //guarded by writeLock
+    mutable TypeCache<ValueVTable> cache;
 };
 
 Dispatcher::Dispatcher()
@@ -81,6 +92,26 @@ Dispatcher::Dispatcher()
 }
 
 ValueVTable Dispatcher::getVTable(Type t) const
+{
+    ValueVTable vtable;
+    if (cache.find(t, &vtable)) {
+        return vtable;
+    }
+
+    QMutexLocker l(&writeLock);
+
+    //check again, another thread may have resolved it in the meantime
+    if (cache.find(t, &vtable)) {
+        return vtable;
+    }
+
+    vtable = resolveVTable(t);
+    cache.insert(t, vtable);
+    return vtable;
+}
+
+//must be called with writeLock held
+ValueVTable Dispatcher::resolveVTable(Type t) const
 {
     //if the type is an interface, try to find its
     //instantiatable prerequisite and get the vtable
@@ -101,26 +132,22 @@ ValueVTable Dispatcher::getVTable(Type t) const
         }
     }
 
-    QReadLocker l(&lock);
-
-    if (dispatchTable.contains(t)) {
-        return dispatchTable[t];
-    }
-
-    while (t.isDerived()) {
+    QHash<Type, ValueVTable>::const_iterator it = registeredTable.constFind(t);
+    while (it == registeredTable.constEnd() && t.isDerived()) {
         t = t.parent();
-        if (dispatchTable.contains(t)) {
-            return dispatchTable[t];
-        }
+        it = registeredTable.constFind(t);
     }
 
-    return ValueVTable();
+    return it != registeredTable.constEnd() ? it.value() : ValueVTable();
 }
 
 void Dispatcher::setVTable(Type t, const ValueVTable & vtable)
 {
-    QWriteLocker l(&lock);
-    dispatchTable[t] = vtable;
+    QMutexLocker l(&writeLock);
+    registeredTable[t] = vtable;
+
+    //previously resolved types may now resolve to the new vtable
+    cache.clear();
 }
 
 } //namespace Private
@@ -131,27 +158,14 @@ Q_GLOBAL_STATIC(Private::Dispatcher, s_dispatcher);
 
 // -- Value::Data --
 
-struct QTGLIB_NO_EXPORT Value::Data : public QSharedData
-{
-    Data();
-    Data(const Data & other);
-    ~Data();
-
-    inline Type type() const { return G_VALUE_TYPE(&m_value); }
-    inline GValue *value() { return &m_value; }
-    inline const GValue *value() const { return &m_value; }
-
-    GValue m_value;
-};
-
 Value::Data::Data()
-    : QSharedData()
+    : QSharedData(), m_ptr(&m_value), m_borrowed(false), m_writeThrough(false)
 {
     std::memset(&m_value, 0, sizeof(GValue));
 }
 
 Value::Data::Data(const Value::Data & other)
-    : QSharedData(other)
+    : QSharedData(other), m_ptr(&m_value), m_borrowed(false), m_writeThrough(false)
 {
     std::memset(&m_value, 0, sizeof(GValue));
 
@@ -163,11 +177,60 @@ Value::Data::Data(const Value::Data & other)
 
 Value::Data::~Data()
 {
-    if (type() != Type::Invalid) {
+    if (!m_borrowed && type() != Type::Invalid) {
         g_value_unset(value());
     }
 }
 
+// -- Private::BorrowedValues --
+
+namespace Private {
+
+BorrowedValues::BorrowedValues(const GValue *values, uint count, Access access)
+    : m_count(count), m_access(access)
+{
+    if (count <= PreallocCount) {
+        m_data = reinterpret_cast<Value::Data*>(m_dataStorage.bytes);
+        m_values = reinterpret_cast<Value*>(m_valueStorage.bytes);
+    } else {
+        m_data = static_cast<Value::Data*>(::operator new(count * sizeof(Value::Data)));
+        m_values = static_cast<Value*>(::operator new(count * sizeof(Value)));
+    }
+
+    for (uint i = 0; i < count; ++i) {
+        Value::Data *data = new (&m_data[i]) Value::Data;
+        data->m_ptr = const_cast<GValue*>(&values[i]);
+        data->m_borrowed = true;
+        data->m_writeThrough = (access == ReadWrite);
+
+        //With an extra reference, the Value is not the only owner of the data
+        //and modifying it detaches it from the original GValue.
+        if (access == ReadOnly) {
+            data->ref.ref();
+        }
+        new (&m_values[i]) Value(data);
+    }
+}
+
+BorrowedValues::~BorrowedValues()
+{
+    for (uint i = 0; i < m_count; ++i) {
+        //keep ~Value() from deleting the data, it is not heap-allocated
+        if (m_access == ReadWrite) {
+            m_data[i].ref.ref();
+        }
+        m_values[i].~Value();
+        m_data[i].~Data();
+    }
+
+    if (m_count > PreallocCount) {
+        ::operator delete(m_data);
+        ::operator delete(m_values);
+    }
+}
+
+} //namespace Private
+
 #endif //DOXYGEN_RUN
 
 // -- Value --
@@ -221,14 +284,45 @@ VALUE_CONSTRUCTOR(const QString &)
 
 #undef VALUE_CONSTRUCTOR
 
+Value::Value(Data *data)
+    : d(data)
+{
+}
+
 Value::Value(const Value & other)
     : d(other.d)
 {
+    //never share a borrowed GValue, it may go away before the copy does
+    if (d.constData()->m_borrowed) {
+        d.detach();
+    }
 }
 
 Value & Value::operator=(const Value & other)
 {
+    if (d.constData()->m_writeThrough) {
+        //the GValue that we refer to is not ours to replace; assign its contents instead
+        if (&other != this) {
+            GValue *dest = d->value();
+            if (!other.isValid()) {
+                if (G_IS_VALUE(dest)) {
+                    g_value_reset(dest);
+                }
+            } else if (!G_IS_VALUE(dest)) {
+                g_value_init(dest, other.type());
+                g_value_copy(other.d->value(), dest);
+            } else if (!g_value_transform(other.d->value(), dest)) {
+                qWarning() << "QGlib::Value: Could not assign a value of type" << other.type().name()
+                           << "to a value of type" << type().name();
+            }
+        }
+        return *this;
+    }
+
     d = other.d;
+    if (d.constData()->m_borrowed) {
+        d.detach();
+    }
     return *this;
 }
 
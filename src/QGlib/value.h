@@ -32,6 +32,8 @@
 
 namespace QGlib {
 
+namespace Private { class BorrowedValues; }
+
 /*! This structure holds the set and get methods that are used internally
  * by Value to handle data of a specific type. If you want to provide
  * support for a custom type, you need to write two such methods, create
@@ -247,6 +249,7 @@ public:
 private:
     template <typename T>
     friend struct ValueImpl;
+    friend class Private::BorrowedValues;
 
     /*! Retrieves the data from this Value and places it into the memory position
      * pointed to by \a data. \a dataType indicates the actual data type of \a data
@@ -267,6 +270,8 @@ private:
     void setData(Type dataType, const void *data);
 
     struct Data;
+    explicit Value(Data *data);
+
     QSharedDataPointer<Data> d;
 };
 
@@ -0,0 +1,98 @@
+/*
+    Copyright (C) 2009-2010  George Kiagiadakis <kiagiadakis.george@gmail.com>
+    Copyright (C) 2010 Collabora Ltd.
+      @author George Kiagiadakis <george.kiagiadakis@collabora.co.uk>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGLIB_VALUE_P_H
+#define QGLIB_VALUE_P_H
+
+#include "value.h"
+#include <glib-object.h>
+
+/* WARNING: This header should only be included from
+ * QtGStreamer source files and should not be installed */
+
+namespace QGlib {
+
+struct QTGLIB_NO_EXPORT Value::Data : public QSharedData
+{
+    Data();
+    Data(const Data & other);
+    ~Data();
+
+    inline Type type() const { return G_VALUE_TYPE(m_ptr); }
+    inline GValue *value() { return m_ptr; }
+    inline const GValue *value() const { return m_ptr; }
+
+    GValue m_value;
+
+    //points to m_value, or to a GValue that belongs to someone else if m_borrowed is true
+    GValue *m_ptr;
+    bool m_borrowed;
+    //if true, assigning to the Value writes into the borrowed GValue
+    bool m_writeThrough;
+};
+
+namespace Private {
+
+/* Presents an array of GValues that belong to someone else as an array of Values,
+ * without copying the GValues. Up to PreallocCount of them are kept on the stack,
+ * so that no memory is allocated in the common case.
+ *
+ * The Values are only valid for as long as this object and the original GValues exist.
+ * Copying one of them makes a real copy of the GValue, so it is safe to keep copies
+ * around. With ReadOnly access, modifying one of the Values detaches it from the
+ * original GValue. With ReadWrite access, modifications go to the original GValue.
+ */
+class QTGLIB_NO_EXPORT BorrowedValues
+{
+public:
+    enum Access { ReadOnly, ReadWrite };
+
+    BorrowedValues(const GValue *values, uint count, Access access = ReadOnly);
+    ~BorrowedValues();
+
+    inline uint size() const { return m_count; }
+    inline const Value *constData() const { return m_values; }
+    inline Value & operator[](uint i) { return m_values[i]; }
+    inline const Value & operator[](uint i) const { return m_values[i]; }
+
+private:
+    Q_DISABLE_COPY(BorrowedValues)
+
+    enum { PreallocCount = 8 };
+
+    template <typename T>
+    union Storage
+    {
+        char bytes[PreallocCount * sizeof(T)];
+        double alignment1;
+        qint64 alignment2;
+        void *alignment3;
+    };
+
+    uint m_count;
+    Access m_access;
+    Value::Data *m_data;
+    Value *m_values;
+    Storage<Value::Data> m_dataStorage;
+    Storage<Value> m_valueStorage;
+};
+
+} //namespace Private
+} //namespace QGlib
+
+#endif
@@ -17,29 +17,55 @@
 */
 #include "refpointer.h"
 #include "quark.h"
+#include "typecache_p.h"
 #include <glib-object.h>
 
 namespace QGlib {
+namespace Private {
+
+typedef RefCountedObject *(*WrapperConstructor)(void*);
+typedef TypeCache<WrapperConstructor> WrapperConstructorCache;
+typedef TypeCache<Quark> InterfaceQuarkCache;
+
+Q_GLOBAL_STATIC(WrapperConstructorCache, s_wrapperConstructors)
+Q_GLOBAL_STATIC(InterfaceQuarkCache, s_interfaceQuarks)
+
+void invalidateWrapperConstructorCache()
+{
+    s_wrapperConstructors()->clear();
+}
+
+} //namespace Private
+
 
 RefCountedObject *constructWrapper(Type instanceType, void *instance)
 {
-    Quark q = g_quark_from_static_string("QGlib__wrapper_constructor");
-    RefCountedObject *cppClass = NULL;
-
-    for(Type t = instanceType; t.isValid(); t = t.parent()) {
-        void *funcPtr = t.quarkData(q);
-        if (funcPtr) {
-            cppClass = (reinterpret_cast<RefCountedObject *(*)(void*)>(funcPtr))(instance);
-            Q_ASSERT_X(cppClass, "QGlib::constructWrapper",
-                       "Failed to wrap instance. This is a bug in the bindings library.");
-            return cppClass;
+    Private::WrapperConstructor constructor = NULL;
+
+    if (!Private::s_wrapperConstructors()->find(instanceType, &constructor)) {
+        Quark q = g_quark_from_static_string("QGlib__wrapper_constructor");
+
+        for(Type t = instanceType; t.isValid(); t = t.parent()) {
+            void *funcPtr = t.quarkData(q);
+            if (funcPtr) {
+                constructor = reinterpret_cast<Private::WrapperConstructor>(funcPtr);
+                Private::s_wrapperConstructors()->insert(instanceType, constructor);
+                break;
+            }
         }
     }
 
+    if (constructor) {
+        RefCountedObject *cppClass = constructor(instance);
+        Q_ASSERT_X(cppClass, "QGlib::constructWrapper",
+                   "Failed to wrap instance. This is a bug in the bindings library.");
+        return cppClass;
+    }
+
     Q_ASSERT_X(false, "QGlib::constructWrapper",
                QString(QLatin1String("No wrapper constructor found for this type (") +
                        instanceType.name() + QLatin1String("). Did you forget to call init()?.")).toUtf8());
-    return cppClass;
+    return NULL;
 }
 
 namespace Private {
@@ -83,7 +109,11 @@ RefCountedObject *wrapInterface(Type interfaceType, void *gobject)
 {
     Q_ASSERT(gobject);
 
-    Quark q = Quark::fromString(QLatin1String("QGlib__interface_wrapper__") + interfaceType.name());
+    Quark q;
+    if (!s_interfaceQuarks()->find(interfaceType, &q)) {
+        q = Quark::fromString(QLatin1String("QGlib__interface_wrapper__") + interfaceType.name());
+        s_interfaceQuarks()->insert(interfaceType, q);
+    }
     RefCountedObject *obj = static_cast<RefCountedObject*>(g_object_get_qdata(G_OBJECT(gobject), q));
 
     if (!obj) {
@@ -69,6 +69,11 @@ QTGLIB_EXPORT RefCountedObject *wrapObject(void *gobject);
 QTGLIB_EXPORT RefCountedObject *wrapParamSpec(void *param);
 QTGLIB_EXPORT RefCountedObject *wrapInterface(Type interfaceType, void *gobject);
 
+/* constructWrapper() remembers the constructor that it finds for each type.
+ * This must be called after registering new wrapper constructors, so that
+ * types that have already been wrapped pick up the new constructors. */
+QTGLIB_EXPORT void invalidateWrapperConstructorCache();
+
 } //namespace Private
 } //namespace QGlib
 
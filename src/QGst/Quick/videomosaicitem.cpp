@@ -0,0 +1,252 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "videomosaicitem.h"
+#include "videosurface_p.h"
+#include <QtCore/QPointer>
+#include <QtCore/qmath.h>
+#include <QtQuick/QSGNode>
+#include <QtQuick/QSGFlatColorMaterial>
+#include "../../QGlib/Signal"
+
+namespace QGst {
+namespace Quick {
+
+struct VideoMosaicItem::Private
+{
+    struct Tile
+    {
+        QPointer<VideoSurface> surface;
+        // the following are only used while painting
+        QSGNode *node;
+        QRectF rect;
+        bool dirty;
+        bool black;
+    };
+
+    QList<Tile> tiles;
+    int columns;
+    // set when tiles are added or removed, to start over with a new root node
+    bool tilesDirty;
+};
+
+VideoMosaicItem::VideoMosaicItem(QQuickItem *parent)
+    : QQuickItem(parent), d(new Private)
+{
+    d->columns = 0;
+    d->tilesDirty = true;
+    setFlag(QQuickItem::ItemHasContents, true);
+}
+
+VideoMosaicItem::~VideoMosaicItem()
+{
+    Q_FOREACH(const Private::Tile & tile, d->tiles) {
+        if (tile.surface) {
+            tile.surface.data()->d->mosaicItems.remove(this);
+        }
+    }
+    delete d;
+}
+
+QList<VideoSurface*> VideoMosaicItem::surfaces() const
+{
+    QList<VideoSurface*> result;
+    Q_FOREACH(const Private::Tile & tile, d->tiles) {
+        result.append(tile.surface.data());
+    }
+    return result;
+}
+
+void VideoMosaicItem::setSurfaces(const QList<VideoSurface*> & surfaces)
+{
+    clearSurfaces();
+    Q_FOREACH(VideoSurface *surface, surfaces) {
+        addSurface(surface);
+    }
+}
+
+void VideoMosaicItem::addSurface(VideoSurface *surface)
+{
+    Private::Tile tile;
+    tile.surface = surface;
+    tile.node = 0;
+    tile.dirty = true;
+    tile.black = false;
+    d->tiles.append(tile);
+    d->tilesDirty = true;
+
+    if (surface) {
+        surface->d->mosaicItems.insert(this);
+    }
+    update();
+}
+
+void VideoMosaicItem::clearSurfaces()
+{
+    Q_FOREACH(const Private::Tile & tile, d->tiles) {
+        if (tile.surface) {
+            tile.surface.data()->d->mosaicItems.remove(this);
+        }
+    }
+    d->tiles.clear();
+    d->tilesDirty = true;
+    update();
+}
+
+int VideoMosaicItem::columns() const
+{
+    return d->columns;
+}
+
+void VideoMosaicItem::setColumns(int columns)
+{
+    columns = qMax(columns, 0);
+    if (columns != d->columns) {
+        d->columns = columns;
+        update();
+        Q_EMIT columnsChanged();
+    }
+}
+
+static void surfacesAppend(QQmlListProperty<VideoSurface> *list, VideoSurface *surface)
+{
+    static_cast<VideoMosaicItem*>(list->object)->addSurface(surface);
+}
+
+static int surfacesCount(QQmlListProperty<VideoSurface> *list)
+{
+    return static_cast<VideoMosaicItem*>(list->object)->surfaces().size();
+}
+
+static VideoSurface *surfacesAt(QQmlListProperty<VideoSurface> *list, int index)
+{
+    return static_cast<VideoMosaicItem*>(list->object)->surfaces().value(index);
+}
+
+static void surfacesClear(QQmlListProperty<VideoSurface> *list)
+{
+    static_cast<VideoMosaicItem*>(list->object)->clearSurfaces();
+}
+
+QQmlListProperty<VideoSurface> VideoMosaicItem::surfacesProperty()
+{
+    return QQmlListProperty<VideoSurface>(this, 0,
+            &surfacesAppend, &surfacesCount, &surfacesAt, &surfacesClear);
+}
+
+void VideoMosaicItem::surfaceUpdated(VideoSurface *surface)
+{
+    for (int i = 0; i < d->tiles.size(); ++i) {
+        if (d->tiles[i].surface.data() == surface) {
+            d->tiles[i].dirty = true;
+        }
+    }
+    update();
+}
+
+void VideoMosaicItem::geometryChanged(const QRectF & newGeometry, const QRectF & oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    update();
+}
+
+QSGNode* VideoMosaicItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data)
+
+    // the nodes of the tiles are children of the root node, so they go with it
+    if (d->tilesDirty) {
+        delete oldNode;
+        oldNode = 0;
+        d->tilesDirty = false;
+    }
+
+    QSGNode *root = oldNode;
+    if (!root) {
+        root = new QSGNode;
+        for (int i = 0; i < d->tiles.size(); ++i) {
+            d->tiles[i].node = 0;
+        }
+    }
+
+    const int count = d->tiles.size();
+    if (!count) {
+        return root;
+    }
+
+    const int columns = d->columns > 0 ? d->columns : qCeil(qSqrt(count));
+    const int rows = (count + columns - 1) / columns;
+    const QRectF r = boundingRect();
+    const qreal tileWidth = r.width() / columns;
+    const qreal tileHeight = r.height() / rows;
+
+    for (int i = 0; i < count; ++i) {
+        Private::Tile & tile = d->tiles[i];
+        const QRectF rect(r.x() + (i % columns) * tileWidth, r.y() + (i / columns) * tileHeight,
+                          tileWidth, tileHeight);
+
+        // tiles without a new frame keep their node as it is
+        if (tile.node && !tile.dirty && rect == tile.rect) {
+            continue;
+        }
+        tile.dirty = false;
+        tile.rect = rect;
+
+        QSGNode *node = 0;
+        if (tile.surface && !tile.surface.data()->d->videoSink.isNull()) {
+            node = (QSGNode*) QGlib::emit<void*>(tile.surface.data()->d->videoSink,
+                    "update-node", (void*)(tile.black ? 0 : tile.node),
+                    rect.x(), rect.y(), rect.width(), rect.height());
+            tile.black = false;
+        } else {
+            QSGGeometryNode *blackNode = static_cast<QSGGeometryNode*>(tile.black ? tile.node : 0);
+            if (!blackNode) {
+                QSGFlatColorMaterial *material = new QSGFlatColorMaterial;
+                material->setColor(Qt::black);
+
+                blackNode = new QSGGeometryNode;
+                blackNode->setMaterial(material);
+                blackNode->setGeometry(
+                        new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 4));
+                blackNode->setFlag(QSGNode::OwnsMaterial);
+                blackNode->setFlag(QSGNode::OwnsGeometry);
+            }
+            QSGGeometry::updateRectGeometry(blackNode->geometry(), rect);
+            blackNode->markDirty(QSGNode::DirtyGeometry);
+
+            node = blackNode;
+            tile.black = true;
+        }
+
+        // a new node takes the place of the old one, to keep the tiles in order
+        if (node != tile.node) {
+            if (tile.node) {
+                root->insertChildNodeBefore(node, tile.node);
+                root->removeChildNode(tile.node);
+                delete tile.node;
+            } else {
+                root->appendChildNode(node);
+            }
+            tile.node = node;
+        }
+    }
+
+    return root;
+}
+
+} // namespace Quick
+} // namespace QGst
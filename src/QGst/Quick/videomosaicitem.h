@@ -0,0 +1,104 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QGST_QUICK_VIDEOMOSAICITEM_H
+#define QGST_QUICK_VIDEOMOSAICITEM_H
+
+#include "videosurface.h"
+#include <QtQuick/QQuickItem>
+#include <QtQml/QQmlListProperty>
+
+namespace QGst {
+namespace Quick {
+
+/*! \headerfile videomosaicitem.h <QGst/Quick/VideoMosaicItem>
+ * \brief A QQuickItem for displaying many videos in a grid
+ *
+ * This is a QQuickItem subclass that displays the video of several
+ * VideoSurface objects, laid out in a grid of equally sized tiles, in the
+ * order of the surfaces property. It is meant for video walls, where using
+ * one VideoItem for each stream makes the scene graph synchronize and
+ * traverse one item per stream.
+ *
+ * All the streams are painted from the paint node of this item, and the
+ * node of a tile is only updated when its surface has a new frame to show
+ * or when the layout of the grid changes.
+ *
+ * Example:
+ * \code
+ * // in your C++ code
+ * view->rootContext()->setContextProperty(QLatin1String("camera1"), surface1);
+ * view->rootContext()->setContextProperty(QLatin1String("camera2"), surface2);
+ * ...
+ * // and in your qml file:
+ * VideoMosaicItem {
+ *      anchors.fill: parent
+ *      columns: 2
+ *      surfaces: [ camera1, camera2 ]
+ * }
+ * \endcode
+ *
+ * \note A surface shows new frames only on the first item that it is
+ * painted on, so every surface should appear once, on a single item.
+ *
+ * \sa VideoSurface, VideoItem
+ */
+class QTGSTREAMERQUICK_EXPORT VideoMosaicItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(VideoMosaicItem)
+    Q_PROPERTY(QQmlListProperty<QGst::Quick::VideoSurface> surfaces READ surfacesProperty)
+    Q_PROPERTY(int columns READ columns WRITE setColumns NOTIFY columnsChanged)
+
+public:
+    explicit VideoMosaicItem(QQuickItem *parent = 0);
+    virtual ~VideoMosaicItem();
+
+    QList<VideoSurface*> surfaces() const;
+    void setSurfaces(const QList<VideoSurface*> & surfaces);
+    void addSurface(VideoSurface *surface);
+    void clearSurfaces();
+
+    /*! The number of columns of the grid. If it is 0, which is the default,
+     * the grid is made as square as possible for the number of surfaces. */
+    int columns() const;
+    void setColumns(int columns);
+
+    QQmlListProperty<VideoSurface> surfacesProperty();
+
+Q_SIGNALS:
+    void columnsChanged();
+
+protected:
+    /*! Reimplemented from QQuickItem. */
+    virtual QSGNode* updatePaintNode(QSGNode *oldNode,
+                                     UpdatePaintNodeData *updatePaintNodeData);
+    /*! Reimplemented from QQuickItem. */
+    virtual void geometryChanged(const QRectF & newGeometry, const QRectF & oldGeometry);
+
+private:
+    friend class VideoSurface;
+    QTGSTREAMERQUICK_NO_EXPORT void surfaceUpdated(VideoSurface *surface);
+
+    struct Private;
+    Private *const d;
+};
+
+} // namespace Quick
+} // namespace QGst
+
+#endif // QGST_QUICK_VIDEOMOSAICITEM_H
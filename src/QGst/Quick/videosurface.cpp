@@ -33,6 +33,11 @@ VideoSurface::VideoSurface(QObject *parent)
 
 VideoSurface::~VideoSurface()
 {
+    // the tiles that show this surface must drop its last frame and turn black
+    Q_FOREACH(VideoMosaicItem *item, d->mosaicItems) {
+        item->surfaceUpdated(this);
+    }
+
     if (!d->videoSink.isNull()) {
         d->videoSink->setState(QGst::StateNull);
     }
@@ -64,6 +69,9 @@ void VideoSurface::onUpdate()
     Q_FOREACH(QQuickItem *item, d->items) {
         item->update();
     }
+    Q_FOREACH(VideoMosaicItem *item, d->mosaicItems) {
+        item->surfaceUpdated(this);
+    }
 }
 
 } // namespace Quick
@@ -73,6 +73,7 @@ protected:
 
 private:
     friend class VideoItem;
+    friend class VideoMosaicItem;
     VideoSurfacePrivate * const d;
 };
 
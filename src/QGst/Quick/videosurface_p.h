@@ -20,6 +20,7 @@
 
 #include "videosurface.h"
 #include "videoitem.h"
+#include "videomosaicitem.h"
 
 namespace QGst {
 namespace Quick {
@@ -28,6 +29,7 @@ class QTGSTREAMERQUICK_NO_EXPORT VideoSurfacePrivate
 {
 public:
     QSet<VideoItem*> items;
+    QSet<VideoMosaicItem*> mosaicItems;
     ElementPtr videoSink;
 };
 
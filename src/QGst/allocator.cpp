@@ -111,6 +111,19 @@ AllocatorPtr Allocator::getSystemMemory()
     return find(GST_ALLOCATOR_SYSMEM);
 }
 
+//static
+void Allocator::registerAllocator(const char *name, const AllocatorPtr & allocator)
+{
+    //both functions take the reference that is passed to them
+    gst_allocator_register(name, static_cast<GstAllocator*>(gst_object_ref(allocator)));
+}
+
+//static
+void Allocator::setDefault(const AllocatorPtr & allocator)
+{
+    gst_allocator_set_default(static_cast<GstAllocator*>(gst_object_ref(allocator)));
+}
+
 MemoryPtr Allocator::alloc(size_t size, const AllocationParams & params)
 {
     return MemoryPtr::wrap(gst_allocator_alloc(object<GstAllocator>(), size,
@@ -71,6 +71,12 @@ public:
     /*! get the system memory allocator */
     static AllocatorPtr getSystemMemory();
 
+    /*! register \a allocator under \a name, so that it can be found with find() */
+    static void registerAllocator(const char *name, const AllocatorPtr & allocator);
+    /*! make \a allocator the default allocator, which is used by all the
+     * elements that do not negotiate one with an AllocationQuery */
+    static void setDefault(const AllocatorPtr & allocator);
+
     /*! create a chunk of memory using this allocator */
     MemoryPtr alloc(size_t size, const AllocationParams &params = AllocationParams());
     /*! release memory allocated with alloc()
@@ -0,0 +1,450 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "allocatorimpl.h"
+#include <QtCore/QDebug>
+#include <cstring>
+#include <gst/gst.h>
+
+#if defined(Q_OS_LINUX)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# ifndef MFD_CLOEXEC
+#  define MFD_CLOEXEC 0x0001U
+# endif
+#endif
+
+namespace QGst {
+namespace Private {
+
+#ifndef DOXYGEN_RUN
+
+/* The memory of the allocators that are implemented in C++. Memory that is
+ * shared from another one points to the same data and has no block. */
+struct ImplMemory
+{
+    GstMemory memory;
+    guint8 *data;
+    void *block;
+    size_t blockSize;
+};
+
+struct ImplAllocator
+{
+    GstAllocator parent;
+    AllocatorImpl *impl;
+};
+
+struct ImplAllocatorClass
+{
+    GstAllocatorClass parent;
+};
+
+static GstAllocatorClass *s_parentClass = NULL;
+
+struct AllocatorImplAccess
+{
+    static inline AllocatorImpl *impl(GstAllocator *allocator)
+    {
+        return reinterpret_cast<ImplAllocator*>(allocator)->impl;
+    }
+
+    static GstMemory *alloc(GstAllocator *allocator, gsize size, GstAllocationParams *params)
+    {
+        //room for the prefix, the padding and for aligning the start of the data
+        const gsize maxSize = size + params->prefix + params->padding;
+        const gsize blockSize = maxSize + params->align;
+
+        void *block = impl(allocator)->allocBlock(blockSize);
+        if (!block) {
+            return NULL;
+        }
+
+        guint8 *data = static_cast<guint8*>(block);
+        gsize alignOffset = reinterpret_cast<guintptr>(data) & params->align;
+        if (alignOffset) {
+            data += params->align + 1 - alignOffset;
+        }
+
+        ImplMemory *memory = g_slice_new(ImplMemory);
+        memory->data = data;
+        memory->block = block;
+        memory->blockSize = blockSize;
+        gst_memory_init(GST_MEMORY_CAST(memory), static_cast<GstMemoryFlags>(params->flags),
+                        allocator, NULL, maxSize, params->align, params->prefix, size);
+
+        if (params->prefix && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED)) {
+            memset(data, 0, params->prefix);
+        }
+        if (params->padding && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED)) {
+            memset(data + params->prefix + size, 0, params->padding);
+        }
+        return GST_MEMORY_CAST(memory);
+    }
+
+    static void free(GstAllocator *allocator, GstMemory *gstMemory)
+    {
+        ImplMemory *memory = reinterpret_cast<ImplMemory*>(gstMemory);
+        if (memory->block) {
+            impl(allocator)->freeBlock(memory->block, memory->blockSize);
+        }
+        g_slice_free(ImplMemory, memory);
+    }
+
+    static gpointer map(GstMemory *memory, gsize maxSize, GstMapFlags flags)
+    {
+        Q_UNUSED(maxSize);
+        Q_UNUSED(flags);
+        return reinterpret_cast<ImplMemory*>(memory)->data;
+    }
+
+    static void unmap(GstMemory *memory)
+    {
+        Q_UNUSED(memory);
+    }
+
+    static GstMemory *share(GstMemory *gstMemory, gssize offset, gssize size)
+    {
+        ImplMemory *memory = reinterpret_cast<ImplMemory*>(gstMemory);
+        GstMemory *parent = gstMemory->parent ? gstMemory->parent : gstMemory;
+        if (size == -1) {
+            size = gstMemory->size - offset;
+        }
+
+        ImplMemory *sub = g_slice_new(ImplMemory);
+        sub->data = memory->data;
+        sub->block = NULL;
+        sub->blockSize = 0;
+        gst_memory_init(GST_MEMORY_CAST(sub),
+                        static_cast<GstMemoryFlags>(GST_MINI_OBJECT_FLAGS(parent)
+                                                    | GST_MINI_OBJECT_FLAG_LOCK_READONLY),
+                        gstMemory->allocator, parent, gstMemory->maxsize, gstMemory->align,
+                        gstMemory->offset + offset, size);
+        return GST_MEMORY_CAST(sub);
+    }
+
+    static gboolean isSpan(GstMemory *memory1, GstMemory *memory2, gsize *offset)
+    {
+        guint8 *data1 = reinterpret_cast<ImplMemory*>(memory1)->data;
+        guint8 *data2 = reinterpret_cast<ImplMemory*>(memory2)->data;
+        if (offset) {
+            *offset = memory1->offset - memory1->parent->offset;
+        }
+        return data1 + memory1->offset + memory1->size == data2 + memory2->offset;
+    }
+
+    static void finalize(GObject *object)
+    {
+        ImplAllocator *allocator = reinterpret_cast<ImplAllocator*>(object);
+        delete allocator->impl;
+        allocator->impl = NULL;
+        G_OBJECT_CLASS(s_parentClass)->finalize(object);
+    }
+
+    static void classInit(gpointer gClass, gpointer classData)
+    {
+        Q_UNUSED(classData);
+        s_parentClass = GST_ALLOCATOR_CLASS(g_type_class_peek_parent(gClass));
+        G_OBJECT_CLASS(gClass)->finalize = &finalize;
+
+        GstAllocatorClass *allocatorClass = GST_ALLOCATOR_CLASS(gClass);
+        allocatorClass->alloc = &alloc;
+        allocatorClass->free = &AllocatorImplAccess::free;
+    }
+
+    static void instanceInit(GTypeInstance *instance, gpointer gClass)
+    {
+        Q_UNUSED(gClass);
+        GstAllocator *allocator = GST_ALLOCATOR_CAST(instance);
+        allocator->mem_map = &map;
+        allocator->mem_unmap = &unmap;
+        allocator->mem_share = &share;
+        allocator->mem_is_span = &isSpan;
+        reinterpret_cast<ImplAllocator*>(instance)->impl = NULL;
+    }
+
+    static GType type()
+    {
+        static volatile gsize gonce_data = 0;
+        if (g_once_init_enter(&gonce_data)) {
+            GTypeInfo info;
+            memset(&info, 0, sizeof(GTypeInfo));
+            info.class_size = sizeof(ImplAllocatorClass);
+            info.class_init = &classInit;
+            info.instance_size = sizeof(ImplAllocator);
+            info.instance_init = &instanceInit;
+
+            GType type = g_type_register_static(GST_TYPE_ALLOCATOR, "QGstAllocatorImpl",
+                                                &info, static_cast<GTypeFlags>(0));
+            g_once_init_leave(&gonce_data, type);
+        }
+        return gonce_data;
+    }
+
+    static AllocatorPtr create(AllocatorImpl *impl)
+    {
+        GstAllocator *allocator = GST_ALLOCATOR_CAST(g_object_new(type(), NULL));
+        gst_object_ref_sink(allocator);
+
+        allocator->mem_type = impl->m_memoryType.constData();
+        reinterpret_cast<ImplAllocator*>(allocator)->impl = impl;
+        impl->m_allocator = allocator;
+        return AllocatorPtr::wrap(allocator, false);
+    }
+};
+
+#endif //DOXYGEN_RUN
+
+} //namespace Private
+
+//BEGIN ******** AllocatorImpl ********
+
+AllocatorImpl::AllocatorImpl(const char *memoryType)
+    : m_memoryType(memoryType), m_allocator(NULL)
+{
+}
+
+AllocatorImpl::~AllocatorImpl()
+{
+}
+
+AllocatorPtr AllocatorImpl::allocator() const
+{
+    return AllocatorPtr::wrap(m_allocator);
+}
+
+//static
+AllocatorImpl *AllocatorImpl::fromAllocator(const AllocatorPtr & allocator)
+{
+    GstAllocator *gstAllocator = allocator;
+    if (!gstAllocator || !G_TYPE_CHECK_INSTANCE_TYPE(gstAllocator,
+                                                     Private::AllocatorImplAccess::type())) {
+        return NULL;
+    }
+    return Private::AllocatorImplAccess::impl(gstAllocator);
+}
+
+//static
+AllocatorPtr AllocatorImpl::create(AllocatorImpl *impl)
+{
+    if (!impl || impl->m_allocator) {
+        qWarning() << "QGst::AllocatorImpl::create: the implementation is null or already in use";
+        return AllocatorPtr();
+    }
+    return Private::AllocatorImplAccess::create(impl);
+}
+
+void *AllocatorImpl::blockOf(const MemoryPtr & memory, size_t *offset) const
+{
+    GstMemory *gstMemory = memory;
+    if (!gstMemory || gstMemory->allocator != m_allocator) {
+        return NULL;
+    }
+
+    Private::ImplMemory *root = reinterpret_cast<Private::ImplMemory*>(
+            gstMemory->parent ? gstMemory->parent : gstMemory);
+    if (offset) {
+        *offset = (root->data - static_cast<guint8*>(root->block)) + gstMemory->offset;
+    }
+    return root->block;
+}
+
+//END ******** AllocatorImpl ********
+//BEGIN ******** ArenaAllocator ********
+
+ArenaAllocator::ArenaAllocator(size_t blockSize, uint blocksPerSlab)
+    : AllocatorImpl("QGstArenaMemory"),
+      //keep the blocks aligned for the free list links
+      m_blockSize((qMax(blockSize, sizeof(FreeBlock)) + 15) & ~size_t(15)),
+      m_blocksPerSlab(qMax(blocksPerSlab, 1u)),
+      m_freeList(NULL)
+{
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    Q_FOREACH(void *slab, m_slabs) {
+        g_free(slab);
+    }
+}
+
+uint ArenaAllocator::blockCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_slabs.size() * m_blocksPerSlab;
+}
+
+void *ArenaAllocator::allocBlock(size_t size)
+{
+    if (size > m_blockSize) {
+        return g_try_malloc(size);
+    }
+
+    QMutexLocker lock(&m_mutex);
+    if (!m_freeList) {
+        guint8 *slab = static_cast<guint8*>(g_try_malloc(m_blockSize * m_blocksPerSlab));
+        if (!slab) {
+            return NULL;
+        }
+        m_slabs.append(slab);
+
+        //carve the slab in blocks, keeping them in address order
+        for (uint i = m_blocksPerSlab; i > 0; --i) {
+            FreeBlock *block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * m_blockSize);
+            block->next = m_freeList;
+            m_freeList = block;
+        }
+    }
+
+    FreeBlock *block = m_freeList;
+    m_freeList = block->next;
+    return block;
+}
+
+void ArenaAllocator::freeBlock(void *block, size_t size)
+{
+    if (size > m_blockSize) {
+        g_free(block);
+        return;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    FreeBlock *freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = m_freeList;
+    m_freeList = freeBlock;
+}
+
+//END ******** ArenaAllocator ********
+//BEGIN ******** HugePageAllocator ********
+
+HugePageAllocator::HugePageAllocator(size_t hugePageSize)
+    : AllocatorImpl("QGstHugePageMemory"),
+      m_hugePageSize(hugePageSize)
+{
+}
+
+size_t HugePageAllocator::mappedSize(size_t size) const
+{
+    return (size + m_hugePageSize - 1) / m_hugePageSize * m_hugePageSize;
+}
+
+void *HugePageAllocator::allocBlock(size_t size)
+{
+#if defined(Q_OS_LINUX)
+    const size_t length = mappedSize(size);
+    void *block = MAP_FAILED;
+# ifdef MAP_HUGETLB
+    block = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+# endif
+    if (block == MAP_FAILED) {
+        //no huge pages are reserved; ask for transparent ones instead
+        block = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED) {
+            return NULL;
+        }
+# ifdef MADV_HUGEPAGE
+        madvise(block, length, MADV_HUGEPAGE);
+# endif
+    }
+    return block;
+#else
+    return g_try_malloc(size);
+#endif
+}
+
+void HugePageAllocator::freeBlock(void *block, size_t size)
+{
+#if defined(Q_OS_LINUX)
+    munmap(block, mappedSize(size));
+#else
+    Q_UNUSED(size);
+    g_free(block);
+#endif
+}
+
+//END ******** HugePageAllocator ********
+//BEGIN ******** MemfdAllocator ********
+
+MemfdAllocator::MemfdAllocator()
+    : AllocatorImpl("QGstMemfdMemory")
+{
+}
+
+//static
+int MemfdAllocator::fileDescriptor(const MemoryPtr & memory, size_t *offset)
+{
+    if (!memory) {
+        return -1;
+    }
+
+    MemfdAllocator *impl = dynamic_cast<MemfdAllocator*>(fromAllocator(memory->allocator()));
+    void *block = impl ? impl->blockOf(memory, offset) : NULL;
+    if (!block) {
+        return -1;
+    }
+
+    QMutexLocker lock(&impl->m_mutex);
+    return impl->m_descriptors.value(block, -1);
+}
+
+void *MemfdAllocator::allocBlock(size_t size)
+{
+#if defined(Q_OS_LINUX) && defined(__NR_memfd_create)
+    int fd = syscall(__NR_memfd_create, "qgst-memfd", MFD_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    void *block = MAP_FAILED;
+    if (ftruncate(fd, size) == 0) {
+        block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (block == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    m_descriptors.insert(block, fd);
+    return block;
+#else
+    Q_UNUSED(size);
+    qWarning() << "QGst::MemfdAllocator: memfd_create() is not available on this system";
+    return NULL;
+#endif
+}
+
+void MemfdAllocator::freeBlock(void *block, size_t size)
+{
+#if defined(Q_OS_LINUX) && defined(__NR_memfd_create)
+    int fd;
+    {
+        QMutexLocker lock(&m_mutex);
+        fd = m_descriptors.take(block);
+    }
+    munmap(block, size);
+    close(fd);
+#else
+    Q_UNUSED(block);
+    Q_UNUSED(size);
+#endif
+}
+
+//END ******** MemfdAllocator ********
+
+} //namespace QGst
@@ -0,0 +1,186 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_ALLOCATORIMPL_H
+#define QGST_ALLOCATORIMPL_H
+
+#include "allocator.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+
+namespace QGst {
+
+namespace Private {
+    struct AllocatorImplAccess;
+}
+
+/*! \headerfile allocatorimpl.h <QGst/AllocatorImpl>
+ * \brief Base class for the implementation of allocators in C++
+ *
+ * An allocator is implemented by subclassing AllocatorImpl and reimplementing
+ * allocBlock() and freeBlock(), which provide the raw blocks of memory. The
+ * GstMemory objects around the blocks, their alignment, prefix and padding,
+ * mapping and sharing are handled by this class. The subclass is then turned
+ * into an Allocator with create(), which takes ownership of it:
+ * \code
+ * QGst::AllocatorPtr allocator = QGst::AllocatorImpl::create(new QGst::ArenaAllocator(4096));
+ * QGst::BufferPtr buffer = QGst::Buffer::create(1024, allocator);
+ * \endcode
+ *
+ * To make a pipeline allocate its buffers from such an allocator, add it to the
+ * AllocationQuery that upstream elements send, for example from a pad probe on
+ * the sink pad of the last element or from SinkImpl::proposeAllocation(). It can
+ * also be made available by name with Allocator::registerAllocator(), or be used
+ * by all the elements that do not negotiate an allocator with Allocator::setDefault().
+ *
+ * allocBlock() and freeBlock() may be called from any thread.
+ */
+class QTGSTREAMER_EXPORT AllocatorImpl
+{
+public:
+    virtual ~AllocatorImpl();
+
+    /*! Returns the allocator that this object implements, or
+     * a null pointer if it has not been passed to create() yet. */
+    AllocatorPtr allocator() const;
+
+    /*! Returns the implementation of \a allocator, or NULL
+     * if it was not created with create(). */
+    static AllocatorImpl *fromAllocator(const AllocatorPtr & allocator);
+
+    /*! Creates an allocator that is implemented by \a impl. The allocator takes
+     * ownership of \a impl, which is deleted when the allocator is finalized. */
+    static AllocatorPtr create(AllocatorImpl *impl);
+
+protected:
+    /*! \a memoryType is the type of the memory that the allocator produces,
+     * which is used by Memory::isType(). */
+    explicit AllocatorImpl(const char *memoryType);
+
+    /*! Returns a block of at least \a size bytes, or NULL on failure. */
+    virtual void *allocBlock(size_t size) = 0;
+
+    /*! Frees \a block, which was returned by allocBlock() with \a size. */
+    virtual void freeBlock(void *block, size_t size) = 0;
+
+    /*! Returns the block that \a memory, or the memory that it was shared
+     * from, was allocated in, or NULL if it does not come from this allocator.
+     * If \a offset is not NULL, the offset of the data of \a memory in
+     * the block is stored there. */
+    void *blockOf(const MemoryPtr & memory, size_t *offset = NULL) const;
+
+private:
+    Q_DISABLE_COPY(AllocatorImpl)
+    friend struct Private::AllocatorImplAccess;
+
+    QByteArray m_memoryType;
+    GstAllocator *m_allocator;
+};
+
+/*! \headerfile allocatorimpl.h <QGst/AllocatorImpl>
+ * \brief An allocator that hands out fixed-size blocks from preallocated slabs
+ *
+ * Blocks of up to blockSize bytes, including the alignment, prefix and
+ * padding of the memory, are taken from slabs of \a blocksPerSlab blocks and
+ * are returned to a free list when the memory is freed, so that streams of
+ * equally sized payloads do not go through malloc for every buffer. Larger
+ * requests fall back to the system heap. The slabs are only released when
+ * the allocator is destroyed.
+ */
+class QTGSTREAMER_EXPORT ArenaAllocator : public AllocatorImpl
+{
+public:
+    explicit ArenaAllocator(size_t blockSize, uint blocksPerSlab = 16);
+    virtual ~ArenaAllocator();
+
+    size_t blockSize() const { return m_blockSize; }
+    /*! Returns the number of blocks that have been carved out of slabs so far. */
+    uint blockCount() const;
+
+protected:
+    virtual void *allocBlock(size_t size);
+    virtual void freeBlock(void *block, size_t size);
+
+private:
+    struct FreeBlock { FreeBlock *next; };
+
+    size_t m_blockSize;
+    uint m_blocksPerSlab;
+    mutable QMutex m_mutex;
+    FreeBlock *m_freeList;
+    QList<void*> m_slabs;
+};
+
+/*! \headerfile allocatorimpl.h <QGst/AllocatorImpl>
+ * \brief An allocator that backs its memory with huge pages
+ *
+ * Every block is mapped separately and rounded up to a multiple of the huge
+ * page size, so this is meant for large payloads such as raw video frames,
+ * where it reduces the TLB misses of the elements that process them. Explicit
+ * huge pages (MAP_HUGETLB) are used if the system has reserved some, and
+ * transparent huge pages are requested otherwise. On systems other than Linux
+ * the memory comes from the system heap.
+ */
+class QTGSTREAMER_EXPORT HugePageAllocator : public AllocatorImpl
+{
+public:
+    explicit HugePageAllocator(size_t hugePageSize = 2 * 1024 * 1024);
+
+    size_t hugePageSize() const { return m_hugePageSize; }
+
+protected:
+    virtual void *allocBlock(size_t size);
+    virtual void freeBlock(void *block, size_t size);
+
+private:
+    size_t mappedSize(size_t size) const;
+
+    size_t m_hugePageSize;
+};
+
+/*! \headerfile allocatorimpl.h <QGst/AllocatorImpl>
+ * \brief An allocator whose memory can be shared with other processes
+ *
+ * Every block lives in its own anonymous file, created with memfd_create(),
+ * whose descriptor can be passed to another process, for example over a
+ * unix socket, which can then map the same memory without copying it.
+ * This is only available on Linux 3.17 and later; elsewhere, allocations fail.
+ */
+class QTGSTREAMER_EXPORT MemfdAllocator : public AllocatorImpl
+{
+public:
+    MemfdAllocator();
+
+    /*! Returns the file descriptor of the file that holds \a memory, or -1
+     * if \a memory was not allocated by a MemfdAllocator. If \a offset is
+     * not NULL, the offset of the data of \a memory in the file is stored there.
+     * The descriptor belongs to the memory and is closed when it is freed. */
+    static int fileDescriptor(const MemoryPtr & memory, size_t *offset = NULL);
+
+protected:
+    virtual void *allocBlock(size_t size);
+    virtual void freeBlock(void *block, size_t size);
+
+private:
+    mutable QMutex m_mutex;
+    QHash<void*, int> m_descriptors;
+};
+
+} //namespace QGst
+
+#endif // QGST_ALLOCATORIMPL_H
@@ -18,6 +18,8 @@
 #include "buffer.h"
 #include "caps.h"
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <cstring>
 #include <gst/gst.h>
 
 namespace QGst {
@@ -28,6 +30,85 @@ BufferPtr Buffer::create(uint size)
     return BufferPtr::wrap(gst_buffer_new_allocate(NULL, size, NULL), false);
 }
 
+BufferPtr Buffer::create(uint size, const AllocatorPtr & allocator,
+                         const AllocationParams & params)
+{
+    return BufferPtr::wrap(gst_buffer_new_allocate(allocator, size,
+            const_cast<GstAllocationParams*>(static_cast<const GstAllocationParams*>(params))),
+            false);
+}
+
+static void destroyByteArray(void *userData)
+{
+    delete static_cast<QByteArray*>(userData);
+}
+
+BufferPtr Buffer::fromByteArray(const QByteArray & data)
+{
+    //the copy shares the data with the original QByteArray
+    QByteArray *shared = new QByteArray(data);
+    gpointer ptr = const_cast<char*>(shared->constData());
+
+    return BufferPtr::wrap(gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, ptr,
+                                                       shared->size(), 0, shared->size(),
+                                                       shared, &destroyByteArray), false);
+}
+
+namespace {
+
+//the file is kept open for as long as the region is mapped
+struct MappedFile
+{
+    QFile file;
+    uchar *data;
+};
+
+} //anonymous namespace
+
+static void destroyMappedFile(void *userData)
+{
+    MappedFile *mapped = static_cast<MappedFile*>(userData);
+    mapped->file.unmap(mapped->data);
+    delete mapped;
+}
+
+BufferPtr Buffer::fromMappedFile(const QString & fileName, qint64 offset, qint64 size)
+{
+    MappedFile *mapped = new MappedFile;
+    mapped->file.setFileName(fileName);
+
+    if (!mapped->file.open(QIODevice::ReadOnly)) {
+        qWarning() << "QGst::Buffer::fromMappedFile: Could not open" << fileName
+                   << ":" << mapped->file.errorString();
+        delete mapped;
+        return BufferPtr();
+    }
+
+    if (size < 0) {
+        size = mapped->file.size() - offset;
+    }
+
+    mapped->data = size > 0 ? mapped->file.map(offset, size) : NULL;
+    if (!mapped->data) {
+        qWarning() << "QGst::Buffer::fromMappedFile: Could not map" << fileName
+                   << ":" << mapped->file.errorString();
+        delete mapped;
+        return BufferPtr();
+    }
+
+    return BufferPtr::wrap(gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, mapped->data,
+                                                       size, 0, size,
+                                                       mapped, &destroyMappedFile), false);
+}
+
+BufferPtr Buffer::fromData(void *data, uint size, void (*destroyNotify)(void*),
+                           void *userData, bool readOnly)
+{
+    GstMemoryFlags flags = readOnly ? GST_MEMORY_FLAG_READONLY : static_cast<GstMemoryFlags>(0);
+    return BufferPtr::wrap(gst_buffer_new_wrapped_full(flags, data, size, 0, size,
+                                                       userData, destroyNotify), false);
+}
+
 quint32 Buffer::size() const
 {
     return gst_buffer_get_size(object<GstBuffer>());
@@ -107,4 +188,72 @@ void Buffer::unmap(MapInfo &info)
     gst_buffer_unmap(object<GstBuffer>(), static_cast<GstMapInfo *>(info.m_object));
 }
 
+//********************************************************
+
+QGLIB_STATIC_ASSERT(sizeof(GstMapInfo) <= sizeof(void*[16]),
+                    "MappedBuffer::m_info is too small to hold a GstMapInfo");
+
+MappedBuffer::MappedBuffer(const BufferPtr & buffer, MapFlags flags)
+    : m_buffer(NULL)
+{
+    GstMapInfo *info = reinterpret_cast<GstMapInfo*>(m_info);
+    memset(info, 0, sizeof(GstMapInfo));
+
+    if (buffer && gst_buffer_map(buffer, info, static_cast<GstMapFlags>(static_cast<int>(flags)))) {
+        //taken after mapping, so that a buffer mapped for writing is still writable
+        m_buffer = gst_buffer_ref(buffer);
+    }
+}
+
+#ifndef BOOST_NO_RVALUE_REFERENCES
+MappedBuffer::MappedBuffer(MappedBuffer && other)
+    : m_buffer(other.m_buffer)
+{
+    memcpy(m_info, other.m_info, sizeof(m_info));
+    memset(other.m_info, 0, sizeof(other.m_info));
+    other.m_buffer = NULL;
+}
+#endif
+
+MappedBuffer::~MappedBuffer()
+{
+    if (m_buffer) {
+        GstBuffer *buffer = static_cast<GstBuffer*>(m_buffer);
+        gst_buffer_unmap(buffer, reinterpret_cast<GstMapInfo*>(m_info));
+        gst_buffer_unref(buffer);
+    }
+}
+
+bool MappedBuffer::isValid() const
+{
+    return m_buffer != NULL;
+}
+
+MapFlags MappedBuffer::flags() const
+{
+    return static_cast<MapFlag>(reinterpret_cast<const GstMapInfo*>(m_info)->flags);
+}
+
+quint8 *MappedBuffer::data() const
+{
+    return reinterpret_cast<const GstMapInfo*>(m_info)->data;
+}
+
+const quint8 *MappedBuffer::constData() const
+{
+    return reinterpret_cast<const GstMapInfo*>(m_info)->data;
+}
+
+size_t MappedBuffer::size() const
+{
+    return reinterpret_cast<const GstMapInfo*>(m_info)->size;
+}
+
+QByteArray MappedBuffer::byteArrayView() const
+{
+    const GstMapInfo *info = reinterpret_cast<const GstMapInfo*>(m_info);
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(info->data),
+                                   static_cast<int>(info->size));
+}
+
 } //namespace QGst
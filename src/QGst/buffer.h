@@ -21,6 +21,7 @@
 #include "miniobject.h"
 #include "clocktime.h"
 #include "memory.h"
+#include "allocator.h"
 
 namespace QGst {
 
@@ -37,6 +38,33 @@ class QTGSTREAMER_EXPORT Buffer : public MiniObject
     QGST_WRAPPER(Buffer)
 public:
     static BufferPtr create(uint size);
+    /*! Creates a buffer of \a size bytes whose memory is allocated by \a allocator
+     * with \a params. A null \a allocator selects the default allocator. */
+    static BufferPtr create(uint size, const AllocatorPtr & allocator,
+                            const AllocationParams & params = AllocationParams());
+
+    /*! Creates a read-only buffer that wraps the contents of \a data without copying them.
+     * The buffer keeps a shallow copy of \a data, so the contents remain valid for as
+     * long as the buffer exists, even if the original QByteArray is modified or destroyed.
+     */
+    static BufferPtr fromByteArray(const QByteArray & data);
+
+    /*! Creates a read-only buffer that wraps a memory-mapped region of the file
+     * \a fileName, starting at \a offset and having \a size bytes. If \a size is -1,
+     * the region extends to the end of the file. The file is unmapped when the buffer
+     * is destroyed. Returns a null BufferPtr if the file could not be mapped.
+     */
+    static BufferPtr fromMappedFile(const QString & fileName, qint64 offset = 0, qint64 size = -1);
+
+    /*! Creates a buffer that wraps \a size bytes of \a data without copying them.
+     * The memory must remain valid until \a destroyNotify is called with \a userData,
+     * which happens when the buffer and all the buffers that share its memory have
+     * been destroyed. If \a readOnly is true, elements will never write to \a data
+     * and will copy it if they need to modify the buffer.
+     */
+    static BufferPtr fromData(void *data, uint size,
+                              void (*destroyNotify)(void *userData) = NULL,
+                              void *userData = NULL, bool readOnly = false);
 
     quint32 size() const;
 
@@ -69,6 +97,55 @@ BufferPtr Buffer::makeWritable() const
     return MiniObject::makeWritable().staticCast<Buffer>();
 }
 
+/*! \headerfile buffer.h <QGst/Buffer>
+ * \brief Maps a Buffer for as long as it exists
+ *
+ * MappedBuffer maps the whole of the buffer that it is given in its constructor
+ * and unmaps it when it goes out of scope, without allocating anything:
+ * \code
+ * QGst::MappedBuffer mapped(buffer);
+ * if (mapped.isValid()) {
+ *     parse(mapped.constData(), mapped.size());
+ * }
+ * \endcode
+ *
+ * If the buffer consists of several memories, mapping all of them at once
+ * merges them into a newly allocated one. Use MappedMemory to map them one
+ * by one instead. The buffer is kept alive until it is unmapped.
+ */
+class QTGSTREAMER_EXPORT MappedBuffer
+{
+public:
+    explicit MappedBuffer(const BufferPtr & buffer, MapFlags flags = MapRead);
+#ifndef BOOST_NO_RVALUE_REFERENCES
+    /*! Takes over the mapping of \a other, which becomes invalid. */
+    MappedBuffer(MappedBuffer && other);
+#endif
+    ~MappedBuffer();
+
+    /*! Returns false if the buffer could not be mapped. */
+    bool isValid() const;
+    MapFlags flags() const;
+
+    /*! Returns the mapped data. It may only be written to if
+     * the buffer was mapped with MapWrite. */
+    quint8 *data() const;
+    const quint8 *constData() const;
+    size_t size() const;
+
+    /*! Returns a QByteArray that refers to the mapped data without copying it.
+     * \note The returned QByteArray, and any copy of it, must not be used
+     * after this MappedBuffer is destroyed. */
+    QByteArray byteArrayView() const;
+
+private:
+    Q_DISABLE_COPY(MappedBuffer);
+
+    //large enough to hold a GstMapInfo without allocating one
+    void *m_info[16];
+    void *m_buffer;
+};
+
 } //namespace QGst
 
 QGST_REGISTER_TYPE(QGst::Buffer)
@@ -0,0 +1,202 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "bufferpool.h"
+#include "buffer.h"
+#include "caps.h"
+#include <cstring>
+#include <gst/gst.h>
+
+namespace QGst {
+
+BufferPoolConfig::BufferPoolConfig()
+  : d(gst_structure_new_empty("GstBufferPoolConfig"))
+{
+}
+
+BufferPoolConfig::BufferPoolConfig(GstStructure *config)
+  : d(config)
+{
+}
+
+BufferPoolConfig::BufferPoolConfig(const BufferPoolConfig & other)
+  : d(gst_structure_copy(other.d))
+{
+}
+
+BufferPoolConfig::~BufferPoolConfig()
+{
+    gst_structure_free(d);
+}
+
+BufferPoolConfig & BufferPoolConfig::operator=(const BufferPoolConfig & other)
+{
+    if (this != &other) {
+        gst_structure_free(d);
+        d = gst_structure_copy(other.d);
+    }
+    return *this;
+}
+
+CapsPtr BufferPoolConfig::caps() const
+{
+    GstCaps *caps = NULL;
+    gst_buffer_pool_config_get_params(d, &caps, NULL, NULL, NULL);
+    return CapsPtr::wrap(caps);
+}
+
+uint BufferPoolConfig::size() const
+{
+    guint size = 0;
+    gst_buffer_pool_config_get_params(d, NULL, &size, NULL, NULL);
+    return size;
+}
+
+uint BufferPoolConfig::minBuffers() const
+{
+    guint minBuffers = 0;
+    gst_buffer_pool_config_get_params(d, NULL, NULL, &minBuffers, NULL);
+    return minBuffers;
+}
+
+uint BufferPoolConfig::maxBuffers() const
+{
+    guint maxBuffers = 0;
+    gst_buffer_pool_config_get_params(d, NULL, NULL, NULL, &maxBuffers);
+    return maxBuffers;
+}
+
+void BufferPoolConfig::setParams(const CapsPtr & caps, uint size,
+                                 uint minBuffers, uint maxBuffers)
+{
+    gst_buffer_pool_config_set_params(d, caps, size, minBuffers, maxBuffers);
+}
+
+AllocatorPtr BufferPoolConfig::allocator() const
+{
+    GstAllocator *allocator = NULL;
+    gst_buffer_pool_config_get_allocator(d, &allocator, NULL);
+    return AllocatorPtr::wrap(allocator);
+}
+
+AllocationParams BufferPoolConfig::allocationParams() const
+{
+    AllocationParams params;
+    gst_buffer_pool_config_get_allocator(d, NULL, params);
+    return params;
+}
+
+void BufferPoolConfig::setAllocator(const AllocatorPtr & allocator,
+                                    const AllocationParams & params)
+{
+    gst_buffer_pool_config_set_allocator(d, allocator, params);
+}
+
+QStringList BufferPoolConfig::options() const
+{
+    QStringList result;
+    const guint n = gst_buffer_pool_config_n_options(d);
+    for (guint i = 0; i < n; ++i) {
+        result.append(QString::fromUtf8(gst_buffer_pool_config_get_option(d, i)));
+    }
+    return result;
+}
+
+bool BufferPoolConfig::hasOption(const char *option) const
+{
+    return gst_buffer_pool_config_has_option(d, option);
+}
+
+void BufferPoolConfig::addOption(const char *option)
+{
+    gst_buffer_pool_config_add_option(d, option);
+}
+
+BufferPoolConfig::operator GstStructure*()
+{
+    return d;
+}
+
+BufferPoolConfig::operator const GstStructure*() const
+{
+    return d;
+}
+
+//********************************************************
+
+//static
+BufferPoolPtr BufferPool::create()
+{
+    return BufferPoolPtr::wrap(gst_buffer_pool_new(), false);
+}
+
+BufferPoolConfig BufferPool::config() const
+{
+    return BufferPoolConfig(gst_buffer_pool_get_config(object<GstBufferPool>()));
+}
+
+bool BufferPool::setConfig(const BufferPoolConfig & config)
+{
+    //gst_buffer_pool_set_config takes ownership of the structure
+    return gst_buffer_pool_set_config(object<GstBufferPool>(), gst_structure_copy(config));
+}
+
+QStringList BufferPool::options() const
+{
+    QStringList result;
+    const gchar **options = gst_buffer_pool_get_options(object<GstBufferPool>());
+    for (int i = 0; options && options[i]; ++i) {
+        result.append(QString::fromUtf8(options[i]));
+    }
+    return result;
+}
+
+bool BufferPool::hasOption(const char *option) const
+{
+    return gst_buffer_pool_has_option(object<GstBufferPool>(), option);
+}
+
+bool BufferPool::setActive(bool active)
+{
+    return gst_buffer_pool_set_active(object<GstBufferPool>(), active);
+}
+
+bool BufferPool::isActive() const
+{
+    return gst_buffer_pool_is_active(object<GstBufferPool>());
+}
+
+FlowReturn BufferPool::acquireBuffer(BufferPtr & buffer, BufferPoolAcquireFlags flags)
+{
+    GstBufferPoolAcquireParams params;
+    memset(&params, 0, sizeof(params));
+    params.flags = static_cast<GstBufferPoolAcquireFlags>(static_cast<unsigned int>(flags));
+
+    GstBuffer *buf = NULL;
+    GstFlowReturn result = gst_buffer_pool_acquire_buffer(object<GstBufferPool>(), &buf, &params);
+    buffer = BufferPtr::wrap(buf, false);
+    return static_cast<FlowReturn>(result);
+}
+
+void BufferPool::releaseBuffer(BufferPtr & buffer)
+{
+    GstBuffer *buf = buffer;
+    gst_buffer_ref(buf);
+    buffer.clear();
+    gst_buffer_pool_release_buffer(object<GstBufferPool>(), buf);
+}
+
+} //namespace QGst
@@ -0,0 +1,135 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_BUFFERPOOL_H
+#define QGST_BUFFERPOOL_H
+
+#include "global.h"
+#include "object.h"
+#include "allocator.h"
+#include <QtCore/QStringList>
+
+namespace QGst {
+
+/*! \headerfile bufferpool.h <QGst/BufferPool>
+ * \brief Wrapper class for the configuration of a GstBufferPool
+ *
+ * A BufferPoolConfig holds the caps and size of the buffers that a BufferPool
+ * creates, the bounds of the number of buffers it keeps, the allocator and
+ * the AllocationParams that it allocates the memory with and the options
+ * that are enabled on it. Use AllocationParams::setAlign() to request a
+ * specific alignment of the memory of the buffers.
+ *
+ * A configuration is obtained with BufferPool::config(), changed and then
+ * applied with BufferPool::setConfig().
+ */
+class QTGSTREAMER_EXPORT BufferPoolConfig
+{
+public:
+    BufferPoolConfig();
+    BufferPoolConfig(const BufferPoolConfig & other);
+    virtual ~BufferPoolConfig();
+
+    BufferPoolConfig & operator=(const BufferPoolConfig & other);
+
+    CapsPtr caps() const;
+    uint size() const;
+    uint minBuffers() const;
+    /*! \returns the maximum number of buffers, 0 meaning unlimited */
+    uint maxBuffers() const;
+    void setParams(const CapsPtr & caps, uint size, uint minBuffers, uint maxBuffers);
+
+    AllocatorPtr allocator() const;
+    AllocationParams allocationParams() const;
+    /*! Sets the allocator to allocate the memory with. A null allocator
+     * selects the default allocator. */
+    void setAllocator(const AllocatorPtr & allocator,
+                      const AllocationParams & params = AllocationParams());
+
+    QStringList options() const;
+    bool hasOption(const char *option) const;
+    void addOption(const char *option);
+
+    operator GstStructure*();
+    operator const GstStructure*() const;
+
+private:
+    friend class BufferPool;
+    explicit BufferPoolConfig(GstStructure *config);
+    GstStructure *d;
+};
+
+/*! \headerfile bufferpool.h <QGst/BufferPool>
+ * \brief Wrapper class for GstBufferPool
+ *
+ * A BufferPool keeps a set of preallocated buffers of the same size, so that
+ * producing data does not need to allocate memory for every buffer. A buffer
+ * that is acquired from the pool returns to it once its last reference is
+ * dropped, or when it is handed back with releaseBuffer().
+ *
+ * The pool must be configured with setConfig() and then activated with
+ * setActive() before buffers can be acquired from it:
+ * \code
+ * QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+ * QGst::BufferPoolConfig config = pool->config();
+ * config.setParams(caps, frameSize, 4, 0);
+ * pool->setConfig(config);
+ * pool->setActive(true);
+ *
+ * QGst::BufferPtr buffer;
+ * if (pool->acquireBuffer(buffer) == QGst::FlowOk) {
+ *     // fill and push the buffer
+ * }
+ * \endcode
+ *
+ * \sa AllocationQuery
+ */
+class QTGSTREAMER_EXPORT BufferPool : public Object
+{
+    QGST_WRAPPER(BufferPool)
+public:
+    static BufferPoolPtr create();
+
+    /*! \returns a copy of the current configuration of the pool */
+    BufferPoolConfig config() const;
+    /*! Applies \a config on the pool. This fails if the pool is active
+     * or if it does not accept the configuration. */
+    bool setConfig(const BufferPoolConfig & config);
+
+    /*! \returns the options that can be enabled on the configuration of this pool */
+    QStringList options() const;
+    bool hasOption(const char *option) const;
+
+    /*! Allocates the minimum number of buffers when \a active is true and frees
+     * all the buffers when it is false. */
+    bool setActive(bool active);
+    bool isActive() const;
+
+    /*! Acquires a buffer from the pool and stores it in \a buffer. Unless
+     * BufferPoolAcquireFlagDontWait is given, this blocks until a buffer
+     * is available if the pool has reached its maximum number of buffers. */
+    FlowReturn acquireBuffer(BufferPtr & buffer,
+                             BufferPoolAcquireFlags flags = BufferPoolAcquireFlagNone);
+    /*! Returns \a buffer to the pool.
+     * \note this takes a reference to the buffer pointer and makes it null */
+    void releaseBuffer(BufferPtr & buffer);
+};
+
+} //namespace QGst
+
+QGST_REGISTER_TYPE(QGst::BufferPool)
+
+#endif
@@ -19,28 +19,60 @@
 #include "../QGlib/Signal"
 #include <gst/gst.h>
 #include <QtCore/QObject>
-#include <QtCore/QTimerEvent>
 #include <QtCore/QHash>
-#include <QtCore/QBasicTimer>
+#ifdef Q_OS_UNIX
+# include <QtCore/QSocketNotifier>
+#else
+# include <QtCore/QTimerEvent>
+# include <QtCore/QBasicTimer>
+#endif
 
 namespace QGst {
 namespace Private {
 
+/* On unix, the watch is woken up from the poll fd of the bus, which is readable for as
+ * long as there are messages in the bus queue, since gst_bus_post() signals it after
+ * queueing the message and gst_bus_pop() clears it for every message it pops. The
+ * messages are then popped and dispatched from the event loop of the thread that called
+ * addSignalWatch(). Elsewhere, the poll fd is not a socket that Qt can watch, so the
+ * bus is polled every 50 ms instead.
+ */
 class BusWatch : public QObject
 {
 public:
     BusWatch(GstBus *bus)
         : QObject(), m_bus(bus)
     {
+#ifdef Q_OS_UNIX
+        GPollFD pollFd;
+        gst_bus_get_pollfd(m_bus, &pollFd);
+        m_notifier = new QSocketNotifier(pollFd.fd, QSocketNotifier::Read, this);
+        m_notifier->installEventFilter(this);
+#else
         m_timer.start(50, this);
+#endif
     }
 
     void stop()
     {
+#ifdef Q_OS_UNIX
+        m_notifier->setEnabled(false);
+#else
         m_timer.stop();
+#endif
     }
 
 private:
+#ifdef Q_OS_UNIX
+    virtual bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if (watched == m_notifier && event->type() == QEvent::SockAct) {
+            dispatch();
+            return true;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+#else
     virtual void timerEvent(QTimerEvent *event)
     {
         if (event->timerId() == m_timer.timerId()) {
@@ -49,6 +81,7 @@ private:
             QObject::timerEvent(event);
         }
     }
+#endif
 
     void dispatch()
     {
@@ -63,7 +96,11 @@ private:
     }
 
     GstBus *m_bus;
+#ifdef Q_OS_UNIX
+    QSocketNotifier *m_notifier;
+#else
     QBasicTimer m_timer;
+#endif
 };
 
 class BusWatchManager
@@ -96,6 +133,7 @@ private:
         GstBus *bus = reinterpret_cast<GstBus*>(busPtr);
 
         //we cannot call removeWatch() here because g_object_weak_unref will complain
+        //and the signal handlers of the bus have already been destroyed
         self->m_watches[bus].first->stop();
         self->m_watches[bus].first->deleteLater();
         self->m_watches.remove(bus);
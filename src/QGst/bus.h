@@ -38,9 +38,9 @@ namespace QGst {
  * \li Enable the emission of the "sync-message" signal using enableSyncMessageEmission()
  * and connect to this signal. The slot connected to this signal will be called
  * synchronously from the thread that posts the message.
- * \li Add a signal "watch" to the bus. This is an object that will poll the bus from the
- * main event loop and will emit the "message" signal on the main thread whenever a new
- * message is available. Note that the watch will pop messages from the bus, so they
+ * \li Add a signal "watch" to the bus. This is an object that will be woken up from the
+ * main event loop whenever a new message is posted and will emit the "message" signal
+ * on the main thread. Note that the watch will pop messages from the bus, so they
  * won't be available for manual polling.
  *
  * \note In this library, the bus watch is implemented using Qt's mechanisms and is
@@ -88,10 +88,13 @@ public:
     void setFlushing(bool flush);
 
 
-    /*! This adds a signal "watch" object, an object that will poll the bus from the
-     * event loop of the thread that called this function first. In every event loop
-     * execution, any pending messages will be popped from the bus and the "message"
-     * signal of the bus will be emitted.
+    /*! This adds a signal "watch" object, an object that will dispatch the messages of
+     * the bus from the event loop of the thread that called this function first. Whenever
+     * a message is posted, the watch is woken up, any pending messages are popped from the
+     * bus and the "message" signal of the bus is emitted for each one of them.
+     *
+     * On unix, the watch is woken up from the poll file descriptor of the bus. On other
+     * platforms, it polls the bus every 50 ms instead.
      *
      * The caller is responsible to cleanup by calling the removeSignalWatch() function
      * when this functionality is no longer needed. When the bus is destroyed, the watch
@@ -0,0 +1,703 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementimpl.h"
+#include "buffer.h"
+#include "event.h"
+#include "query.h"
+#include <QtCore/QDebug>
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include <gst/base/gstbasesrc.h>
+#include <gst/base/gstbasesink.h>
+
+namespace QGst {
+
+ElementMetadata::ElementMetadata(const char *longName, const char *classification,
+                                 const char *description, const char *author)
+    : m_longName(longName),
+      m_classification(classification),
+      m_description(description),
+      m_author(author)
+{
+}
+
+void ElementMetadata::addPadTemplate(const char *nameTemplate, PadDirection direction,
+                                     PadPresence presence, const CapsPtr & caps)
+{
+    PadTemplate padTemplate;
+    padTemplate.nameTemplate = nameTemplate;
+    padTemplate.direction = direction;
+    padTemplate.presence = presence;
+    padTemplate.caps = caps;
+    m_padTemplates.append(padTemplate);
+}
+
+namespace Private {
+
+#ifndef DOXYGEN_RUN
+
+struct ElementTypeData
+{
+    ElementTypeData(const ElementMetadata & metadata_)
+        : metadata(metadata_), parentClass(NULL) {}
+
+    ElementImplKind kind;
+    ElementImplFactory factory;
+    //kept for as long as the type exists, as the class points to its strings
+    ElementMetadata metadata;
+    GstElementClass *parentClass;
+};
+
+/* The instance and class structures of the registered types, which
+ * append the implementation and the type data to those of the parent */
+template <typename ParentInstance, typename ParentClass>
+struct ElementImplType
+{
+    struct Instance
+    {
+        ParentInstance parent;
+        AbstractElementImpl *impl;
+    };
+
+    struct Class
+    {
+        ParentClass parent;
+        ElementTypeData *data;
+    };
+};
+
+typedef ElementImplType<GstElement, GstElementClass> ElementType;
+typedef ElementImplType<GstBaseTransform, GstBaseTransformClass> BaseTransformType;
+typedef ElementImplType<GstBaseSrc, GstBaseSrcClass> BaseSrcType;
+typedef ElementImplType<GstBaseSink, GstBaseSinkClass> BaseSinkType;
+
+static GQuark elementTypeDataQuark()
+{
+    static GQuark quark = g_quark_from_static_string("QGst::ElementTypeData");
+    return quark;
+}
+
+//returns the data of the registered type that gtype is or derives from
+static ElementTypeData *elementTypeData(GType gtype)
+{
+    for (; gtype; gtype = g_type_parent(gtype)) {
+        ElementTypeData *data = static_cast<ElementTypeData*>(
+                g_type_get_qdata(gtype, elementTypeDataQuark()));
+        if (data) {
+            return data;
+        }
+    }
+    return NULL;
+}
+
+struct ElementImplAccess
+{
+    static inline GstElement *element(const AbstractElementImpl *impl)
+    {
+        return impl->m_element;
+    }
+
+    template <typename T, typename Impl>
+    static inline Impl *impl(gpointer instance)
+    {
+        return static_cast<Impl*>(reinterpret_cast<typename T::Instance*>(instance)->impl);
+    }
+
+    static AbstractElementImpl *impl(GstElement *element, ElementImplKind kind)
+    {
+        switch (kind) {
+        case ElementKind:
+            return impl<ElementType, AbstractElementImpl>(element);
+        case TransformKind:
+        case FilterKind:
+            return impl<BaseTransformType, AbstractElementImpl>(element);
+        case SourceKind:
+            return impl<BaseSrcType, AbstractElementImpl>(element);
+        case SinkKind:
+            return impl<BaseSinkType, AbstractElementImpl>(element);
+        }
+        return NULL;
+    }
+
+    //BEGIN ******** GObject and GstElement ********
+
+    template <typename T>
+    static void classInit(gpointer gClass, gpointer classData)
+    {
+        ElementTypeData *data = static_cast<ElementTypeData*>(classData);
+        reinterpret_cast<typename T::Class*>(gClass)->data = data;
+        data->parentClass = GST_ELEMENT_CLASS(g_type_class_peek_parent(gClass));
+
+        G_OBJECT_CLASS(gClass)->finalize = &finalize<T>;
+
+        GstElementClass *elementClass = GST_ELEMENT_CLASS(gClass);
+        elementClass->change_state = &changeState<T>;
+        gst_element_class_set_static_metadata(elementClass,
+                data->metadata.m_longName.constData(),
+                data->metadata.m_classification.constData(),
+                data->metadata.m_description.constData(),
+                data->metadata.m_author.constData());
+
+        Q_FOREACH(const ElementMetadata::PadTemplate & padTemplate,
+                  data->metadata.m_padTemplates) {
+            gst_element_class_add_pad_template(elementClass,
+                    gst_pad_template_new(padTemplate.nameTemplate.constData(),
+                                         static_cast<GstPadDirection>(padTemplate.direction),
+                                         static_cast<GstPadPresence>(padTemplate.presence),
+                                         padTemplate.caps));
+        }
+
+        switch (data->kind) {
+        case ElementKind:
+            break;
+        case TransformKind:
+        case FilterKind:
+        {
+            GstBaseTransformClass *transformClass = GST_BASE_TRANSFORM_CLASS(gClass);
+            transformClass->start = &transformStart;
+            transformClass->stop = &transformStop;
+            transformClass->set_caps = &transformSetCaps;
+            transformClass->transform_caps = &transformCaps;
+            transformClass->decide_allocation = &transformDecideAllocation;
+            //GstBaseTransform works in place when only transform_ip is set
+            if (data->kind == TransformKind) {
+                transformClass->transform = &transform;
+            } else {
+                transformClass->transform_ip = &transformIp;
+            }
+            break;
+        }
+        case SourceKind:
+        {
+            GstBaseSrcClass *srcClass = GST_BASE_SRC_CLASS(gClass);
+            srcClass->start = &srcStart;
+            srcClass->stop = &srcStop;
+            srcClass->set_caps = &srcSetCaps;
+            srcClass->create = &srcCreate;
+            break;
+        }
+        case SinkKind:
+        {
+            GstBaseSinkClass *sinkClass = GST_BASE_SINK_CLASS(gClass);
+            sinkClass->start = &sinkStart;
+            sinkClass->stop = &sinkStop;
+            sinkClass->set_caps = &sinkSetCaps;
+            sinkClass->render = &sinkRender;
+            sinkClass->propose_allocation = &sinkProposeAllocation;
+            break;
+        }
+        }
+    }
+
+    template <typename T>
+    static void instanceInit(GTypeInstance *instance, gpointer gClass)
+    {
+        ElementTypeData *data = reinterpret_cast<typename T::Class*>(gClass)->data;
+
+        AbstractElementImpl *elementImpl = data->factory();
+        elementImpl->m_element = GST_ELEMENT(instance);
+        reinterpret_cast<typename T::Instance*>(instance)->impl = elementImpl;
+
+        //the GStreamer base classes create their own pads
+        if (data->kind == ElementKind) {
+            Q_FOREACH(const ElementMetadata::PadTemplate & padTemplate,
+                      data->metadata.m_padTemplates) {
+                if (padTemplate.presence == PadAlways) {
+                    static_cast<ElementImpl*>(elementImpl)->createPad(
+                            padTemplate.nameTemplate.constData());
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    static void finalize(GObject *object)
+    {
+        typename T::Instance *instance = reinterpret_cast<typename T::Instance*>(object);
+        delete instance->impl;
+        instance->impl = NULL;
+
+        ElementTypeData *data = elementTypeData(G_OBJECT_TYPE(object));
+        G_OBJECT_CLASS(data->parentClass)->finalize(object);
+    }
+
+    template <typename T>
+    static GstStateChangeReturn changeState(GstElement *element, GstStateChange transition)
+    {
+        return static_cast<GstStateChangeReturn>(impl<T, AbstractElementImpl>(element)
+                ->changeState(static_cast<StateChange>(transition)));
+    }
+
+    static StateChangeReturn parentChangeState(GstElement *element, StateChange transition)
+    {
+        ElementTypeData *data = elementTypeData(G_OBJECT_TYPE(element));
+        return static_cast<StateChangeReturn>(data->parentClass->change_state(
+                element, static_cast<GstStateChange>(transition)));
+    }
+
+    //END ******** GObject and GstElement ********
+    //BEGIN ******** ElementImpl pads ********
+
+    static GstFlowReturn padChain(GstPad *pad, GstObject *parent, GstBuffer *buffer)
+    {
+        //the buffer belongs to the element from now on
+        BufferPtr bufferPtr = BufferPtr::wrap(buffer, false);
+        return static_cast<GstFlowReturn>(impl<ElementType, ElementImpl>(parent)
+                ->chain(PadPtr::wrap(pad), bufferPtr));
+    }
+
+    static gboolean padEvent(GstPad *pad, GstObject *parent, GstEvent *event)
+    {
+        EventPtr eventPtr = EventPtr::wrap(event, false);
+        return impl<ElementType, ElementImpl>(parent)->event(PadPtr::wrap(pad), eventPtr);
+    }
+
+    static gboolean padQuery(GstPad *pad, GstObject *parent, GstQuery *query)
+    {
+        //the query is only borrowed, without a reference of the wrapper,
+        //so that it remains writable and can be answered
+        QueryPtr queryPtr = QueryPtr::wrap(query, false);
+        bool result = impl<ElementType, ElementImpl>(parent)->query(PadPtr::wrap(pad), queryPtr);
+        gst_query_ref(query);
+        return result;
+    }
+
+    //END ******** ElementImpl pads ********
+    //BEGIN ******** GstBaseTransform ********
+
+    static gboolean transformStart(GstBaseTransform *transform)
+    {
+        return impl<BaseTransformType, BaseTransformImpl>(transform)->start();
+    }
+
+    static gboolean transformStop(GstBaseTransform *transform)
+    {
+        return impl<BaseTransformType, BaseTransformImpl>(transform)->stop();
+    }
+
+    static gboolean transformSetCaps(GstBaseTransform *transform, GstCaps *incaps, GstCaps *outcaps)
+    {
+        return impl<BaseTransformType, BaseTransformImpl>(transform)->setCaps(
+                CapsPtr::wrap(incaps), CapsPtr::wrap(outcaps));
+    }
+
+    static GstCaps *transformCaps(GstBaseTransform *transform, GstPadDirection direction,
+                                  GstCaps *caps, GstCaps *filter)
+    {
+        CapsPtr result = impl<BaseTransformType, BaseTransformImpl>(transform)->transformCaps(
+                static_cast<PadDirection>(direction), CapsPtr::wrap(caps), CapsPtr::wrap(filter));
+        return !result.isNull() ? gst_caps_ref(result) : gst_caps_new_empty();
+    }
+
+    static gboolean transformDecideAllocation(GstBaseTransform *transform, GstQuery *query)
+    {
+        //borrowed, so that it remains writable
+        AllocationQueryPtr queryPtr = AllocationQueryPtr::wrap(query, false);
+        bool result = impl<BaseTransformType, BaseTransformImpl>(transform)
+                ->decideAllocation(queryPtr);
+        gst_query_ref(query);
+        return result;
+    }
+
+    static bool parentDecideAllocation(GstElement *element, GstQuery *query)
+    {
+        GstBaseTransformClass *parentClass = reinterpret_cast<GstBaseTransformClass*>(
+                elementTypeData(G_OBJECT_TYPE(element))->parentClass);
+        return !parentClass->decide_allocation
+            || parentClass->decide_allocation(GST_BASE_TRANSFORM(element), query);
+    }
+
+    static GstFlowReturn transform(GstBaseTransform *transform, GstBuffer *inbuf, GstBuffer *outbuf)
+    {
+        //outbuf is borrowed, so that it remains writable
+        BufferPtr outbufPtr = BufferPtr::wrap(outbuf, false);
+        FlowReturn result = impl<BaseTransformType, TransformImpl>(transform)->transform(
+                BufferPtr::wrap(inbuf), outbufPtr);
+        gst_buffer_ref(outbuf);
+        return static_cast<GstFlowReturn>(result);
+    }
+
+    static GstFlowReturn transformIp(GstBaseTransform *transform, GstBuffer *buffer)
+    {
+        BufferPtr bufferPtr = BufferPtr::wrap(buffer, false);
+        FlowReturn result = impl<BaseTransformType, FilterImpl>(transform)->filter(bufferPtr);
+        gst_buffer_ref(buffer);
+        return static_cast<GstFlowReturn>(result);
+    }
+
+    //END ******** GstBaseTransform ********
+    //BEGIN ******** GstBaseSrc ********
+
+    static gboolean srcStart(GstBaseSrc *src)
+    {
+        return impl<BaseSrcType, SourceImpl>(src)->start();
+    }
+
+    static gboolean srcStop(GstBaseSrc *src)
+    {
+        return impl<BaseSrcType, SourceImpl>(src)->stop();
+    }
+
+    static gboolean srcSetCaps(GstBaseSrc *src, GstCaps *caps)
+    {
+        return impl<BaseSrcType, SourceImpl>(src)->setCaps(CapsPtr::wrap(caps));
+    }
+
+    static GstFlowReturn srcCreate(GstBaseSrc *src, guint64 offset, guint size, GstBuffer **buffer)
+    {
+        BufferPtr bufferPtr;
+        FlowReturn result = impl<BaseSrcType, SourceImpl>(src)->create(offset, size, bufferPtr);
+        if (result == FlowOk) {
+            if (!bufferPtr) {
+                qWarning() << "QGst::SourceImpl::create() returned FlowOk without a buffer";
+                return GST_FLOW_ERROR;
+            }
+            *buffer = gst_buffer_ref(bufferPtr);
+        }
+        return static_cast<GstFlowReturn>(result);
+    }
+
+    //END ******** GstBaseSrc ********
+    //BEGIN ******** GstBaseSink ********
+
+    static gboolean sinkStart(GstBaseSink *sink)
+    {
+        return impl<BaseSinkType, SinkImpl>(sink)->start();
+    }
+
+    static gboolean sinkStop(GstBaseSink *sink)
+    {
+        return impl<BaseSinkType, SinkImpl>(sink)->stop();
+    }
+
+    static gboolean sinkSetCaps(GstBaseSink *sink, GstCaps *caps)
+    {
+        return impl<BaseSinkType, SinkImpl>(sink)->setCaps(CapsPtr::wrap(caps));
+    }
+
+    static GstFlowReturn sinkRender(GstBaseSink *sink, GstBuffer *buffer)
+    {
+        return static_cast<GstFlowReturn>(impl<BaseSinkType, SinkImpl>(sink)->render(
+                BufferPtr::wrap(buffer)));
+    }
+
+    static gboolean sinkProposeAllocation(GstBaseSink *sink, GstQuery *query)
+    {
+        AllocationQueryPtr queryPtr = AllocationQueryPtr::wrap(query, false);
+        bool result = impl<BaseSinkType, SinkImpl>(sink)->proposeAllocation(queryPtr);
+        gst_query_ref(query);
+        return result;
+    }
+
+    static bool parentProposeAllocation(GstElement *element, GstQuery *query)
+    {
+        GstBaseSinkClass *parentClass = reinterpret_cast<GstBaseSinkClass*>(
+                elementTypeData(G_OBJECT_TYPE(element))->parentClass);
+        return parentClass->propose_allocation
+            && parentClass->propose_allocation(GST_BASE_SINK(element), query);
+    }
+
+    //END ******** GstBaseSink ********
+
+    template <typename T>
+    static void initTypeInfo(GTypeInfo *info)
+    {
+        info->class_size = sizeof(typename T::Class);
+        info->class_init = &classInit<T>;
+        info->instance_size = sizeof(typename T::Instance);
+        info->instance_init = &instanceInit<T>;
+    }
+};
+
+#endif //DOXYGEN_RUN
+
+QGlib::Type registerElementType(const char *typeName, ElementImplKind kind,
+                                const ElementMetadata & metadata, ElementImplFactory factory)
+{
+    GType type = g_type_from_name(typeName);
+    if (type) {
+        return type;
+    }
+
+    ElementTypeData *data = new ElementTypeData(metadata);
+    data->kind = kind;
+    data->factory = factory;
+
+    GTypeInfo info;
+    memset(&info, 0, sizeof(GTypeInfo));
+    info.class_data = data;
+
+    GType parentType = G_TYPE_INVALID;
+    switch (kind) {
+    case ElementKind:
+        parentType = GST_TYPE_ELEMENT;
+        ElementImplAccess::initTypeInfo<ElementType>(&info);
+        break;
+    case TransformKind:
+    case FilterKind:
+        parentType = GST_TYPE_BASE_TRANSFORM;
+        ElementImplAccess::initTypeInfo<BaseTransformType>(&info);
+        break;
+    case SourceKind:
+        parentType = GST_TYPE_BASE_SRC;
+        ElementImplAccess::initTypeInfo<BaseSrcType>(&info);
+        break;
+    case SinkKind:
+        parentType = GST_TYPE_BASE_SINK;
+        ElementImplAccess::initTypeInfo<BaseSinkType>(&info);
+        break;
+    }
+
+    type = g_type_register_static(parentType, typeName, &info, static_cast<GTypeFlags>(0));
+    g_type_set_qdata(type, elementTypeDataQuark(), data);
+    return type;
+}
+
+bool registerElement(const char *name, Rank rank, QGlib::Type type)
+{
+    return gst_element_register(NULL, name, rank, type);
+}
+
+} //namespace Private
+
+static inline GstElement *gstElement(const AbstractElementImpl *impl)
+{
+    return Private::ElementImplAccess::element(impl);
+}
+
+//BEGIN ******** AbstractElementImpl ********
+
+AbstractElementImpl::AbstractElementImpl()
+    : m_element(NULL)
+{
+}
+
+AbstractElementImpl::~AbstractElementImpl()
+{
+}
+
+ElementPtr AbstractElementImpl::element() const
+{
+    return ElementPtr::wrap(m_element);
+}
+
+//static
+AbstractElementImpl *AbstractElementImpl::fromElement(const ElementPtr & element)
+{
+    GstElement *gstElement = element;
+    if (!gstElement) {
+        return NULL;
+    }
+    Private::ElementTypeData *data = Private::elementTypeData(G_OBJECT_TYPE(gstElement));
+    return data ? Private::ElementImplAccess::impl(gstElement, data->kind) : NULL;
+}
+
+StateChangeReturn AbstractElementImpl::changeState(StateChange transition)
+{
+    return Private::ElementImplAccess::parentChangeState(m_element, transition);
+}
+
+//END ******** AbstractElementImpl ********
+//BEGIN ******** ElementImpl ********
+
+PadPtr ElementImpl::createPad(const char *templateName, const char *name)
+{
+    GstPadTemplate *padTemplate = gst_element_class_get_pad_template(
+            GST_ELEMENT_GET_CLASS(gstElement(this)), templateName);
+    if (!padTemplate) {
+        qWarning() << "QGst::ElementImpl::createPad: no pad template named" << templateName;
+        return PadPtr();
+    }
+
+    GstPad *pad = gst_pad_new_from_template(padTemplate, name);
+    if (GST_PAD_IS_SINK(pad)) {
+        gst_pad_set_chain_function(pad, &Private::ElementImplAccess::padChain);
+    }
+    gst_pad_set_event_function(pad, &Private::ElementImplAccess::padEvent);
+    gst_pad_set_query_function(pad, &Private::ElementImplAccess::padQuery);
+
+    //pads that are added while the element is running must be activated first
+    if (GST_STATE(gstElement(this)) > GST_STATE_READY || GST_STATE_TARGET(gstElement(this)) > GST_STATE_READY) {
+        gst_pad_set_active(pad, TRUE);
+    }
+    gst_element_add_pad(gstElement(this), pad);
+    return PadPtr::wrap(pad);
+}
+
+FlowReturn ElementImpl::push(const PadPtr & pad, BufferPtr & buffer)
+{
+    if (!buffer) {
+        return FlowError;
+    }
+
+    //pass on the reference of the wrapper
+    GstBuffer *gstBuffer = gst_buffer_ref(buffer);
+    buffer.clear();
+    return static_cast<FlowReturn>(gst_pad_push(pad, gstBuffer));
+}
+
+bool ElementImpl::pushEvent(const PadPtr & pad, EventPtr & event)
+{
+    if (!event) {
+        return false;
+    }
+
+    GstEvent *gstEvent = gst_event_ref(event);
+    event.clear();
+    return gst_pad_push_event(pad, gstEvent);
+}
+
+FlowReturn ElementImpl::chain(const PadPtr & pad, BufferPtr & buffer)
+{
+    Q_UNUSED(pad);
+
+    GstPad *srcPad = gst_element_get_static_pad(gstElement(this), "src");
+    if (!srcPad) {
+        buffer.clear();
+        return FlowOk;
+    }
+    return push(PadPtr::wrap(srcPad, false), buffer);
+}
+
+bool ElementImpl::event(const PadPtr & pad, EventPtr & event)
+{
+    GstEvent *gstEvent = gst_event_ref(event);
+    event.clear();
+    return gst_pad_event_default(pad, GST_OBJECT(gstElement(this)), gstEvent);
+}
+
+bool ElementImpl::query(const PadPtr & pad, const QueryPtr & query)
+{
+    return gst_pad_query_default(pad, GST_OBJECT(gstElement(this)), query);
+}
+
+//END ******** ElementImpl ********
+//BEGIN ******** BaseTransformImpl ********
+
+void BaseTransformImpl::setPassthrough(bool passthrough)
+{
+    gst_base_transform_set_passthrough(GST_BASE_TRANSFORM(gstElement(this)), passthrough);
+}
+
+bool BaseTransformImpl::isPassthrough() const
+{
+    return gst_base_transform_is_passthrough(GST_BASE_TRANSFORM(gstElement(this)));
+}
+
+bool BaseTransformImpl::start()
+{
+    return true;
+}
+
+bool BaseTransformImpl::stop()
+{
+    return true;
+}
+
+bool BaseTransformImpl::setCaps(const CapsPtr & incaps, const CapsPtr & outcaps)
+{
+    Q_UNUSED(incaps);
+    Q_UNUSED(outcaps);
+    return true;
+}
+
+CapsPtr BaseTransformImpl::transformCaps(PadDirection direction, const CapsPtr & caps,
+                                         const CapsPtr & filter)
+{
+    Q_UNUSED(direction);
+    if (filter) {
+        return CapsPtr::wrap(gst_caps_intersect_full(filter, caps, GST_CAPS_INTERSECT_FIRST), false);
+    }
+    return caps;
+}
+
+bool BaseTransformImpl::decideAllocation(const AllocationQueryPtr & query)
+{
+    return Private::ElementImplAccess::parentDecideAllocation(gstElement(this), query);
+}
+
+//END ******** BaseTransformImpl ********
+//BEGIN ******** SourceImpl ********
+
+void SourceImpl::setLive(bool live)
+{
+    gst_base_src_set_live(GST_BASE_SRC(gstElement(this)), live);
+}
+
+bool SourceImpl::isLive() const
+{
+    return gst_base_src_is_live(GST_BASE_SRC(gstElement(this)));
+}
+
+void SourceImpl::setFormat(Format format)
+{
+    gst_base_src_set_format(GST_BASE_SRC(gstElement(this)), static_cast<GstFormat>(format));
+}
+
+bool SourceImpl::start()
+{
+    return true;
+}
+
+bool SourceImpl::stop()
+{
+    return true;
+}
+
+bool SourceImpl::setCaps(const CapsPtr & caps)
+{
+    Q_UNUSED(caps);
+    return true;
+}
+
+//END ******** SourceImpl ********
+//BEGIN ******** SinkImpl ********
+
+void SinkImpl::setSync(bool sync)
+{
+    gst_base_sink_set_sync(GST_BASE_SINK(gstElement(this)), sync);
+}
+
+bool SinkImpl::isSync() const
+{
+    return gst_base_sink_get_sync(GST_BASE_SINK(gstElement(this)));
+}
+
+bool SinkImpl::start()
+{
+    return true;
+}
+
+bool SinkImpl::stop()
+{
+    return true;
+}
+
+bool SinkImpl::setCaps(const CapsPtr & caps)
+{
+    Q_UNUSED(caps);
+    return true;
+}
+
+bool SinkImpl::proposeAllocation(const AllocationQueryPtr & query)
+{
+    return Private::ElementImplAccess::parentProposeAllocation(gstElement(this), query);
+}
+
+//END ******** SinkImpl ********
+
+} //namespace QGst
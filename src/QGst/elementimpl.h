@@ -0,0 +1,362 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_ELEMENTIMPL_H
+#define QGST_ELEMENTIMPL_H
+
+#include "element.h"
+#include "pad.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+
+namespace QGst {
+
+namespace Private {
+    struct ElementImplAccess;
+
+    enum ElementImplKind {
+        ElementKind,
+        TransformKind,
+        FilterKind,
+        SourceKind,
+        SinkKind
+    };
+}
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Describes an element type that is implemented in C++
+ *
+ * This holds the details that are shown by gst-inspect and the pad templates
+ * of an element type that is registered with registerElement().
+ */
+class QTGSTREAMER_EXPORT ElementMetadata
+{
+public:
+    ElementMetadata(const char *longName, const char *classification,
+                    const char *description, const char *author);
+
+    /*! Adds a pad template. TransformImpl, FilterImpl, SourceImpl and SinkImpl
+     * require their templates to be named "sink" and "src", as the GStreamer
+     * base classes create their pads from them. */
+    void addPadTemplate(const char *nameTemplate, PadDirection direction,
+                        PadPresence presence, const CapsPtr & caps);
+
+private:
+    friend struct Private::ElementImplAccess;
+
+    struct PadTemplate
+    {
+        QByteArray nameTemplate;
+        PadDirection direction;
+        PadPresence presence;
+        CapsPtr caps;
+    };
+
+    QByteArray m_longName;
+    QByteArray m_classification;
+    QByteArray m_description;
+    QByteArray m_author;
+    QList<PadTemplate> m_padTemplates;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Base class for the implementation of elements in C++
+ *
+ * An element type is implemented by subclassing one of ElementImpl,
+ * TransformImpl, FilterImpl, SourceImpl or SinkImpl and reimplementing its
+ * virtual methods. The type is then registered with registerElement(), after
+ * which it can be created with ElementFactory::make() or Parse::launch() like
+ * any other element:
+ * \code
+ * class Invert : public QGst::FilterImpl
+ * {
+ * protected:
+ *     virtual QGst::FlowReturn filter(const QGst::BufferPtr & buffer) { ... }
+ * };
+ * ...
+ * QGst::ElementMetadata metadata("Invert", "Filter", "Inverts bytes", "Me");
+ * metadata.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, QGst::Caps::createAny());
+ * metadata.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways, QGst::Caps::createAny());
+ * QGst::registerElement<Invert>("invert", QGst::RankNone, metadata);
+ * QGst::ElementPtr invert = QGst::ElementFactory::make("invert");
+ * \endcode
+ *
+ * One instance of the subclass is created for each instance of the element,
+ * with its default constructor, and it is deleted when the element is
+ * finalized. The virtual methods that handle data are called directly from
+ * the streaming thread of the element, so the processing does not leave the
+ * pipeline as it does with an ApplicationSink and ApplicationSource pair.
+ */
+class QTGSTREAMER_EXPORT AbstractElementImpl
+{
+public:
+    virtual ~AbstractElementImpl();
+
+    /*! Returns the element that this object implements. This is
+     * not available yet in the constructor of the subclass. */
+    ElementPtr element() const;
+
+    /*! Returns the element that \a element implements,
+     * or NULL if it was not registered with registerElement(). */
+    static AbstractElementImpl *fromElement(const ElementPtr & element);
+
+protected:
+    AbstractElementImpl();
+
+    /*! Called for every state change of the element. The default
+     * implementation calls the one of the GStreamer parent class. */
+    virtual StateChangeReturn changeState(StateChange transition);
+
+private:
+    Q_DISABLE_COPY(AbstractElementImpl)
+    friend struct Private::ElementImplAccess;
+
+    GstElement *m_element;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Base class for elements that handle the data of their pads directly
+ *
+ * The pads of the always pad templates are created with the element, and
+ * more pads can be created with createPad(). The data that arrives on sink
+ * pads is passed to chain(), and the events and queries to event() and query().
+ */
+class QTGSTREAMER_EXPORT ElementImpl : public AbstractElementImpl
+{
+public:
+    /*! Creates a pad from the template named \a templateName, which handles
+     * its data with the virtual methods of this class, and adds it to the element. */
+    PadPtr createPad(const char *templateName, const char *name = NULL);
+
+    /*! Pushes \a buffer on \a pad. The buffer is passed on, so \a buffer is cleared
+     * and the element downstream may modify it in place if nobody else holds it. */
+    FlowReturn push(const PadPtr & pad, BufferPtr & buffer);
+    /*! Pushes \a event on \a pad, and clears \a event. */
+    bool pushEvent(const PadPtr & pad, EventPtr & event);
+
+protected:
+    /*! Called for every buffer that arrives on the sink \a pad. The buffer belongs to
+     * this element, which can pass it on with push(). The default implementation
+     * pushes it on the "src" pad, if there is one. */
+    virtual FlowReturn chain(const PadPtr & pad, BufferPtr & buffer);
+
+    /*! Called for every event that arrives on \a pad. The default
+     * implementation is gst_pad_event_default(). */
+    virtual bool event(const PadPtr & pad, EventPtr & event);
+
+    /*! Called for every query on \a pad. The default
+     * implementation is gst_pad_query_default(). */
+    virtual bool query(const PadPtr & pad, const QueryPtr & query);
+
+#ifndef DOXYGEN_RUN
+public:
+    static Private::ElementImplKind implKind() { return Private::ElementKind; }
+#endif
+
+private:
+    friend struct Private::ElementImplAccess;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Common base class of TransformImpl and FilterImpl
+ *
+ * These are implemented on top of GstBaseTransform, which handles the events,
+ * queries and buffer allocation, so that only the processing of the buffers
+ * is left to the subclass.
+ */
+class QTGSTREAMER_EXPORT BaseTransformImpl : public AbstractElementImpl
+{
+public:
+    /*! Makes the element push the buffers downstream untouched,
+     * without calling the transform method. */
+    void setPassthrough(bool passthrough);
+    bool isPassthrough() const;
+
+protected:
+    /*! Called when the element starts and stops processing. */
+    virtual bool start();
+    virtual bool stop();
+
+    /*! Called when the caps of the input and output are known. */
+    virtual bool setCaps(const CapsPtr & incaps, const CapsPtr & outcaps);
+
+    /*! Returns the caps that the element can produce on the pad of the other
+     * \a direction for the given \a caps, intersected with \a filter if it is
+     * not null. The default implementation returns \a caps, i.e. the element
+     * does not change the format. */
+    virtual CapsPtr transformCaps(PadDirection direction, const CapsPtr & caps,
+                                  const CapsPtr & filter);
+
+    /*! Called with the allocation query that the element has sent downstream, once it
+     * has been answered, to choose the pool and the allocator of the output buffers,
+     * which are the first ones in \a query. The default implementation is the one
+     * of GstBaseTransform. */
+    virtual bool decideAllocation(const AllocationQueryPtr & query);
+
+private:
+    friend struct Private::ElementImplAccess;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Base class for elements that produce a new buffer from each input buffer
+ */
+class QTGSTREAMER_EXPORT TransformImpl : public BaseTransformImpl
+{
+protected:
+    /*! Writes the result of processing \a inbuf to \a outbuf, which has
+     * the same size as \a inbuf and is writable. */
+    virtual FlowReturn transform(const BufferPtr & inbuf, const BufferPtr & outbuf) = 0;
+
+#ifndef DOXYGEN_RUN
+public:
+    static Private::ElementImplKind implKind() { return Private::TransformKind; }
+#endif
+
+private:
+    friend struct Private::ElementImplAccess;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Base class for elements that modify the buffers in place
+ */
+class QTGSTREAMER_EXPORT FilterImpl : public BaseTransformImpl
+{
+protected:
+    /*! Processes \a buffer, which is writable, in place. */
+    virtual FlowReturn filter(const BufferPtr & buffer) = 0;
+
+#ifndef DOXYGEN_RUN
+public:
+    static Private::ElementImplKind implKind() { return Private::FilterKind; }
+#endif
+
+private:
+    friend struct Private::ElementImplAccess;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Base class for source elements, implemented on top of GstBaseSrc
+ */
+class QTGSTREAMER_EXPORT SourceImpl : public AbstractElementImpl
+{
+public:
+    void setLive(bool live);
+    bool isLive() const;
+    /*! Sets the format of the segment that the source produces. */
+    void setFormat(Format format);
+
+protected:
+    virtual bool start();
+    virtual bool stop();
+
+    /*! Called when the caps of the output are known. */
+    virtual bool setCaps(const CapsPtr & caps);
+
+    /*! Produces the next buffer into \a buffer. \a offset and \a size are the ones
+     * requested by downstream, or -1 if any are fine. Return FlowEos to end the stream. */
+    virtual FlowReturn create(quint64 offset, uint size, BufferPtr & buffer) = 0;
+
+#ifndef DOXYGEN_RUN
+public:
+    static Private::ElementImplKind implKind() { return Private::SourceKind; }
+#endif
+
+private:
+    friend struct Private::ElementImplAccess;
+};
+
+/*! \headerfile elementimpl.h <QGst/ElementImpl>
+ * \brief Base class for sink elements, implemented on top of GstBaseSink
+ */
+class QTGSTREAMER_EXPORT SinkImpl : public AbstractElementImpl
+{
+public:
+    /*! Sets whether the buffers are rendered in sync with the clock. */
+    void setSync(bool sync);
+    bool isSync() const;
+
+protected:
+    virtual bool start();
+    virtual bool stop();
+
+    /*! Called when the caps of the input are known. */
+    virtual bool setCaps(const CapsPtr & caps);
+
+    /*! Renders \a buffer. */
+    virtual FlowReturn render(const BufferPtr & buffer) = 0;
+
+    /*! Called with the allocation query of the elements upstream, to which the sink
+     * can add the pools, allocators and metas that it supports, for example an
+     * allocator created with AllocatorImpl::create(). The default implementation
+     * is the one of GstBaseSink. */
+    virtual bool proposeAllocation(const AllocationQueryPtr & query);
+
+#ifndef DOXYGEN_RUN
+public:
+    static Private::ElementImplKind implKind() { return Private::SinkKind; }
+#endif
+
+private:
+    friend struct Private::ElementImplAccess;
+};
+
+#ifndef DOXYGEN_RUN
+namespace Private {
+
+typedef AbstractElementImpl *(*ElementImplFactory)();
+
+template <class T>
+AbstractElementImpl *createElementImpl()
+{
+    return new T;
+}
+
+QTGSTREAMER_EXPORT QGlib::Type registerElementType(const char *typeName, ElementImplKind kind,
+                                                   const ElementMetadata & metadata,
+                                                   ElementImplFactory factory);
+QTGSTREAMER_EXPORT bool registerElement(const char *name, Rank rank, QGlib::Type type);
+
+} //namespace Private
+#endif
+
+/*! Registers a new GType named \a typeName for elements that are implemented by \a T,
+ * which must be a subclass of ElementImpl, TransformImpl, FilterImpl, SourceImpl
+ * or SinkImpl. If the type is already registered, the existing one is returned.
+ * \relates AbstractElementImpl
+ */
+template <class T>
+QGlib::Type registerElementType(const char *typeName, const ElementMetadata & metadata)
+{
+    return Private::registerElementType(typeName, T::implKind(), metadata,
+                                        &Private::createElementImpl<T>);
+}
+
+/*! Registers an element factory called \a name for elements that are implemented by \a T,
+ * so that they can be created with ElementFactory::make() and Parse::launch().
+ * The GType of the element is registered as well, as with registerElementType().
+ * \relates AbstractElementImpl
+ */
+template <class T>
+bool registerElement(const char *name, Rank rank, const ElementMetadata & metadata)
+{
+    QByteArray typeName = "QGstElementImpl-" + QByteArray(name);
+    QGlib::Type type = registerElementType<T>(typeName.constData(), metadata);
+    return Private::registerElement(name, rank, type);
+}
+
+} //namespace QGst
+
+#endif // QGST_ELEMENTIMPL_H
@@ -213,6 +213,8 @@ REGISTER_TYPE_IMPLEMENTATION(QGst::StateChangeReturn,GST_TYPE_STATE_CHANGE_RETUR
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadDirection,GST_TYPE_PAD_DIRECTION)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::PadPresence,GST_TYPE_PAD_PRESENCE)
+
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadFlags,GST_TYPE_PAD_FLAGS)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadLinkReturn,GST_TYPE_PAD_LINK_RETURN)
@@ -221,6 +223,10 @@ REGISTER_TYPE_IMPLEMENTATION(QGst::FlowReturn,GST_TYPE_FLOW_RETURN)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadMode,GST_TYPE_PAD_MODE)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::PadProbeTypes,GST_TYPE_PAD_PROBE_TYPE)
+
+REGISTER_TYPE_IMPLEMENTATION(QGst::PadProbeReturn,GST_TYPE_PAD_PROBE_RETURN)
+
 REGISTER_TYPE_IMPLEMENTATION(QGst::Rank,GST_TYPE_RANK)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::MessageType,GST_TYPE_MESSAGE_TYPE)
@@ -265,6 +271,8 @@ REGISTER_TYPE_IMPLEMENTATION(QGst::MapFlags,GST_TYPE_MAP_FLAGS)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::MemoryFlags,GST_TYPE_MEMORY_FLAGS)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::BufferPoolAcquireFlags,GST_TYPE_BUFFER_POOL_ACQUIRE_FLAGS)
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(MiniObjectFlagLockable) == static_cast<int>(GST_MINI_OBJECT_FLAG_LOCKABLE));
     BOOST_STATIC_ASSERT(static_cast<int>(MiniObjectFlagLockReadonly) == static_cast<int>(GST_MINI_OBJECT_FLAG_LOCK_READONLY));
@@ -305,6 +313,12 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(PadSink) == static_cast<int>(GST_PAD_SINK));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(PadAlways) == static_cast<int>(GST_PAD_ALWAYS));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadSometimes) == static_cast<int>(GST_PAD_SOMETIMES));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadRequest) == static_cast<int>(GST_PAD_REQUEST));
+}
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(PadFlagBlocked) == static_cast<int>(GST_PAD_FLAG_BLOCKED));
     BOOST_STATIC_ASSERT(static_cast<int>(PadFlagFlushing) == static_cast<int>(GST_PAD_FLAG_FLUSHING));
@@ -352,6 +366,38 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(PadModePull) == static_cast<int>(GST_PAD_MODE_PULL));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeInvalid) == static_cast<int>(GST_PAD_PROBE_TYPE_INVALID));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeIdle) == static_cast<int>(GST_PAD_PROBE_TYPE_IDLE));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlock) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCK));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBuffer) == static_cast<int>(GST_PAD_PROBE_TYPE_BUFFER));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBufferList) == static_cast<int>(GST_PAD_PROBE_TYPE_BUFFER_LIST));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventFlush) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_FLUSH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeQueryDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeQueryUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_QUERY_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypePush) == static_cast<int>(GST_PAD_PROBE_TYPE_PUSH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypePull) == static_cast<int>(GST_PAD_PROBE_TYPE_PULL));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlocking) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCKING));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeDataDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_DATA_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeDataUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_DATA_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeDataBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_DATA_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlockDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlockUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCK_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeQueryBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_QUERY_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeAllBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_ALL_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeScheduling) == static_cast<int>(GST_PAD_PROBE_TYPE_SCHEDULING));
+}
+
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeDrop) == static_cast<int>(GST_PAD_PROBE_DROP));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeOk) == static_cast<int>(GST_PAD_PROBE_OK));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeRemove) == static_cast<int>(GST_PAD_PROBE_REMOVE));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbePass) == static_cast<int>(GST_PAD_PROBE_PASS));
+}
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(RankNone) == static_cast<int>(GST_RANK_NONE));
     BOOST_STATIC_ASSERT(static_cast<int>(RankMarginal) == static_cast<int>(GST_RANK_MARGINAL));
@@ -610,6 +656,14 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(MemoryFlagLast) == static_cast<int>(GST_MEMORY_FLAG_LAST));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagNone) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_NONE));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagKeyUnit) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_KEY_UNIT));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagDontWait) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagDiscont) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_DISCONT));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagLast) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_LAST));
+}
+
 #include "QGst/objectstore_p.h"
 
 #include "QGst/ghostpad.h"
@@ -831,6 +885,19 @@ namespace QGst {
   }
 } //namespace QGst
 
+#include "QGst/bufferpool.h"
+
+REGISTER_TYPE_IMPLEMENTATION(QGst::BufferPool,GST_TYPE_BUFFER_POOL)
+
+namespace QGst {
+  QGlib::RefCountedObject *BufferPool_new(void *instance)
+  {
+    QGst::BufferPool *cppClass = new QGst::BufferPool;
+    cppClass->m_object = instance;
+    return cppClass;
+  }
+} //namespace QGst
+
 #include "QGst/devicemonitor.h"
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::DeviceMonitor,GST_TYPE_DEVICE_MONITOR)
@@ -1048,6 +1115,9 @@ namespace QGst {
     case QGst::QueryUri:
       cppClass = new QGst::UriQuery;
       break;
+    case QGst::QueryAllocation:
+      cppClass = new QGst::AllocationQuery;
+      break;
     default:
       cppClass = new QGst::Query;
       break;
@@ -1097,6 +1167,7 @@ namespace Private {
     QGlib::GetType<Caps>().setQuarkData(q, reinterpret_cast<void*>(&Caps_new));
     QGlib::GetType<Buffer>().setQuarkData(q, reinterpret_cast<void*>(&Buffer_new));
     QGlib::GetType<Allocator>().setQuarkData(q, reinterpret_cast<void*>(&Allocator_new));
+    QGlib::GetType<BufferPool>().setQuarkData(q, reinterpret_cast<void*>(&BufferPool_new));
     QGlib::GetType<DeviceMonitor>().setQuarkData(q, reinterpret_cast<void*>(&DeviceMonitor_new));
     QGlib::GetType<Device>().setQuarkData(q, reinterpret_cast<void*>(&Device_new));
     QGlib::GetType<Event>().setQuarkData(q, reinterpret_cast<void*>(&Event_new));
@@ -123,8 +123,10 @@ QGST_WRAPPER_REFPOINTER_DECLARATION(ConvertQuery)
 QGST_WRAPPER_REFPOINTER_DECLARATION(FormatsQuery)
 QGST_WRAPPER_REFPOINTER_DECLARATION(BufferingQuery)
 QGST_WRAPPER_REFPOINTER_DECLARATION(UriQuery)
+QGST_WRAPPER_REFPOINTER_DECLARATION(AllocationQuery)
 QGST_WRAPPER_DECLARATION(Buffer)
 QGST_WRAPPER_DECLARATION(Allocator)
+QGST_WRAPPER_DECLARATION(BufferPool)
 QGST_WRAPPER_DECLARATION(Memory)
 QGST_WRAPPER_DECLARATION(BufferList)
 QGST_WRAPPER_DECLARATION(Event)
@@ -147,13 +149,18 @@ QGST_WRAPPER_GSTCLASS_DECLARATION(Structure)
 QGST_WRAPPER_GSTCLASS_DECLARATION(TagList)
 QGST_WRAPPER_GSTCLASS_DECLARATION(Segment)
 QGST_WRAPPER_GSTCLASS_DECLARATION(AllocationParams)
+QGST_WRAPPER_GSTCLASS_DECLARATION(PadProbeInfo)
 namespace QGst {
     class Structure;
     class SharedStructure;
     typedef QSharedPointer<SharedStructure> StructurePtr;
     typedef QSharedPointer<const SharedStructure> StructureConstPtr;
     class AllocationParams;
+    class BufferPoolConfig;
     class MapInfo;
+    class MappedBuffer;
+    class MappedMemory;
+    class PadProbeInfo;
     class Segment;
 }
 QGST_WRAPPER_GSTCLASS_DECLARATION(URIHandler)
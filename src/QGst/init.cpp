@@ -17,6 +17,7 @@
 #include "init.h"
 #include "../QGlib/init.h"
 #include "../QGlib/error.h"
+#include "../QGlib/wrap.h"
 #include <gst/gst.h>
 
 namespace QGst {
@@ -40,6 +41,7 @@ void init(int *argc, char **argv[])
     }
     Private::registerValueVTables();
     Private::registerWrapperConstructors();
+    QGlib::Private::invalidateWrapperConstructorCache();
 }
 
 void cleanup()
@@ -17,6 +17,7 @@
 #include "allocator.h"
 #include "memory.h"
 #include "buffer.h"
+#include <cstring>
 #include <gst/gst.h>
 
 namespace QGst {
@@ -89,5 +90,105 @@ void Memory::unmap(MapInfo &info)
     gst_memory_unmap(object<GstMemory>(), static_cast<GstMapInfo*>(info.m_object));
 }
 
+//-----------------------
+
+QGLIB_STATIC_ASSERT(sizeof(GstMapInfo) <= sizeof(void*[16]),
+                    "MappedMemory::m_info is too small to hold a GstMapInfo");
+
+MappedMemory::MappedMemory(const MemoryPtr & memory, MapFlags flags)
+    : m_buffer(NULL)
+{
+    map(static_cast<GstMemory*>(memory), flags);
+}
+
+MappedMemory::MappedMemory(const BufferPtr & buffer, uint index, MapFlags flags)
+    : m_buffer(NULL)
+{
+    GstMapInfo *info = reinterpret_cast<GstMapInfo*>(m_info);
+    memset(info, 0, sizeof(GstMapInfo));
+
+    //unlike gst_memory_map(), this checks that the buffer is writable for MapWrite,
+    //and it still maps the single memory in place, without merging anything
+    m_mapped = buffer && index < gst_buffer_n_memory(buffer)
+            && gst_buffer_map_range(buffer, index, 1, info,
+                                    static_cast<GstMapFlags>(static_cast<int>(flags)));
+    if (m_mapped) {
+        m_buffer = gst_buffer_ref(buffer);
+    }
+}
+
+#ifndef BOOST_NO_RVALUE_REFERENCES
+MappedMemory::MappedMemory(MappedMemory && other)
+    : m_buffer(other.m_buffer), m_mapped(other.m_mapped)
+{
+    memcpy(m_info, other.m_info, sizeof(m_info));
+    memset(other.m_info, 0, sizeof(other.m_info));
+    other.m_buffer = NULL;
+    other.m_mapped = false;
+}
+#endif
+
+MappedMemory::~MappedMemory()
+{
+    if (m_mapped) {
+        GstMapInfo *info = reinterpret_cast<GstMapInfo*>(m_info);
+        if (m_buffer) {
+            //also drops the reference on the memory that the mapping holds
+            GstBuffer *buffer = static_cast<GstBuffer*>(m_buffer);
+            gst_buffer_unmap(buffer, info);
+            gst_buffer_unref(buffer);
+        } else {
+            GstMemory *memory = info->memory;
+            gst_memory_unmap(memory, info);
+            gst_memory_unref(memory);
+        }
+    }
+}
+
+void MappedMemory::map(void *memory, MapFlags flags)
+{
+    GstMapInfo *info = reinterpret_cast<GstMapInfo*>(m_info);
+    memset(info, 0, sizeof(GstMapInfo));
+
+    m_mapped = memory && gst_memory_map(static_cast<GstMemory*>(memory), info,
+                                        static_cast<GstMapFlags>(static_cast<int>(flags)));
+    if (m_mapped) {
+        //the mapping does not keep the memory alive by itself
+        gst_memory_ref(info->memory);
+    }
+}
+
+bool MappedMemory::isValid() const
+{
+    return m_mapped;
+}
+
+MapFlags MappedMemory::flags() const
+{
+    return static_cast<MapFlag>(reinterpret_cast<const GstMapInfo*>(m_info)->flags);
+}
+
+quint8 *MappedMemory::data() const
+{
+    return reinterpret_cast<const GstMapInfo*>(m_info)->data;
+}
+
+const quint8 *MappedMemory::constData() const
+{
+    return reinterpret_cast<const GstMapInfo*>(m_info)->data;
+}
+
+size_t MappedMemory::size() const
+{
+    return reinterpret_cast<const GstMapInfo*>(m_info)->size;
+}
+
+QByteArray MappedMemory::byteArrayView() const
+{
+    const GstMapInfo *info = reinterpret_cast<const GstMapInfo*>(m_info);
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(info->data),
+                                   static_cast<int>(info->size));
+}
+
 } // namespace QGst
 
@@ -19,6 +19,7 @@
 
 #include "global.h"
 #include "miniobject.h"
+#include <QtCore/QByteArray>
 
 namespace QGst {
 
@@ -64,6 +65,65 @@ public:
     void unmap(MapInfo &info);
 };
 
+/*! \headerfile memory.h <QGst/QGstMemory>
+ * \brief Maps a Memory for as long as it exists
+ *
+ * MappedMemory maps the memory that it is given in its constructor and unmaps
+ * it when it goes out of scope. Unlike MapInfo, it does not allocate anything,
+ * so it is meant to be created on the stack for reading payloads:
+ * \code
+ * for (uint i = 0; i < buffer->memoryCount(); ++i) {
+ *     QGst::MappedMemory mapped(buffer, i);
+ *     if (mapped.isValid()) {
+ *         parse(mapped.constData(), mapped.size());
+ *     }
+ * }
+ * \endcode
+ *
+ * Mapping the memories of a buffer one by one, as above, avoids the copy that
+ * mapping the whole of a buffer that consists of several memories involves.
+ * The memory is kept alive until it is unmapped.
+ *
+ * \sa MappedBuffer
+ */
+class QTGSTREAMER_EXPORT MappedMemory
+{
+public:
+    explicit MappedMemory(const MemoryPtr & memory, MapFlags flags = MapRead);
+    /*! Maps the memory at \a index in \a buffer. Like Buffer::map(), this fails
+     * with MapWrite if the buffer is not writable. */
+    MappedMemory(const BufferPtr & buffer, uint index, MapFlags flags = MapRead);
+#ifndef BOOST_NO_RVALUE_REFERENCES
+    /*! Takes over the mapping of \a other, which becomes invalid. */
+    MappedMemory(MappedMemory && other);
+#endif
+    ~MappedMemory();
+
+    /*! Returns false if the memory could not be mapped. */
+    bool isValid() const;
+    MapFlags flags() const;
+
+    /*! Returns the mapped data. It may only be written to if
+     * the memory was mapped with MapWrite. */
+    quint8 *data() const;
+    const quint8 *constData() const;
+    size_t size() const;
+
+    /*! Returns a QByteArray that refers to the mapped data without copying it.
+     * \note The returned QByteArray, and any copy of it, must not be used
+     * after this MappedMemory is destroyed. */
+    QByteArray byteArrayView() const;
+
+private:
+    Q_DISABLE_COPY(MappedMemory);
+    void map(void *memory, MapFlags flags);
+
+    //large enough to hold a GstMapInfo without allocating one
+    void *m_info[16];
+    void *m_buffer; //the buffer that was mapped, if any
+    bool m_mapped;
+};
+
 } // namespace QGst
 
 QGST_REGISTER_TYPE(QGst::Memory)
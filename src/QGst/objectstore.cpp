@@ -18,17 +18,105 @@
 
 #include <QtCore/QMutex>
 #include <QtCore/QHash>
+#include <QtCore/QtAlgorithms>
 #include <QtCore/QAtomicInt>
+#include <QtCore/QAtomicPointer>
 
 #include "objectstore_p.h"
 
 namespace {
+    /* The store is split in a number of independently locked shards, selected
+     * by the address of the wrapper, so that threads that wrap different
+     * objects do not contend on the same lock.
+     *
+     * Only the first put() and the last take() of a wrapper need the lock of
+     * its shard. Every wrapper in the store has a node holding its count and
+     * each shard keeps a small direct mapped cache of recently used nodes, so
+     * that the other calls, which are the ones made by copies of the smart
+     * pointers, can find the node and update its count atomically without it.
+     * Those calls come from someone that holds a reference on the wrapper, so
+     * its node cannot go away under them. Nodes are recycled instead of freed
+     * while the store exists, which makes it safe to read the key of a stale
+     * cached node; a key that matches means that the node is the live one. */
+    enum { ShardCount = 64, CacheSize = 64 };
+
+    struct Node
+    {
+        QAtomicPointer<void> key; //null while the node is free
+        QAtomicInt count;
+        Node *nextFree;           //guarded by the mutex of the shard
+    };
+
+    struct Shard
+    {
+        Shard() : freeList(NULL) {}
+        ~Shard()
+        {
+            qDeleteAll(nodes);
+            while (freeList) {
+                Node *next = freeList->nextFree;
+                delete freeList;
+                freeList = next;
+            }
+        }
+
+        QMutex mutex;
+        QHash<const void *, Node *> nodes; //guarded by mutex
+        Node *freeList;                    //guarded by mutex
+        QAtomicPointer<Node> cache[CacheSize];
+        char padding[64]; //keep the mutexes of neighbouring shards on different cache lines
+    };
+
     class GlobalStore
     {
     public:
-        QMutex mutex;
-        QHash<const void *, QAtomicInt> refCount;
+        static inline quintptr hashOf(const void *ptr)
+        {
+            quintptr key = reinterpret_cast<quintptr>(ptr);
+            return (key >> 4) ^ (key >> 10);
+        }
+
+        inline Shard & shardFor(const void *ptr)
+        {
+            return shards[hashOf(ptr) & (ShardCount - 1)];
+        }
+
+        static inline QAtomicPointer<Node> & cacheSlotFor(Shard & shard, const void *ptr)
+        {
+            return shard.cache[(hashOf(ptr) / ShardCount) & (CacheSize - 1)];
+        }
+
+        Shard shards[ShardCount];
     };
+
+    template <typename T>
+    inline T *loadAcquire(const QAtomicPointer<T> & p)
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        return p.loadAcquire();
+#else
+        return p;
+#endif
+    }
+
+    inline int load(const QAtomicInt & i)
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        return i.load();
+#else
+        return i;
+#endif
+    }
+
+    //returns the node of ptr if it is in the cache, without locking
+    inline Node *cachedNode(Shard & shard, const void *ptr)
+    {
+        Node *node = loadAcquire(GlobalStore::cacheSlotFor(shard, ptr));
+        if (node && loadAcquire(node->key) == ptr) {
+            return node;
+        }
+        return NULL;
+    }
 }
 
 Q_GLOBAL_STATIC(GlobalStore, globalStore)
@@ -38,48 +126,78 @@ namespace Private {
 
 bool ObjectStore::put(const void * ptr)
 {
-    bool mustAddStrongRef = false;
     GlobalStore *const gs = globalStore();
-    if (!gs) return mustAddStrongRef;
+    if (!gs) return false;
+
+    Shard & shard = gs->shardFor(ptr);
 
-    QMutexLocker lock(&gs->mutex);
-    if (!gs->refCount.contains(ptr)) {
-        gs->refCount.insert(ptr, QAtomicInt(0));
-        mustAddStrongRef = true;
+    //fast path for a wrapper that is already referenced
+    if (Node *node = cachedNode(shard, ptr)) {
+        node->count.ref();
+        return false;
     }
-    (gs->refCount[ptr]).ref();
 
-    return mustAddStrongRef;
+    QMutexLocker lock(&shard.mutex);
+
+    Node *node = shard.nodes.value(ptr);
+    if (node) {
+        node->count.ref();
+        GlobalStore::cacheSlotFor(shard, ptr).fetchAndStoreRelease(node);
+        return false;
+    }
+
+    if (shard.freeList) {
+        node = shard.freeList;
+        shard.freeList = node->nextFree;
+    } else {
+        node = new Node;
+    }
+    node->count.fetchAndStoreRelaxed(1);
+    node->key.fetchAndStoreRelease(const_cast<void*>(ptr));
+    shard.nodes.insert(ptr, node);
+    GlobalStore::cacheSlotFor(shard, ptr).fetchAndStoreRelease(node);
+
+    //this is the first binding (weak) reference
+    return true;
 }
 
 bool ObjectStore::take(const void * ptr)
 {
-    bool mustSubtractStrongRef = false;
     GlobalStore *const gs = globalStore();
-    if (!gs) return mustSubtractStrongRef;
+    if (!gs) return false;
 
-    QMutexLocker lock(&gs->mutex);
+    Shard & shard = gs->shardFor(ptr);
+
+    //fast path for a reference that is not the last one
+    if (Node *node = cachedNode(shard, ptr)) {
+        for (int count = load(node->count); count > 1; count = load(node->count)) {
+            if (node->count.testAndSetOrdered(count, count - 1)) {
+                return false;
+            }
+        }
+    }
+
+    QMutexLocker lock(&shard.mutex);
+
+    Node *node = shard.nodes.value(ptr);
 
     //Make sure there are no extra unrefs()
-    Q_ASSERT(gs->refCount.contains(ptr));
+    Q_ASSERT(node);
 
-    if (!gs->refCount.contains(ptr)) {
+    if (!node) {
         return false;
     }
 
     //Decrease our bindings (weak) reference count
-    (gs->refCount[ptr]).deref();
-
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    if (!gs->refCount[ptr].load()) {
-#else
-    if (!gs->refCount[ptr]) {
-#endif
-        //refCount is 0
-        gs->refCount.remove(ptr);
-        mustSubtractStrongRef = true;
+    if (!node->count.deref()) {
+        shard.nodes.remove(ptr);
+        GlobalStore::cacheSlotFor(shard, ptr).testAndSetOrdered(node, NULL);
+        node->key.fetchAndStoreRelease(NULL);
+        node->nextFree = shard.freeList;
+        shard.freeList = node;
+        return true;
     }
-    return mustSubtractStrongRef;
+    return false;
 }
 
 bool ObjectStore::isEmpty()
@@ -87,10 +205,11 @@ bool ObjectStore::isEmpty()
     GlobalStore *const gs = globalStore();
     if (!gs) return true;
 
-    QMutexLocker lock(&gs->mutex);
-
-    if (gs->refCount.count()>0) {
-        return false;
+    for (int i = 0; i < ShardCount; ++i) {
+        QMutexLocker lock(&gs->shards[i].mutex);
+        if (!gs->shards[i].nodes.isEmpty()) {
+            return false;
+        }
     }
 
     return true;
@@ -19,11 +19,65 @@
 #include "element.h"
 #include "query.h"
 #include "event.h"
+#include "buffer.h"
+#include "bufferlist.h"
 #include <QtCore/QDebug>
 #include <gst/gst.h>
 
 namespace QGst {
 
+PadProbeTypes PadProbeInfo::type() const
+{
+    return static_cast<PadProbeType>(GST_PAD_PROBE_INFO_TYPE(m_info));
+}
+
+ulong PadProbeInfo::id() const
+{
+    return GST_PAD_PROBE_INFO_ID(m_info);
+}
+
+quint64 PadProbeInfo::offset() const
+{
+    return GST_PAD_PROBE_INFO_OFFSET(m_info);
+}
+
+uint PadProbeInfo::size() const
+{
+    return GST_PAD_PROBE_INFO_SIZE(m_info);
+}
+
+BufferPtr PadProbeInfo::buffer() const
+{
+    if (GST_PAD_PROBE_INFO_TYPE(m_info) & GST_PAD_PROBE_TYPE_BUFFER) {
+        return BufferPtr::wrap(GST_PAD_PROBE_INFO_BUFFER(m_info));
+    }
+    return BufferPtr();
+}
+
+BufferListPtr PadProbeInfo::bufferList() const
+{
+    if (GST_PAD_PROBE_INFO_TYPE(m_info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+        return BufferListPtr::wrap(GST_PAD_PROBE_INFO_BUFFER_LIST(m_info));
+    }
+    return BufferListPtr();
+}
+
+EventPtr PadProbeInfo::event() const
+{
+    if (GST_PAD_PROBE_INFO_TYPE(m_info) & GST_PAD_PROBE_TYPE_EVENT_BOTH) {
+        return EventPtr::wrap(GST_PAD_PROBE_INFO_EVENT(m_info));
+    }
+    return EventPtr();
+}
+
+QueryPtr PadProbeInfo::query() const
+{
+    if (GST_PAD_PROBE_INFO_TYPE(m_info) & GST_PAD_PROBE_TYPE_QUERY_BOTH) {
+        return QueryPtr::wrap(GST_PAD_PROBE_INFO_QUERY(m_info));
+    }
+    return QueryPtr();
+}
+
 //static
 PadPtr Pad::create(PadDirection direction, const char *name)
 {
@@ -117,4 +171,28 @@ bool Pad::sendEvent(const EventPtr &event)
     return gst_pad_send_event(object<GstPad>(), event);
 }
 
+static GstPadProbeReturn padProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer userData)
+{
+    Private::PadProbeCallbackBase *callback = static_cast<Private::PadProbeCallbackBase*>(userData);
+    return static_cast<GstPadProbeReturn>(callback->invoke(pad, PadProbeInfo(info)));
+}
+
+static void padProbeDestroyNotify(gpointer userData)
+{
+    delete static_cast<Private::PadProbeCallbackBase*>(userData);
+}
+
+ulong Pad::addProbeCallback(PadProbeTypes mask, Private::PadProbeCallbackBase *callback)
+{
+    //the callback is deleted by GStreamer when the probe is removed,
+    //which also happens if it is never installed
+    return gst_pad_add_probe(object<GstPad>(), static_cast<GstPadProbeType>(int(mask)),
+                             &padProbeCallback, callback, &padProbeDestroyNotify);
+}
+
+void Pad::removeProbe(ulong id)
+{
+    gst_pad_remove_probe(object<GstPad>(), id);
+}
+
 }
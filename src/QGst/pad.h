@@ -21,6 +21,40 @@
 
 namespace QGst {
 
+/*! \headerfile pad.h <QGst/Pad>
+ * \brief Wrapper class for GstPadProbeInfo
+ *
+ * This is passed to the generic pad probe callbacks that are installed
+ * with Pad::addProbe(). It is only valid during the callback.
+ */
+class QTGSTREAMER_EXPORT PadProbeInfo
+{
+public:
+    explicit PadProbeInfo(GstPadProbeInfo *info) : m_info(info) {}
+
+    /*! Returns the type of the probe that triggered the callback and the
+     * type of the data that is passed, if any. */
+    PadProbeTypes type() const;
+    ulong id() const;
+
+    quint64 offset() const;
+    uint size() const;
+
+    /*! These return the data that is passed through the pad,
+     * or a null pointer if it is of a different type. */
+    BufferPtr buffer() const;
+    BufferListPtr bufferList() const;
+    EventPtr event() const;
+    QueryPtr query() const;
+
+private:
+    GstPadProbeInfo *m_info;
+};
+
+namespace Private {
+    class PadProbeCallbackBase;
+}
+
 /*! \headerfile pad.h <QGst/Pad>
  * \brief Wrapper class for GstPad
  */
@@ -56,8 +90,155 @@ public:
 
     bool query(const QueryPtr & query);
     bool sendEvent(const EventPtr & event);
+
+    /*! Installs a probe on this pad that calls \a method of \a receiver
+     * for the data of the given type that passes through the pad:
+     * \code
+     * QGst::PadProbeReturn MyObject::onBuffer(const QGst::BufferPtr & buffer);
+     * QGst::PadProbeReturn MyObject::onEvent(const QGst::EventPtr & event);
+     * ...
+     * pad->addProbe(QGst::PadProbeTypeBuffer, this, &MyObject::onBuffer);
+     * pad->addProbe(QGst::PadProbeTypeEventDownstream, this, &MyObject::onEvent);
+     * \endcode
+     * The argument of the method may be a BufferPtr, BufferListPtr, EventPtr or
+     * QueryPtr. The data is passed to it directly, without being converted to a
+     * QGlib::Value, so this is much cheaper than connecting to the handoff signal
+     * of an identity element. If \a mask does not include any type that matches
+     * the argument, all of them are added (e.g. PadProbeTypeBlock with a BufferPtr
+     * argument installs a blocking buffer probe). Data of other types that are
+     * included in \a mask is let through without calling the method.
+     *
+     * The method is called from the streaming thread, and \a receiver must stay
+     * alive until the probe is removed, either with removeProbe() or by returning
+     * PadProbeRemove from the method.
+     *
+     * Returns the id of the probe, or 0 if the probe was not installed or if it was
+     * removed before this function returned, which can happen with idle probes.
+     * \sa gst_pad_add_probe()
+     */
+    template <typename T, typename Data>
+    ulong addProbe(PadProbeTypes mask, T *receiver, PadProbeReturn (T::*method)(const Data &));
+
+    /*! Installs a probe that calls \a method of \a receiver with the pad
+     * and a PadProbeInfo for every probe type in \a mask. This is meant
+     * for blocking and idle probes, which are not necessarily called with
+     * any data, and for probes that handle more than one type of data.
+     * \overload
+     */
+    template <typename T>
+    ulong addProbe(PadProbeTypes mask, T *receiver,
+                   PadProbeReturn (T::*method)(const PadPtr &, const PadProbeInfo &));
+
+    /*! Removes the probe with the given \a id, as returned by addProbe(). */
+    void removeProbe(ulong id);
+
+private:
+    ulong addProbeCallback(PadProbeTypes mask, Private::PadProbeCallbackBase *callback);
 };
 
+namespace Private {
+
+/* Helps the Pad::addProbe() templates to call the callback with the
+ * data of the probe, and to install the probe for the right types. These
+ * are partial specializations so that the wrapper classes only need to be
+ * complete where addProbe() is used. */
+template <typename T, typename Dummy = void>
+struct PadProbeData {};
+
+template <typename Dummy>
+struct PadProbeData<BufferPtr, Dummy>
+{
+    static PadProbeType types() { return PadProbeTypeBuffer; }
+    static BufferPtr get(const PadProbeInfo & info) { return info.buffer(); }
+};
+
+template <typename Dummy>
+struct PadProbeData<BufferListPtr, Dummy>
+{
+    static PadProbeType types() { return PadProbeTypeBufferList; }
+    static BufferListPtr get(const PadProbeInfo & info) { return info.bufferList(); }
+};
+
+template <typename Dummy>
+struct PadProbeData<EventPtr, Dummy>
+{
+    static PadProbeType types() { return PadProbeTypeEventBoth; }
+    static EventPtr get(const PadProbeInfo & info) { return info.event(); }
+};
+
+template <typename Dummy>
+struct PadProbeData<QueryPtr, Dummy>
+{
+    static PadProbeType types() { return PadProbeTypeQueryBoth; }
+    static QueryPtr get(const PadProbeInfo & info) { return info.query(); }
+};
+
+class QTGSTREAMER_EXPORT PadProbeCallbackBase
+{
+public:
+    virtual ~PadProbeCallbackBase() {}
+    virtual PadProbeReturn invoke(GstPad *pad, const PadProbeInfo & info) = 0;
+};
+
+template <typename T, typename Data>
+class PadProbeCallback : public PadProbeCallbackBase
+{
+public:
+    typedef PadProbeReturn (T::*Method)(const Data &);
+
+    inline PadProbeCallback(T *receiver, Method method)
+        : m_receiver(receiver), m_method(method) {}
+
+    virtual PadProbeReturn invoke(GstPad *pad, const PadProbeInfo & info)
+    {
+        Q_UNUSED(pad);
+        Data data = PadProbeData<Data>::get(info);
+        //other types of data, if the mask allows them, pass untouched
+        return !data.isNull() ? (m_receiver->*m_method)(data) : PadProbeOk;
+    }
+
+private:
+    T *m_receiver;
+    Method m_method;
+};
+
+template <typename T>
+class PadProbeInfoCallback : public PadProbeCallbackBase
+{
+public:
+    typedef PadProbeReturn (T::*Method)(const PadPtr &, const PadProbeInfo &);
+
+    inline PadProbeInfoCallback(T *receiver, Method method)
+        : m_receiver(receiver), m_method(method) {}
+
+    virtual PadProbeReturn invoke(GstPad *pad, const PadProbeInfo & info)
+    {
+        return (m_receiver->*m_method)(PadPtr::wrap(pad), info);
+    }
+
+private:
+    T *m_receiver;
+    Method m_method;
+};
+
+} //namespace Private
+
+template <typename T, typename Data>
+ulong Pad::addProbe(PadProbeTypes mask, T *receiver, PadProbeReturn (T::*method)(const Data &))
+{
+    if (!(mask & Private::PadProbeData<Data>::types())) {
+        mask |= Private::PadProbeData<Data>::types();
+    }
+    return addProbeCallback(mask, new Private::PadProbeCallback<T, Data>(receiver, method));
+}
+
+template <typename T>
+ulong Pad::addProbe(PadProbeTypes mask, T *receiver,
+                    PadProbeReturn (T::*method)(const PadPtr &, const PadProbeInfo &))
+{
+    return addProbeCallback(mask, new Private::PadProbeInfoCallback<T>(receiver, method));
+}
+
 }
 
 QGST_REGISTER_TYPE(QGst::Pad)
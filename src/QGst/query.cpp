@@ -17,6 +17,8 @@
 */
 #include "query.h"
 #include "element.h"
+#include "caps.h"
+#include "bufferpool.h"
 #include "../QGlib/error.h"
 #include "../QGlib/string_p.h"
 #include <QtCore/QUrl>
@@ -399,4 +401,137 @@ void UriQuery::setUri(const QUrl & uri)
     gst_query_set_uri(object<GstQuery>(), uri.toEncoded());
 }
 
+//********************************************************
+
+AllocationQueryPtr AllocationQuery::create(const CapsPtr & caps, bool needPool)
+{
+    return AllocationQueryPtr::wrap(gst_query_new_allocation(caps, needPool), false);
+}
+
+CapsPtr AllocationQuery::caps() const
+{
+    GstCaps *c;
+    gst_query_parse_allocation(object<GstQuery>(), &c, NULL);
+    return CapsPtr::wrap(c);
+}
+
+bool AllocationQuery::needPool() const
+{
+    gboolean n;
+    gst_query_parse_allocation(object<GstQuery>(), NULL, &n);
+    return n;
+}
+
+uint AllocationQuery::poolCount() const
+{
+    return gst_query_get_n_allocation_pools(object<GstQuery>());
+}
+
+BufferPoolPtr AllocationQuery::pool(uint index) const
+{
+    GstBufferPool *p;
+    gst_query_parse_nth_allocation_pool(object<GstQuery>(), index, &p, NULL, NULL, NULL);
+    return BufferPoolPtr::wrap(p, false);
+}
+
+uint AllocationQuery::poolSize(uint index) const
+{
+    guint s;
+    gst_query_parse_nth_allocation_pool(object<GstQuery>(), index, NULL, &s, NULL, NULL);
+    return s;
+}
+
+uint AllocationQuery::poolMinBuffers(uint index) const
+{
+    guint m;
+    gst_query_parse_nth_allocation_pool(object<GstQuery>(), index, NULL, NULL, &m, NULL);
+    return m;
+}
+
+uint AllocationQuery::poolMaxBuffers(uint index) const
+{
+    guint m;
+    gst_query_parse_nth_allocation_pool(object<GstQuery>(), index, NULL, NULL, NULL, &m);
+    return m;
+}
+
+void AllocationQuery::addPool(const BufferPoolPtr & pool, uint size,
+                              uint minBuffers, uint maxBuffers)
+{
+    gst_query_add_allocation_pool(object<GstQuery>(), pool, size, minBuffers, maxBuffers);
+}
+
+void AllocationQuery::setPool(uint index, const BufferPoolPtr & pool, uint size,
+                              uint minBuffers, uint maxBuffers)
+{
+    gst_query_set_nth_allocation_pool(object<GstQuery>(), index, pool,
+                                      size, minBuffers, maxBuffers);
+}
+
+void AllocationQuery::removePool(uint index)
+{
+    gst_query_remove_nth_allocation_pool(object<GstQuery>(), index);
+}
+
+uint AllocationQuery::allocatorCount() const
+{
+    return gst_query_get_n_allocation_params(object<GstQuery>());
+}
+
+AllocatorPtr AllocationQuery::allocator(uint index) const
+{
+    GstAllocator *a;
+    gst_query_parse_nth_allocation_param(object<GstQuery>(), index, &a, NULL);
+    return AllocatorPtr::wrap(a, false);
+}
+
+AllocationParams AllocationQuery::allocationParams(uint index) const
+{
+    AllocationParams params;
+    gst_query_parse_nth_allocation_param(object<GstQuery>(), index, NULL, params);
+    return params;
+}
+
+void AllocationQuery::addAllocator(const AllocatorPtr & allocator,
+                                   const AllocationParams & params)
+{
+    gst_query_add_allocation_param(object<GstQuery>(), allocator, params);
+}
+
+void AllocationQuery::setAllocator(uint index, const AllocatorPtr & allocator,
+                                   const AllocationParams & params)
+{
+    gst_query_set_nth_allocation_param(object<GstQuery>(), index, allocator, params);
+}
+
+void AllocationQuery::removeAllocator(uint index)
+{
+    gst_query_remove_nth_allocation_param(object<GstQuery>(), index);
+}
+
+uint AllocationQuery::metaCount() const
+{
+    return gst_query_get_n_allocation_metas(object<GstQuery>());
+}
+
+QGlib::Type AllocationQuery::meta(uint index) const
+{
+    return gst_query_parse_nth_allocation_meta(object<GstQuery>(), index, NULL);
+}
+
+bool AllocationQuery::hasMeta(QGlib::Type api, uint *index) const
+{
+    return gst_query_find_allocation_meta(object<GstQuery>(), api, index);
+}
+
+void AllocationQuery::addMeta(QGlib::Type api)
+{
+    gst_query_add_allocation_meta(object<GstQuery>(), api, NULL);
+}
+
+void AllocationQuery::removeMeta(uint index)
+{
+    gst_query_remove_nth_allocation_meta(object<GstQuery>(), index);
+}
+
 } //namespace QGst
@@ -21,6 +21,7 @@
 #include "miniobject.h"
 #include "structure.h"
 #include "clocktime.h"
+#include "allocator.h"
 
 class QUrl;
 
@@ -213,6 +214,54 @@ public:
     void setUri(const QUrl & uri);
 };
 
+/*! \headerfile query.h <QGst/Query>
+ * \brief Wrapper class for queries of type QGst::QueryAllocation
+ *
+ * The allocation query is sent downstream by an element once it has
+ * negotiated caps, to find out how the buffers it produces should be
+ * allocated. The elements downstream answer it by adding the buffer pools
+ * and allocators that they can provide and the metas that they support.
+ *
+ * \sa BufferPool
+ */
+class QTGSTREAMER_EXPORT AllocationQuery : public Query
+{
+    QGST_WRAPPER_FAKE_SUBCLASS(Allocation, Query)
+public:
+    static AllocationQueryPtr create(const CapsPtr & caps, bool needPool);
+
+    CapsPtr caps() const;
+    bool needPool() const;
+
+    uint poolCount() const;
+    BufferPoolPtr pool(uint index) const;
+    uint poolSize(uint index) const;
+    uint poolMinBuffers(uint index) const;
+    uint poolMaxBuffers(uint index) const;
+    void addPool(const BufferPoolPtr & pool, uint size, uint minBuffers, uint maxBuffers);
+    void setPool(uint index, const BufferPoolPtr & pool, uint size,
+                 uint minBuffers, uint maxBuffers);
+    void removePool(uint index);
+
+    uint allocatorCount() const;
+    AllocatorPtr allocator(uint index) const;
+    AllocationParams allocationParams(uint index) const;
+    void addAllocator(const AllocatorPtr & allocator,
+                      const AllocationParams & params = AllocationParams());
+    void setAllocator(uint index, const AllocatorPtr & allocator,
+                      const AllocationParams & params = AllocationParams());
+    void removeAllocator(uint index);
+
+    uint metaCount() const;
+    /*! \returns the GType of the meta API at \a index */
+    QGlib::Type meta(uint index) const;
+    /*! \returns whether the meta API \a api is supported; if it is and
+     * \a index is not NULL, its index is stored there */
+    bool hasMeta(QGlib::Type api, uint *index = NULL) const;
+    void addMeta(QGlib::Type api);
+    void removeMeta(uint index);
+};
+
 } //namespace QGst
 
 QGST_REGISTER_TYPE(QGst::Query)
@@ -225,5 +274,6 @@ QGST_REGISTER_SUBCLASS(Query, Convert)
 QGST_REGISTER_SUBCLASS(Query, Formats)
 QGST_REGISTER_SUBCLASS(Query, Buffering)
 QGST_REGISTER_SUBCLASS(Query, Uri)
+QGST_REGISTER_SUBCLASS(Query, Allocation)
 
 #endif
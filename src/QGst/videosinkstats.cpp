@@ -0,0 +1,151 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "videosinkstats.h"
+#include <gst/gst.h>
+
+namespace QGst {
+
+VideoSinkStats::VideoSinkStats()
+{
+}
+
+VideoSinkStats::VideoSinkStats(const Structure & structure)
+    : m_structure(structure)
+{
+}
+
+//static
+VideoSinkStats VideoSinkStats::fromSink(const ElementPtr & sink)
+{
+    if (!sink || !sink->findProperty("stats")) {
+        return VideoSinkStats();
+    }
+
+    // GstBaseSink has a "stats" property of its own since GStreamer 1.18,
+    // so elements other than the Qt sinks may well have one too
+    Structure structure = sink->property("stats").get<Structure>();
+    if (structure.name() != QLatin1String("application/x-qt-video-sink-stats")) {
+        return VideoSinkStats();
+    }
+    return VideoSinkStats(structure);
+}
+
+bool VideoSinkStats::isValid() const
+{
+    return m_structure.isValid();
+}
+
+quint64 VideoSinkStats::framesReceived() const
+{
+    return uint64Field("frames-received");
+}
+
+quint64 VideoSinkStats::framesRendered() const
+{
+    return uint64Field("frames-rendered");
+}
+
+quint64 VideoSinkStats::framesDropped() const
+{
+    return uint64Field("frames-dropped");
+}
+
+quint64 VideoSinkStats::paints() const
+{
+    return uint64Field("paints");
+}
+
+ClockTime VideoSinkStats::averageUploadTime() const
+{
+    return uint64Field("upload-time-average");
+}
+
+ClockTime VideoSinkStats::maxUploadTime() const
+{
+    return uint64Field("upload-time-max");
+}
+
+ClockTime VideoSinkStats::averagePaintTime() const
+{
+    return uint64Field("paint-time-average");
+}
+
+ClockTime VideoSinkStats::maxPaintTime() const
+{
+    return uint64Field("paint-time-max");
+}
+
+ClockTime VideoSinkStats::averageLatency() const
+{
+    return uint64Field("latency-average");
+}
+
+ClockTime VideoSinkStats::maxLatency() const
+{
+    return uint64Field("latency-max");
+}
+
+QList<quint64> VideoSinkStats::latencyHistogram() const
+{
+    return uint64ArrayField("latency-histogram");
+}
+
+QList<ClockTime> VideoSinkStats::latencyHistogramLimits() const
+{
+    QList<ClockTime> result;
+    Q_FOREACH(quint64 limit, uint64ArrayField("latency-histogram-limits")) {
+        result.append(limit);
+    }
+    return result;
+}
+
+Structure VideoSinkStats::structure() const
+{
+    return m_structure;
+}
+
+quint64 VideoSinkStats::uint64Field(const char *fieldName) const
+{
+    if (!m_structure.hasFieldTyped(fieldName, QGlib::Type::Uint64)) {
+        return 0;
+    }
+    return m_structure.value(fieldName).get<quint64>();
+}
+
+QList<quint64> VideoSinkStats::uint64ArrayField(const char *fieldName) const
+{
+    QList<quint64> result;
+    if (!isValid()) {
+        return result;
+    }
+
+    // QGlib::Value has no conversion for GstValueArray
+    const GValue *array = gst_structure_get_value(m_structure, fieldName);
+    if (!array || !GST_VALUE_HOLDS_ARRAY(array)) {
+        return result;
+    }
+
+    for (guint i = 0; i < gst_value_array_get_size(array); ++i) {
+        const GValue *value = gst_value_array_get_value(array, i);
+        if (G_VALUE_HOLDS_UINT64(value)) {
+            result.append(g_value_get_uint64(value));
+        }
+    }
+    return result;
+}
+
+} //namespace QGst
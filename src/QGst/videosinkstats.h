@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_VIDEOSINKSTATS_H
+#define QGST_VIDEOSINKSTATS_H
+
+#include "structure.h"
+#include "element.h"
+#include <QtCore/QList>
+
+namespace QGst {
+
+/*! \headerfile videosinkstats.h <QGst/VideoSinkStats>
+ * \brief Rendering statistics of the QtGStreamer video sinks
+ *
+ * The qtvideosink, qtglvideosink, qwidgetvideosink and qtquick2videosink
+ * elements keep track of the frames they receive, render and drop, of the
+ * time they spend uploading and painting frames and of the latency from the
+ * moment a frame reaches the sink until it is painted for the first time.
+ * This class gives typed access to those values, which the sinks expose
+ * as a GstStructure on their "stats" property.
+ *
+ * Example:
+ * \code
+ * QGst::VideoSinkStats stats = QGst::VideoSinkStats::fromSink(surface->videoSink());
+ * qDebug() << stats.framesRendered() << "frames rendered,"
+ *          << stats.framesDropped() << "dropped";
+ * \endcode
+ *
+ * The statistics are reset every time the sink goes from READY to PAUSED.
+ */
+class QTGSTREAMER_EXPORT VideoSinkStats
+{
+public:
+    VideoSinkStats();
+    explicit VideoSinkStats(const Structure & structure);
+
+    /*! Reads the current statistics from the "stats" property of \a sink.
+     * The returned object is invalid if the sink has no such property. */
+    static VideoSinkStats fromSink(const ElementPtr & sink);
+
+    bool isValid() const;
+
+    /*! Returns the number of frames that reached the sink. */
+    quint64 framesReceived() const;
+    /*! Returns the number of frames that were painted at least once. */
+    quint64 framesRendered() const;
+    /*! Returns the number of frames that were replaced by a newer
+     * one, or by a format change, before they could be painted. */
+    quint64 framesDropped() const;
+    /*! Returns the number of paints, including repaints of the same frame. */
+    quint64 paints() const;
+
+    /*! Returns the average time spent uploading or converting a frame,
+     * if the sink has to do either of these before painting it. */
+    ClockTime averageUploadTime() const;
+    ClockTime maxUploadTime() const;
+
+    /*! Returns the average time a paint took, including the upload. */
+    ClockTime averagePaintTime() const;
+    ClockTime maxPaintTime() const;
+
+    /*! Returns the average time between a frame reaching
+     * the sink and it being painted for the first time. */
+    ClockTime averageLatency() const;
+    ClockTime maxLatency() const;
+
+    /*! Returns the number of rendered frames per latency bucket.
+     * Bucket \a i counts the latencies below latencyHistogramLimits()[i]
+     * that do not fall in a previous bucket. */
+    QList<quint64> latencyHistogram() const;
+    /*! Returns the upper limits of the buckets of latencyHistogram().
+     * The last limit is always ClockTime::None. */
+    QList<ClockTime> latencyHistogramLimits() const;
+
+    /*! Returns the statistics as they were read from the sink. */
+    Structure structure() const;
+
+private:
+    quint64 uint64Field(const char *fieldName) const;
+    QList<quint64> uint64ArrayField(const char *fieldName) const;
+
+    Structure m_structure;
+};
+
+} //namespace QGst
+
+#endif // QGST_VIDEOSINKSTATS_H
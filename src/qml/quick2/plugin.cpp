@@ -17,6 +17,7 @@
 */
 
 #include "../../QGst/Quick/videoitem.h"
+#include "../../QGst/Quick/videomosaicitem.h"
 #include "../../QGst/Quick/videosurface.h"
 #include <QtQml/QQmlExtensionPlugin>
 
@@ -33,6 +34,7 @@ void QtGStreamerPlugin::registerTypes(const char *uri)
 {
     // @uri org.freedesktop.gstreamer.QtGStreamerQuick2-1.0
     qmlRegisterType<QGst::Quick::VideoItem>(uri, 1, 0, "VideoItem");
+    qmlRegisterType<QGst::Quick::VideoMosaicItem>(uri, 1, 0, "VideoMosaicItem");
     qmlRegisterUncreatableType<QGst::Quick::VideoSurface>(uri, 1, 0, "VideoSurface",
         QLatin1String("Creating a QGst::Quick::VideoSurface from QML is not supported"));
 }
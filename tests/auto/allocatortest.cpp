@@ -19,6 +19,12 @@
 #include <QGlib/Error>
 #include <QGst/Allocator>
 #include <QGst/QGstMemory>
+#include <QGst/AllocatorImpl>
+#include <QGst/Buffer>
+#if defined(Q_OS_LINUX)
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
 
 class AllocatorTest : public QGstTest
 {
@@ -27,6 +33,25 @@ private Q_SLOTS:
 
     void testAllocationParams();
     void testAllocator();
+    void testAllocatorImpl();
+    void testArenaAllocator();
+    void testHugePageAllocator();
+    void testMemfdAllocator();
+};
+
+//counts the blocks that it hands out, which come from the heap
+class CountingAllocator : public QGst::AllocatorImpl
+{
+public:
+    CountingAllocator(int *blocks) : QGst::AllocatorImpl("QGstTestMemory"), m_blocks(blocks) {}
+    virtual ~CountingAllocator() { *m_blocks = -1; }
+
+protected:
+    virtual void *allocBlock(size_t size) { ++*m_blocks; return g_malloc(size); }
+    virtual void freeBlock(void *block, size_t) { --*m_blocks; g_free(block); }
+
+private:
+    int *m_blocks;
 };
 
 void AllocatorTest::testAllocationParams()
@@ -79,6 +104,138 @@ void AllocatorTest::testAllocator()
     system->free(mem);
 }
 
+void AllocatorTest::testAllocatorImpl()
+{
+    int blocks = 0;
+    CountingAllocator *impl = new CountingAllocator(&blocks);
+    QVERIFY(!impl->allocator());
+
+    QGst::AllocatorPtr allocator = QGst::AllocatorImpl::create(impl);
+    QVERIFY(allocator);
+    QCOMPARE(QGst::AllocatorImpl::fromAllocator(allocator), static_cast<QGst::AllocatorImpl*>(impl));
+    QCOMPARE(static_cast<GstAllocator*>(impl->allocator()), static_cast<GstAllocator*>(allocator));
+    QVERIFY(!QGst::AllocatorImpl::fromAllocator(QGst::Allocator::getSystemMemory()));
+
+    QGst::AllocationParams params;
+    params.setAlign(63);
+    params.setPrefix(8);
+    params.setPadding(8);
+    params.setFlags(QGst::MemoryFlagZeroPrefixed | QGst::MemoryFlagZeroPadded);
+
+    QGst::MemoryPtr memory = allocator->alloc(100, params);
+    QVERIFY(memory);
+    QCOMPARE(blocks, 1);
+    QVERIFY(memory->isType("QGstTestMemory"));
+    QCOMPARE(memory->size(), static_cast<size_t>(100));
+    QCOMPARE(memory->offset(), static_cast<size_t>(8));
+
+    QGst::MapInfo info;
+    QVERIFY(memory->map(info, QGst::MapWrite));
+    QCOMPARE(info.size(), static_cast<size_t>(100));
+    QCOMPARE(reinterpret_cast<quintptr>(info.data() - 8) & 63, quintptr(0));
+    QCOMPARE(info.data()[-1], quint8(0));
+    QCOMPARE(info.data()[100], quint8(0));
+    for (int i = 0; i < 100; ++i) {
+        info.data()[i] = i;
+    }
+    memory->unmap(info);
+
+    //buffers share the memory instead of copying it
+    QGst::BufferPtr buffer = QGst::Buffer::create(100, allocator, params);
+    QCOMPARE(blocks, 2);
+    QVERIFY(buffer->getMemory(0)->isType("QGstTestMemory"));
+    buffer->map(info, QGst::MapWrite);
+    memset(info.data(), 'x', info.size());
+    buffer->unmap(info);
+
+    GstBuffer *sub = gst_buffer_copy_region(buffer, GST_BUFFER_COPY_MEMORY, 10, 50);
+    QCOMPARE(blocks, 2);
+    quint8 byte = 0;
+    QCOMPARE(gst_buffer_extract(sub, 0, &byte, 1), static_cast<gsize>(1));
+    QCOMPARE(byte, quint8('x'));
+    buffer.clear();
+    QCOMPARE(blocks, 2);
+    gst_buffer_unref(sub);
+    QCOMPARE(blocks, 1);
+
+    memory.clear();
+    QCOMPARE(blocks, 0);
+
+    //the implementation lives as long as the allocator
+    allocator.clear();
+    QCOMPARE(blocks, -1);
+}
+
+void AllocatorTest::testArenaAllocator()
+{
+    QGst::ArenaAllocator *arena = new QGst::ArenaAllocator(4096, 4);
+    QGst::AllocatorPtr allocator = QGst::AllocatorImpl::create(arena);
+    QCOMPARE(arena->blockCount(), 0u);
+
+    QList<QGst::MemoryPtr> memories;
+    for (int i = 0; i < 5; ++i) {
+        memories.append(allocator->alloc(1024));
+        QVERIFY(memories.last());
+    }
+    QCOMPARE(arena->blockCount(), 8u);
+
+    //freed blocks are reused instead of allocating new slabs
+    memories.clear();
+    for (int i = 0; i < 8; ++i) {
+        memories.append(allocator->alloc(1024));
+    }
+    QCOMPARE(arena->blockCount(), 8u);
+
+    //requests that do not fit in a block come from the heap
+    QGst::MemoryPtr large = allocator->alloc(8192);
+    QVERIFY(large);
+    QCOMPARE(large->size(), static_cast<size_t>(8192));
+    QCOMPARE(arena->blockCount(), 8u);
+}
+
+void AllocatorTest::testHugePageAllocator()
+{
+    QGst::AllocatorPtr allocator = QGst::AllocatorImpl::create(new QGst::HugePageAllocator);
+    QGst::MemoryPtr memory = allocator->alloc(1920 * 1080 * 4);
+    QVERIFY(memory);
+    QVERIFY(memory->isType("QGstHugePageMemory"));
+
+    QGst::MapInfo info;
+    QVERIFY(memory->map(info, QGst::MapWrite));
+    memset(info.data(), 0xff, info.size());
+    memory->unmap(info);
+}
+
+void AllocatorTest::testMemfdAllocator()
+{
+#if defined(Q_OS_LINUX) && defined(__NR_memfd_create)
+    QGst::AllocatorPtr allocator = QGst::AllocatorImpl::create(new QGst::MemfdAllocator);
+    QGst::MemoryPtr memory = allocator->alloc(4096);
+    if (!memory) {
+        QSKIP_PORT("memfd_create() is not supported by the running kernel", SkipAll);
+    }
+
+    QGst::MapInfo info;
+    QVERIFY(memory->map(info, QGst::MapWrite));
+    memset(info.data(), 'q', info.size());
+    memory->unmap(info);
+
+    size_t offset = 0;
+    int fd = QGst::MemfdAllocator::fileDescriptor(memory, &offset);
+    QVERIFY(fd >= 0);
+
+    //the data is visible through the file descriptor
+    char byte = 0;
+    QCOMPARE(pread(fd, &byte, 1, offset), ssize_t(1));
+    QCOMPARE(byte, 'q');
+
+    QCOMPARE(QGst::MemfdAllocator::fileDescriptor(
+                 QGst::Allocator::getSystemMemory()->alloc(16)), -1);
+#else
+    QSKIP_PORT("memfd_create() is not available on this system", SkipAll);
+#endif
+}
+
 QTEST_APPLESS_MAIN(AllocatorTest)
 
 #include "moc_qgsttest.cpp"
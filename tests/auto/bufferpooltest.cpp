@@ -0,0 +1,144 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/BufferPool>
+#include <QGst/Buffer>
+#include <QGst/Caps>
+
+class BufferPoolTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void configTest();
+    void acquireTest();
+    void dontWaitTest();
+    void wrapperTest();
+};
+
+void BufferPoolTest::configTest()
+{
+    QGst::CapsPtr caps = QGst::Caps::fromString("video/x-raw, format=RGB, width=32, height=32");
+
+    QGst::AllocationParams params;
+    params.setAlign(63);
+
+    QGst::BufferPoolConfig config;
+    config.setParams(caps, 32 * 32 * 3, 2, 8);
+    config.setAllocator(QGst::Allocator::getSystemMemory(), params);
+    config.addOption("QGst.test-option");
+
+    QVERIFY(config.caps()->equals(caps));
+    QCOMPARE(config.size(), 32u * 32 * 3);
+    QCOMPARE(config.minBuffers(), 2u);
+    QCOMPARE(config.maxBuffers(), 8u);
+    QCOMPARE(static_cast<GstAllocator*>(config.allocator()),
+             static_cast<GstAllocator*>(QGst::Allocator::getSystemMemory()));
+    QCOMPARE(config.allocationParams().align(), static_cast<size_t>(63));
+    QVERIFY(config.hasOption("QGst.test-option"));
+    QCOMPARE(config.options(), QStringList() << "QGst.test-option");
+
+    //copies are independent
+    QGst::BufferPoolConfig copy(config);
+    copy.setParams(caps, 100, 0, 0);
+    QCOMPARE(config.size(), 32u * 32 * 3);
+    QCOMPARE(copy.size(), 100u);
+
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QVERIFY(pool->setConfig(config));
+    QGst::BufferPoolConfig applied = pool->config();
+    QCOMPARE(applied.size(), 32u * 32 * 3);
+    QCOMPARE(applied.minBuffers(), 2u);
+    QCOMPARE(applied.maxBuffers(), 8u);
+    QVERIFY(applied.caps()->equals(caps));
+}
+
+void BufferPoolTest::acquireTest()
+{
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QGst::BufferPoolConfig config = pool->config();
+    config.setParams(QGst::CapsPtr(), 1024, 1, 0);
+    QVERIFY(pool->setConfig(config));
+
+    QGst::BufferPtr buffer;
+    QCOMPARE(pool->acquireBuffer(buffer), QGst::FlowFlushing);
+    QVERIFY(!buffer);
+
+    QVERIFY(!pool->isActive());
+    QVERIFY(pool->setActive(true));
+    QVERIFY(pool->isActive());
+
+    //an active pool does not accept a new configuration
+    QVERIFY(!pool->setConfig(config));
+
+    QCOMPARE(pool->acquireBuffer(buffer), QGst::FlowOk);
+    QVERIFY(buffer);
+    QCOMPARE(buffer->size(), 1024u);
+
+    //buffers return to the pool and are handed out again
+    GstBuffer *first = buffer;
+    pool->releaseBuffer(buffer);
+    QVERIFY(!buffer);
+    QCOMPARE(pool->acquireBuffer(buffer), QGst::FlowOk);
+    QCOMPARE(static_cast<GstBuffer*>(buffer), first);
+
+    //dropping the last reference releases it as well
+    buffer.clear();
+    QCOMPARE(pool->acquireBuffer(buffer), QGst::FlowOk);
+    QCOMPARE(static_cast<GstBuffer*>(buffer), first);
+    buffer.clear();
+
+    QVERIFY(pool->setActive(false));
+    QVERIFY(!pool->isActive());
+}
+
+void BufferPoolTest::dontWaitTest()
+{
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QGst::BufferPoolConfig config = pool->config();
+    config.setParams(QGst::CapsPtr(), 16, 1, 1);
+    QVERIFY(pool->setConfig(config));
+    QVERIFY(pool->setActive(true));
+
+    QGst::BufferPtr first;
+    QCOMPARE(pool->acquireBuffer(first), QGst::FlowOk);
+
+    QGst::BufferPtr second;
+    QCOMPARE(pool->acquireBuffer(second, QGst::BufferPoolAcquireFlagDontWait), QGst::FlowEos);
+    QVERIFY(!second);
+
+    first.clear();
+    QCOMPARE(pool->acquireBuffer(second, QGst::BufferPoolAcquireFlagDontWait), QGst::FlowOk);
+    QVERIFY(second);
+    second.clear();
+
+    QVERIFY(pool->setActive(false));
+}
+
+void BufferPoolTest::wrapperTest()
+{
+    GstBufferPool *gpool = gst_buffer_pool_new();
+    QGst::BufferPoolPtr pool = QGst::BufferPoolPtr::wrap(gpool, false);
+    QVERIFY(QGlib::Type::fromInstance(gpool).isA(QGlib::GetType<QGst::BufferPool>()));
+    QCOMPARE(static_cast<GstBufferPool*>(pool), gpool);
+    QVERIFY(pool->options().isEmpty());
+    QVERIFY(!pool->hasOption("QGst.test-option"));
+}
+
+QTEST_APPLESS_MAIN(BufferPoolTest)
+
+#include "moc_qgsttest.cpp"
+#include "bufferpooltest.moc"
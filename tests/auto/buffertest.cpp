@@ -28,6 +28,11 @@ private Q_SLOTS:
     void flagsTest();
     void copyTest();
     void memoryPeekTest();
+    void wrapByteArrayTest();
+    void wrapMappedFileTest();
+    void wrapDataTest();
+    void mappedBufferTest();
+    void mappedMemoryTest();
 };
 
 void BufferTest::simpleTest()
@@ -88,6 +93,168 @@ void BufferTest::memoryPeekTest()
     QVERIFY(m->isWritable());
 
 }
+
+void BufferTest::wrapByteArrayTest()
+{
+    QByteArray data("0123456789");
+    QGst::BufferPtr buffer = QGst::Buffer::fromByteArray(data);
+    QCOMPARE(buffer->size(), static_cast<quint32>(data.size()));
+
+    //the memory is shared with the QByteArray, not copied
+    QGst::MapInfo info;
+    QVERIFY(buffer->map(info, QGst::MapRead));
+    QCOMPARE(static_cast<const void*>(info.data()), static_cast<const void*>(data.constData()));
+    buffer->unmap(info);
+
+    //the memory is read-only, since writing to it would modify the QByteArray
+    QGst::MemoryPtr memory = buffer->getMemory(0);
+    QVERIFY(GST_MEMORY_IS_READONLY(static_cast<GstMemory*>(memory)));
+    QVERIFY(!memory->map(info, QGst::MapWrite));
+
+    //the buffer keeps the data alive
+    data.clear();
+    char bytes[10];
+    QCOMPARE(buffer->extract(0, bytes, 10), 10u);
+    QCOMPARE(QByteArray(bytes, 10), QByteArray("0123456789"));
+}
+
+void BufferTest::wrapMappedFileTest()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write("0123456789");
+    file.flush();
+
+    QGst::BufferPtr buffer = QGst::Buffer::fromMappedFile(file.fileName(), 2, 5);
+    QVERIFY(buffer);
+    QCOMPARE(buffer->size(), 5u);
+
+    char bytes[5];
+    QCOMPARE(buffer->extract(0, bytes, 5), 5u);
+    QCOMPARE(QByteArray(bytes, 5), QByteArray("23456"));
+
+    buffer = QGst::Buffer::fromMappedFile(file.fileName());
+    QVERIFY(buffer);
+    QCOMPARE(buffer->size(), 10u);
+
+    QVERIFY(!QGst::Buffer::fromMappedFile(file.fileName() + QLatin1String(".does-not-exist")));
+}
+
+static void wrapDataTestNotify(void *userData)
+{
+    *static_cast<bool*>(userData) = true;
+}
+
+void BufferTest::wrapDataTest()
+{
+    char data[10] = "012345678";
+    bool destroyed = false;
+
+    {
+        QGst::BufferPtr buffer = QGst::Buffer::fromData(data, 10, &wrapDataTestNotify, &destroyed);
+        QCOMPARE(buffer->size(), 10u);
+        QVERIFY(buffer->getMemory(0)->isWritable());
+
+        QGst::MapInfo info;
+        QVERIFY(buffer->map(info, QGst::MapRead));
+        QCOMPARE(static_cast<const void*>(info.data()), static_cast<const void*>(data));
+        buffer->unmap(info);
+        QVERIFY(!destroyed);
+    }
+
+    QVERIFY(destroyed);
+}
+
+void BufferTest::mappedBufferTest()
+{
+    QByteArray data("0123456789");
+    QGst::BufferPtr buffer = QGst::Buffer::fromByteArray(data);
+
+    {
+        QGst::MappedBuffer mapped(buffer);
+        QVERIFY(mapped.isValid());
+        QVERIFY(mapped.flags().testFlag(QGst::MapRead));
+        QCOMPARE(mapped.size(), static_cast<size_t>(10));
+        QCOMPARE(static_cast<const void*>(mapped.constData()), static_cast<const void*>(data.constData()));
+
+        //the view refers to the mapped data instead of copying it
+        QByteArray view = mapped.byteArrayView();
+        QCOMPARE(view, data);
+        QCOMPARE(view.constData(), data.constData());
+    }
+
+    QVERIFY(!QGst::MappedBuffer(QGst::BufferPtr()).isValid());
+
+    buffer = QGst::Buffer::create(4);
+    {
+        QGst::MappedBuffer mapped(buffer, QGst::MapWrite);
+        QVERIFY(mapped.isValid());
+        memcpy(mapped.data(), "abcd", 4);
+    }
+    char bytes[4];
+    QCOMPARE(buffer->extract(0, bytes, 4), 4u);
+    QCOMPARE(QByteArray(bytes, 4), QByteArray("abcd"));
+
+    //the mapping keeps the buffer alive
+    GstBuffer *gstBuffer = buffer;
+    QGst::MappedBuffer mapped(buffer);
+    buffer.clear();
+    QCOMPARE(GST_MINI_OBJECT_REFCOUNT_VALUE(gstBuffer), 1);
+    QCOMPARE(mapped.byteArrayView(), QByteArray("abcd"));
+
+#ifndef BOOST_NO_RVALUE_REFERENCES
+    QGst::MappedBuffer moved(std::move(mapped));
+    QVERIFY(!mapped.isValid());
+    QVERIFY(moved.isValid());
+    QCOMPARE(moved.byteArrayView(), QByteArray("abcd"));
+#endif
+}
+
+void BufferTest::mappedMemoryTest()
+{
+    static const char first[] = "0123";
+    static const char second[] = "456789";
+
+    QGst::BufferPtr buffer = QGst::BufferPtr::wrap(gst_buffer_new(), false);
+    gst_buffer_append_memory(buffer, gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY,
+                             const_cast<char*>(first), 4, 0, 4, NULL, NULL));
+    gst_buffer_append_memory(buffer, gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY,
+                             const_cast<char*>(second), 6, 0, 6, NULL, NULL));
+    QCOMPARE(buffer->memoryCount(), 2u);
+
+    //the memories are mapped in place, without merging them
+    QByteArray payload;
+    for (uint i = 0; i < buffer->memoryCount(); ++i) {
+        QGst::MappedMemory mapped(buffer, i);
+        QVERIFY(mapped.isValid());
+        QCOMPARE(static_cast<const void*>(mapped.constData()),
+                 static_cast<const void*>(i == 0 ? first : second));
+        payload += mapped.byteArrayView();
+    }
+    QCOMPARE(payload, QByteArray("0123456789"));
+    QCOMPARE(buffer->memoryCount(), 2u);
+
+    QVERIFY(!QGst::MappedMemory(buffer, 2).isValid());
+
+    QGst::MappedMemory mapped(buffer->getMemory(1));
+    QVERIFY(mapped.isValid());
+    QCOMPARE(mapped.size(), static_cast<size_t>(6));
+
+#ifndef BOOST_NO_RVALUE_REFERENCES
+    QGst::MappedMemory moved(std::move(mapped));
+    QVERIFY(!mapped.isValid());
+    QCOMPARE(moved.byteArrayView(), QByteArray("456789"));
+#endif
+
+    //a buffer that is shared with someone else cannot be written to
+    QGst::BufferPtr shared = QGst::Buffer::create(10);
+    gst_buffer_ref(shared);
+    QVERIFY(!QGst::MappedMemory(shared, 0, QGst::MapWrite).isValid());
+    QVERIFY(QGst::MappedMemory(shared, 0, QGst::MapRead).isValid());
+    gst_buffer_unref(shared);
+    QVERIFY(QGst::MappedMemory(shared, 0, QGst::MapWrite).isValid());
+}
+
 QTEST_APPLESS_MAIN(BufferTest)
 
 #include "moc_qgsttest.cpp"
@@ -0,0 +1,251 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/ElementImpl>
+#include <QGst/ElementFactory>
+#include <QGst/Pipeline>
+#include <QGst/Bus>
+#include <QGst/Message>
+#include <QGst/Buffer>
+#include <QGst/Event>
+#include <QGst/Caps>
+#include <QGst/QGstMemory>
+
+static const int BufferCount = 10;
+static const uint BufferSize = 16;
+
+class CountingSource : public QGst::SourceImpl
+{
+protected:
+    virtual bool start()
+    {
+        m_count = 0;
+        setFormat(QGst::FormatBytes);
+        return true;
+    }
+
+    virtual QGst::FlowReturn create(quint64, uint, QGst::BufferPtr & buffer)
+    {
+        if (m_count == BufferCount) {
+            return QGst::FlowEos;
+        }
+
+        buffer = QGst::Buffer::create(BufferSize);
+        QGst::MapInfo info;
+        if (!buffer->map(info, QGst::MapWrite)) {
+            return QGst::FlowError;
+        }
+        memset(info.data(), m_count++, info.size());
+        buffer->unmap(info);
+        return QGst::FlowOk;
+    }
+
+private:
+    int m_count;
+};
+
+class InvertFilter : public QGst::FilterImpl
+{
+protected:
+    virtual QGst::FlowReturn filter(const QGst::BufferPtr & buffer)
+    {
+        //the buffer is writable, so mapping it for writing must succeed
+        QGst::MapInfo info;
+        if (!buffer->map(info, QGst::MapWrite)) {
+            return QGst::FlowError;
+        }
+        for (size_t i = 0; i < info.size(); ++i) {
+            info.data()[i] = ~info.data()[i];
+        }
+        buffer->unmap(info);
+        return QGst::FlowOk;
+    }
+};
+
+class CopyTransform : public QGst::TransformImpl
+{
+protected:
+    virtual QGst::FlowReturn transform(const QGst::BufferPtr & inbuf, const QGst::BufferPtr & outbuf)
+    {
+        QGst::MapInfo info;
+        if (!outbuf->map(info, QGst::MapWrite)) {
+            return QGst::FlowError;
+        }
+        inbuf->extract(0, info.data(), info.size());
+        outbuf->unmap(info);
+        return QGst::FlowOk;
+    }
+};
+
+class CountingElement : public QGst::ElementImpl
+{
+public:
+    CountingElement() : buffers(0), eos(false) {}
+
+    int buffers;
+    bool eos;
+
+protected:
+    virtual QGst::FlowReturn chain(const QGst::PadPtr & pad, QGst::BufferPtr & buffer)
+    {
+        ++buffers;
+        return QGst::ElementImpl::chain(pad, buffer);
+    }
+
+    virtual bool event(const QGst::PadPtr & pad, QGst::EventPtr & event)
+    {
+        if (event->type() == QGst::EventEos) {
+            eos = true;
+        }
+        return QGst::ElementImpl::event(pad, event);
+    }
+};
+
+class CollectingSink : public QGst::SinkImpl
+{
+public:
+    QList<quint8> firstBytes;
+
+protected:
+    virtual bool start()
+    {
+        setSync(false);
+        return true;
+    }
+
+    virtual QGst::FlowReturn render(const QGst::BufferPtr & buffer)
+    {
+        quint8 byte = 0;
+        if (buffer->extract(0, &byte, 1) != 1) {
+            return QGst::FlowError;
+        }
+        firstBytes.append(byte);
+        return QGst::FlowOk;
+    }
+};
+
+class ElementImplTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void registerTest();
+    void pipelineTest_data();
+    void pipelineTest();
+};
+
+template <class T>
+static void registerTestElement(const char *name, const char *klass)
+{
+    QGst::CapsPtr caps = QGst::Caps::createSimple("application/x-qgst-test");
+
+    QGst::ElementMetadata metadata(name, klass, "ElementImplTest element", "QtGStreamer");
+    if (!QByteArray(klass).contains("Source")) {
+        metadata.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, caps);
+    }
+    if (!QByteArray(klass).contains("Sink")) {
+        metadata.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways, caps);
+    }
+    QVERIFY(QGst::registerElement<T>(name, QGst::RankNone, metadata));
+}
+
+void ElementImplTest::initTestCase()
+{
+    QGstTest::initTestCase();
+    registerTestElement<CountingSource>("qgsttestsrc", "Source");
+    registerTestElement<InvertFilter>("qgsttestinvert", "Filter");
+    registerTestElement<CopyTransform>("qgsttestcopy", "Filter");
+    registerTestElement<CountingElement>("qgsttestcount", "Generic");
+    registerTestElement<CollectingSink>("qgsttestsink", "Sink");
+}
+
+void ElementImplTest::registerTest()
+{
+    QGst::ElementFactoryPtr factory = QGst::ElementFactory::find("qgsttestinvert");
+    QVERIFY(factory);
+    QCOMPARE(factory->metadata(GST_ELEMENT_METADATA_KLASS), QString("Filter"));
+
+    //registering again returns the existing type
+    QGst::ElementMetadata metadata("qgsttestinvert", "Filter", "", "");
+    QGlib::Type type = QGst::registerElementType<InvertFilter>("QGstElementImpl-qgsttestinvert",
+                                                                 metadata);
+    QCOMPARE(type, QGlib::Type::fromName("QGstElementImpl-qgsttestinvert"));
+
+    QGst::ElementPtr element = QGst::ElementFactory::make("qgsttestinvert");
+    QVERIFY(element);
+    QVERIFY(QGlib::Type::fromInstance(element).isA(type));
+    QVERIFY(dynamic_cast<InvertFilter*>(QGst::AbstractElementImpl::fromElement(element)));
+    QCOMPARE(static_cast<GstElement*>(QGst::AbstractElementImpl::fromElement(element)->element()),
+             static_cast<GstElement*>(element));
+
+    QGst::ElementPtr count = QGst::ElementFactory::make("qgsttestcount");
+    QVERIFY(count->getStaticPad("sink"));
+    QVERIFY(count->getStaticPad("src"));
+
+    QVERIFY(!QGst::AbstractElementImpl::fromElement(QGst::ElementFactory::make("identity")));
+}
+
+void ElementImplTest::pipelineTest_data()
+{
+    QTest::addColumn<QString>("processing");
+    QTest::addColumn<bool>("inverted");
+
+    QTest::newRow("filter") << "qgsttestinvert" << true;
+    QTest::newRow("transform") << "qgsttestcopy" << false;
+    QTest::newRow("element") << "qgsttestcount" << false;
+}
+
+void ElementImplTest::pipelineTest()
+{
+    QFETCH(QString, processing);
+    QFETCH(bool, inverted);
+
+    QGst::PipelinePtr pipeline = QGst::Pipeline::create();
+    QGst::ElementPtr src = QGst::ElementFactory::make("qgsttestsrc");
+    QGst::ElementPtr middle = QGst::ElementFactory::make(processing);
+    QGst::ElementPtr sink = QGst::ElementFactory::make("qgsttestsink");
+    QVERIFY(src && middle && sink);
+
+    pipeline->add(src, middle, sink);
+    QVERIFY(src->link(middle));
+    QVERIFY(middle->link(sink));
+
+    QCOMPARE(pipeline->setState(QGst::StatePlaying), QGst::StateChangeAsync);
+    QGst::MessagePtr msg = pipeline->bus()->pop(QGst::MessageEos, QGst::ClockTime::fromSeconds(10));
+    QVERIFY(msg);
+    pipeline->setState(QGst::StateNull);
+
+    CollectingSink *collectingSink =
+        dynamic_cast<CollectingSink*>(QGst::AbstractElementImpl::fromElement(sink));
+    QVERIFY(collectingSink);
+    QCOMPARE(collectingSink->firstBytes.size(), BufferCount);
+    for (int i = 0; i < BufferCount; ++i) {
+        QCOMPARE(collectingSink->firstBytes[i], quint8(inverted ? ~i : i));
+    }
+
+    CountingElement *counting =
+        dynamic_cast<CountingElement*>(QGst::AbstractElementImpl::fromElement(middle));
+    if (counting) {
+        QCOMPARE(counting->buffers, BufferCount);
+        QVERIFY(counting->eos);
+    }
+}
+
+QTEST_APPLESS_MAIN(ElementImplTest)
+
+#include "moc_qgsttest.cpp"
+#include "elementimpltest.moc"
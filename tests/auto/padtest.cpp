@@ -21,12 +21,27 @@
 #include <QGst/Pad>
 #include <QGst/Caps>
 #include <QGst/Event>
+#include <QGst/Buffer>
 
 class PadTest : public QGstTest
 {
     Q_OBJECT
+private:
+    QGst::PadProbeReturn countBuffer(const QGst::BufferPtr & buffer);
+    QGst::PadProbeReturn dropBuffer(const QGst::BufferPtr & buffer);
+    QGst::PadProbeReturn countEvent(const QGst::EventPtr & event);
+    QGst::PadProbeReturn idleProbe(const QGst::PadPtr & pad, const QGst::PadProbeInfo & info);
+
 private Q_SLOTS:
     void capsTest();
+    void bufferProbeTest();
+    void eventProbeTest();
+    void idleProbeTest();
+
+private:
+    int m_probedBuffers;
+    QList<QGst::EventType> m_probedEvents;
+    QGst::PadPtr m_probedPad;
 };
 
 void PadTest::capsTest()
@@ -47,6 +62,129 @@ void PadTest::capsTest()
     QVERIFY(caps->equals(caps2));
     queue->setState(QGst::StateNull);
 }
+QGst::PadProbeReturn PadTest::countBuffer(const QGst::BufferPtr & buffer)
+{
+    if (!buffer.isNull()) {
+        ++m_probedBuffers;
+    }
+    return QGst::PadProbeOk;
+}
+
+QGst::PadProbeReturn PadTest::dropBuffer(const QGst::BufferPtr &)
+{
+    return QGst::PadProbeDrop;
+}
+
+QGst::PadProbeReturn PadTest::countEvent(const QGst::EventPtr & event)
+{
+    m_probedEvents.append(event->type());
+    return QGst::PadProbeOk;
+}
+
+QGst::PadProbeReturn PadTest::idleProbe(const QGst::PadPtr & pad, const QGst::PadProbeInfo & info)
+{
+    if (info.type() & QGst::PadProbeTypeIdle) {
+        m_probedPad = pad;
+    }
+    return QGst::PadProbeRemove;
+}
+
+static int s_chainedBuffers = 0;
+
+static GstFlowReturn countingChain(GstPad *, GstObject *, GstBuffer *buffer)
+{
+    ++s_chainedBuffers;
+    gst_buffer_unref(buffer);
+    return GST_FLOW_OK;
+}
+
+static QGst::PadPtr createLinkedSrcPad()
+{
+    QGst::PadPtr src = QGst::Pad::create(QGst::PadSrc, "src");
+    QGst::PadPtr sink = QGst::Pad::create(QGst::PadSink, "sink");
+    gst_pad_set_chain_function(sink, countingChain);
+    sink->setActive(true);
+    src->setActive(true);
+    src->link(sink);
+    return src;
+}
+
+static void startStream(const QGst::PadPtr & src)
+{
+    gst_pad_push_event(src, gst_event_new_stream_start("padtest"));
+    gst_pad_push_event(src, gst_event_new_caps(gst_caps_new_empty_simple("application/x-test")));
+
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_BYTES);
+    gst_pad_push_event(src, gst_event_new_segment(&segment));
+}
+
+void PadTest::bufferProbeTest()
+{
+    QGst::PadPtr src = createLinkedSrcPad();
+    QVERIFY(src->isLinked());
+    startStream(src);
+
+    m_probedBuffers = 0;
+    s_chainedBuffers = 0;
+    ulong id = src->addProbe(QGst::PadProbeTypeBuffer, this, &PadTest::countBuffer);
+    QVERIFY(id != 0);
+
+    for (int i = 0; i < 5; ++i) {
+        QCOMPARE(gst_pad_push(src, gst_buffer_new()), GST_FLOW_OK);
+    }
+    QCOMPARE(m_probedBuffers, 5);
+    QCOMPARE(s_chainedBuffers, 5);
+
+    //dropped buffers never reach the peer
+    ulong dropId = src->addProbe(QGst::PadProbeTypeBuffer, this, &PadTest::dropBuffer);
+    QVERIFY(dropId != 0);
+    QCOMPARE(gst_pad_push(src, gst_buffer_new()), GST_FLOW_OK);
+    QCOMPARE(s_chainedBuffers, 5);
+    src->removeProbe(dropId);
+
+    src->removeProbe(id);
+    QCOMPARE(gst_pad_push(src, gst_buffer_new()), GST_FLOW_OK);
+    QCOMPARE(m_probedBuffers, 6);
+    QCOMPARE(s_chainedBuffers, 6);
+}
+
+void PadTest::eventProbeTest()
+{
+    QGst::PadPtr src = createLinkedSrcPad();
+
+    //events are let through if the mask also includes buffers
+    m_probedBuffers = 0;
+    m_probedEvents.clear();
+    ulong id = src->addProbe(QGst::PadProbeTypeEventDownstream | QGst::PadProbeTypeBuffer,
+                             this, &PadTest::countEvent);
+    QVERIFY(id != 0);
+
+    startStream(src);
+    QCOMPARE(gst_pad_push(src, gst_buffer_new()), GST_FLOW_OK);
+    gst_pad_push_event(src, gst_event_new_eos());
+
+    QCOMPARE(m_probedEvents.size(), 4);
+    QCOMPARE(m_probedEvents[0], QGst::EventStreamStart);
+    QCOMPARE(m_probedEvents[1], QGst::EventCaps);
+    QCOMPARE(m_probedEvents[2], QGst::EventSegment);
+    QCOMPARE(m_probedEvents[3], QGst::EventEos);
+    src->removeProbe(id);
+}
+
+void PadTest::idleProbeTest()
+{
+    QGst::PadPtr src = createLinkedSrcPad();
+
+    //idle probes are called right away on a pad without data flow,
+    //and the id is 0 because the callback removes the probe
+    m_probedPad.clear();
+    ulong id = src->addProbe(QGst::PadProbeTypeIdle, this, &PadTest::idleProbe);
+    QCOMPARE(id, 0ul);
+    QCOMPARE(static_cast<GstPad*>(m_probedPad), static_cast<GstPad*>(src));
+    m_probedPad.clear();
+}
+
 QTEST_APPLESS_MAIN(PadTest)
 
 #include "moc_qgsttest.cpp"
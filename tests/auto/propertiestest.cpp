@@ -25,6 +25,7 @@ private Q_SLOTS:
     void findPropertyTest();
     void listPropertiesTest();
     void getPropertyTest();
+    void propertyHandleTest();
 };
 
 void PropertiesTest::findPropertyTest()
@@ -63,6 +64,43 @@ void PropertiesTest::getPropertyTest()
     }
 }
 
+void PropertiesTest::propertyHandleTest()
+{
+    QGst::BinPtr object = QGst::Bin::create();
+
+    QGlib::PropertyHandle invalid(QGlib::GetType<QGst::Bin>(), "does-not-exist");
+    QVERIFY(!invalid.isValid());
+    QVERIFY(!object->property(invalid).isValid());
+
+    QGlib::PropertyHandle name(QGlib::GetType<QGst::Object>(), "name");
+    QVERIFY(name.isValid());
+    QCOMPARE(name.paramSpec()->name(), QString("name"));
+    QCOMPARE(name.valueType(), QGlib::Type(QGlib::Type::String));
+
+    object->setProperty(name, QString("foo"));
+    QCOMPARE(object->property(name).get<QString>(), QString("foo"));
+
+    QGlib::PropertyHandle asyncHandling(QGlib::GetType<QGst::Bin>(), "async-handling");
+    QList<QGlib::PropertyHandle> handles;
+    handles << name << asyncHandling;
+
+    QList<QGlib::Value> values;
+    values << QGlib::Value::create(QString("bar")) << QGlib::Value::create(true);
+    object->setProperties(handles, values);
+
+    values = object->properties(handles);
+    QCOMPARE(values.size(), 2);
+    QCOMPARE(values[0].get<QString>(), QString("bar"));
+    QCOMPARE(values[1].get<bool>(), true);
+
+    //invalid values are skipped, the other properties are still set
+    values.clear();
+    values << QGlib::Value::create(QString("baz")) << QGlib::Value();
+    object->setProperties(handles, values);
+    QCOMPARE(object->property(name).get<QString>(), QString("baz"));
+    QCOMPARE(object->property(asyncHandling).get<bool>(), true);
+}
+
 QTEST_APPLESS_MAIN(PropertiesTest)
 
 #include "moc_qgsttest.cpp"
@@ -21,6 +21,7 @@
 #include <QQmlApplicationEngine>
 #include <QQmlParserStatus>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QGlib/Connect>
 #include <QGst/Pipeline>
 #include <QGst/Bus>
@@ -28,6 +29,7 @@
 #include <QGst/ElementFactory>
 #include <QGst/Message>
 #include <QGst/Quick/VideoSurface>
+#include <QGst/Quick/VideoMosaicItem>
 
 
 class QtQuick2Test : public QObject
@@ -50,6 +52,7 @@ private:
 
 private Q_SLOTS:
     void testLaunch();
+    void testMosaic();
 };
 
 void QtQuick2Test::testLaunch()
@@ -82,6 +85,67 @@ void QtQuick2Test::testLaunch()
     delete engine;
 }
 
+void QtQuick2Test::testMosaic()
+{
+    QGst::init();
+
+    QQmlApplicationEngine* engine = new QQmlApplicationEngine(this);
+    QGst::Quick::VideoSurface *surface1 = new QGst::Quick::VideoSurface(this);
+    QGst::Quick::VideoSurface *surface2 = new QGst::Quick::VideoSurface(this);
+
+    auto pipeline = QGst::Pipeline::create();
+    auto bus = pipeline->bus();
+    bus->addSignalWatch();
+    QGlib::connect(bus, "message", this, &QtQuick2Test::onBusMessage);
+
+    Q_FOREACH(QGst::Quick::VideoSurface *surface, QList<QGst::Quick::VideoSurface*>() << surface1 << surface2) {
+        auto source = QGst::ElementFactory::make("videotestsrc", "");
+        pipeline->add(source, surface->videoSink());
+        source->link(surface->videoSink());
+    }
+
+    pipeline->setState(QGst::StatePlaying);
+
+    engine->rootContext()->setContextProperty("surface1", surface1);
+    engine->rootContext()->setContextProperty("surface2", surface2);
+    engine->load(QUrl("videomosaictest.qml"));
+
+    QGst::Quick::VideoMosaicItem *mosaic =
+        engine->rootObjects().first()->findChild<QGst::Quick::VideoMosaicItem*>("mosaic");
+    QVERIFY(mosaic);
+    QCOMPARE(mosaic->surfaces().size(), 2);
+    QCOMPARE(mosaic->surfaces().at(0), surface1);
+    QCOMPARE(mosaic->surfaces().at(1), surface2);
+    QCOMPARE(mosaic->columns(), 2);
+
+    QSignalSpy spy(engine->rootObjects().first(), SIGNAL(frameSwapped()));
+    spy.wait(100);
+
+    // every surface is painted on its own tile
+    QQuickWindow *window = qobject_cast<QQuickWindow*>(engine->rootObjects().first());
+    QVERIFY(window);
+    const QPoint tileCenters[] = { QPoint(50, 50), QPoint(150, 50) };
+    for (uint i = 0; i < sizeof(tileCenters) / sizeof(tileCenters[0]); ++i) {
+        QTRY_VERIFY(window->grabWindow().pixel(tileCenters[i]) != qRgb(0, 0, 0));
+    }
+
+    // the tile of a destroyed surface turns black, the others keep playing
+    delete surface2;
+    QCOMPARE(mosaic->surfaces().size(), 2);
+    QVERIFY(!mosaic->surfaces().at(1));
+    QTRY_COMPARE(window->grabWindow().pixel(tileCenters[1]), qRgb(0, 0, 0));
+    QVERIFY(window->grabWindow().pixel(tileCenters[0]) != qRgb(0, 0, 0));
+
+    // removing the surfaces while playing must not leave dangling tiles
+    mosaic->clearSurfaces();
+    QVERIFY(mosaic->surfaces().isEmpty());
+    spy.wait(100);
+
+    pipeline->setState(QGst::StateNull);
+
+    delete engine;
+}
+
 QTEST_MAIN(QtQuick2Test)
 
 #include "qtquick2test.moc"
@@ -17,6 +17,8 @@
 */
 #include "qgsttest.h"
 #include <QGst/Query>
+#include <QGst/BufferPool>
+#include <QGst/Caps>
 
 class QueryTest : public QGstTest
 {
@@ -32,6 +34,7 @@ private Q_SLOTS:
     void formatsTest();
     void bufferingTest();
     void uriTest();
+    void allocationTest();
 };
 
 void QueryTest::baseTest()
@@ -179,6 +182,58 @@ void QueryTest::uriTest()
     QCOMPARE(query->uri(), QUrl::fromLocalFile("/bin/sh"));
 }
 
+void QueryTest::allocationTest()
+{
+    QGst::CapsPtr caps = QGst::Caps::createSimple("video/x-raw");
+    QGst::AllocationQueryPtr query = QGst::AllocationQuery::create(caps, true);
+    QVERIFY(query->type()==QGst::QueryAllocation);
+    QCOMPARE(query->typeName(), QString("allocation"));
+    QVERIFY(query->caps()->equals(caps));
+    QVERIFY(query->needPool());
+
+    //wrapping a native allocation query gives the right subclass
+    QGst::QueryPtr base = QGst::QueryPtr::wrap(static_cast<GstQuery*>(query));
+    QVERIFY(base.dynamicCast<QGst::AllocationQuery>());
+
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QCOMPARE(query->poolCount(), 0u);
+    query->addPool(pool, 1024, 2, 4);
+    QCOMPARE(query->poolCount(), 1u);
+    QCOMPARE(static_cast<GstBufferPool*>(query->pool(0)), static_cast<GstBufferPool*>(pool));
+    QCOMPARE(query->poolSize(0), 1024u);
+    QCOMPARE(query->poolMinBuffers(0), 2u);
+    QCOMPARE(query->poolMaxBuffers(0), 4u);
+
+    query->setPool(0, QGst::BufferPoolPtr(), 2048, 0, 0);
+    QVERIFY(!query->pool(0));
+    QCOMPARE(query->poolSize(0), 2048u);
+    query->removePool(0);
+    QCOMPARE(query->poolCount(), 0u);
+
+    QGst::AllocationParams params;
+    params.setAlign(15);
+    query->addAllocator(QGst::Allocator::getSystemMemory(), params);
+    QCOMPARE(query->allocatorCount(), 1u);
+    QCOMPARE(static_cast<GstAllocator*>(query->allocator(0)),
+             static_cast<GstAllocator*>(QGst::Allocator::getSystemMemory()));
+    QCOMPARE(query->allocationParams(0).align(), static_cast<size_t>(15));
+    query->removeAllocator(0);
+    QCOMPARE(query->allocatorCount(), 0u);
+
+    static const gchar *tags[] = { NULL };
+    QGlib::Type api = gst_meta_api_type_register("QGstTestMetaAPI", tags);
+
+    QCOMPARE(query->metaCount(), 0u);
+    query->addMeta(api);
+    QCOMPARE(query->metaCount(), 1u);
+    QCOMPARE(query->meta(0), api);
+    uint index = 1;
+    QVERIFY(query->hasMeta(api, &index));
+    QCOMPARE(index, 0u);
+    query->removeMeta(0);
+    QVERIFY(!query->hasMeta(api));
+}
+
 QTEST_APPLESS_MAIN(QueryTest)
 
 #include "moc_qgsttest.cpp"
@@ -23,6 +23,7 @@
 #include <QGst/ElementFactory>
 #include <QGst/UriHandler>
 #include <QGst/StreamVolume>
+#include <QGlib/Quark>
 
 class RefPointerTest : public QGstTest
 {
@@ -38,6 +39,7 @@ private Q_SLOTS:
     void cppWrappersTest();
     void messageDynamicCastTest();
     void equalityTest();
+    void wrapperConstructorCacheTest();
 };
 
 void RefPointerTest::refTest1()
@@ -251,6 +253,44 @@ void RefPointerTest::equalityTest()
     QVERIFY(e == bin);
 }
 
+static QGst::ObjectPtr createTestObject(QGlib::Type type)
+{
+    return QGst::ObjectPtr::wrap(GST_OBJECT(gst_object_ref_sink(g_object_new(type, NULL))), false);
+}
+
+void RefPointerTest::wrapperConstructorCacheTest()
+{
+    //types without a wrapper constructor of their own use the one of their parent
+    QList<QGlib::Type> types;
+    for (int i = 0; i < 100; ++i) {
+        QByteArray name = "QGstRefPointerTestBin" + QByteArray::number(i);
+        types.append(g_type_register_static_simple(GST_TYPE_BIN, name.constData(),
+                                                   sizeof(GstBinClass), NULL,
+                                                   sizeof(GstBin), NULL, GTypeFlags(0)));
+    }
+    for (int round = 0; round < 2; ++round) {
+        Q_FOREACH(QGlib::Type type, types) {
+            QGst::ObjectPtr object = createTestObject(type);
+            QVERIFY(dynamic_cast<QGst::Bin*>(object.operator->()));
+            QVERIFY(!dynamic_cast<QGst::Pipeline*>(object.operator->()));
+        }
+    }
+
+    //the constructor that was found for a type is remembered...
+    QGlib::Quark q = QGlib::Quark::fromString("QGlib__wrapper_constructor");
+    types[0].setQuarkData(q, QGlib::GetType<QGst::Pipeline>().quarkData(q));
+    QGst::ObjectPtr object = createTestObject(types[0]);
+    QVERIFY(!dynamic_cast<QGst::Pipeline*>(object.operator->()));
+
+    //...until the cache is invalidated
+    QGlib::Private::invalidateWrapperConstructorCache();
+    object = createTestObject(types[0]);
+    QVERIFY(dynamic_cast<QGst::Pipeline*>(object.operator->()));
+    object = createTestObject(types[1]);
+    QVERIFY(dynamic_cast<QGst::Bin*>(object.operator->()));
+    QVERIFY(!dynamic_cast<QGst::Pipeline*>(object.operator->()));
+}
+
 QTEST_APPLESS_MAIN(RefPointerTest)
 
 #include "moc_qgsttest.cpp"
@@ -20,6 +20,7 @@
 #include <QGlib/Signal>
 #include <QGlib/Connect>
 #include <QGst/Pipeline>
+#include <QtCore/QThread>
 
 class SignalsTest : public QGstTest
 {
@@ -34,8 +35,11 @@ private Q_SLOTS:
    void queryTest();
    void emitTest();
    void emitTypeTest();
+   void signalHandleTest();
    void disconnectTest();
    void autoDisconnectTest();
+   void threadedConnectDisconnectTest();
+   void queuedConnectTest();
 };
 
 static bool closureCalled = false;
@@ -135,6 +139,43 @@ void SignalsTest::emitTypeTest()
     QCOMPARE(closureCalled, true);
 }
 
+void SignalsTest::signalHandleTest()
+{
+    QGlib::SignalHandle invalidHandle(QGlib::GetType<QGst::Bin>(), "foobar");
+    QVERIFY(!invalidHandle.isValid());
+
+    QGlib::SignalHandle handle(QGlib::GetType<QGst::Bin>(), "notify::name");
+    QVERIFY(handle.isValid());
+    QCOMPARE(handle.signal().name(), QString("notify"));
+    QVERIFY(handle.detail() == QGlib::Quark::fromString("name"));
+
+    QGst::BinPtr bin = QGst::Bin::create("mybin");
+    QGlib::connect(bin, "notify::name", this, &SignalsTest::emitTestClosure, QGlib::PassSender);
+
+    closureCalled = false;
+    QGlib::emit<void>(handle, bin, bin->findProperty("name"));
+    QCOMPARE(closureCalled, true);
+
+    //wrong number of arguments, should show error message and *not call* the signal
+    closureCalled = false;
+    QGlib::emit<void>(handle, bin);
+    QCOMPARE(closureCalled, false);
+
+    //wrong return value, should show error message but *call* the signal
+    closureCalled = false;
+    int r = QGlib::emit<int>(handle, bin, bin->findProperty("name"));
+    QCOMPARE(r, int());
+    QCOMPARE(closureCalled, true);
+
+    //the handle is also usable on instances of subclasses
+    QGst::PipelinePtr pipeline = QGst::Pipeline::create("mybin");
+    QGlib::connect(pipeline, "notify::name", this, &SignalsTest::emitTestClosure, QGlib::PassSender);
+
+    closureCalled = false;
+    QGlib::emit<void>(handle, pipeline, pipeline->findProperty("name"));
+    QCOMPARE(closureCalled, true);
+}
+
 void SignalsTest::disconnectTest()
 {
     QGst::BinPtr bin = QGst::Bin::create();
@@ -199,7 +240,149 @@ void SignalsTest::autoDisconnectTest()
     QVERIFY(!QGlib::disconnect(binPtr));
 }
 
-QTEST_APPLESS_MAIN(SignalsTest)
+class ConnectDisconnectThread : public QThread
+{
+public:
+    ConnectDisconnectThread(const QGst::BinPtr & sharedBin, QAtomicInt *failures)
+        : m_sharedBin(sharedBin), m_failures(failures) {}
+
+protected:
+    virtual void run();
+
+private:
+    void check(bool condition) { if (!condition) m_failures->ref(); }
+
+    QGst::BinPtr m_sharedBin;
+    QAtomicInt *m_failures;
+};
+
+void ConnectDisconnectThread::run()
+{
+    for (int i = 0; i < 500; ++i) {
+        QGst::BinPtr bin = QGst::Bin::create();
+        DisconnectTestClass *receiver = new DisconnectTestClass;
+
+        check(QGlib::connect(bin, "notify::name", receiver, &DisconnectTestClass::testClosure));
+        check(QGlib::connect(m_sharedBin, "notify::name", receiver, &DisconnectTestClass::testClosure));
+        bin->setProperty("name", QString::number(i));
+
+        check(QGlib::disconnect(bin, "notify::name", receiver, &DisconnectTestClass::testClosure));
+        check(!QGlib::disconnect(bin, "notify::name", receiver, &DisconnectTestClass::testClosure));
+
+        //leave the connection to the shared bin to the receiver auto-disconnection every other time
+        if (i % 2) {
+            check(QGlib::disconnect(m_sharedBin, "notify::name", receiver));
+        }
+        delete receiver;
+        check(!QGlib::disconnect(m_sharedBin, "notify::name", receiver));
+    }
+}
+
+void SignalsTest::threadedConnectDisconnectTest()
+{
+    QGst::BinPtr sharedBin = QGst::Bin::create();
+    QAtomicInt failures(0);
+
+    QList<ConnectDisconnectThread*> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.append(new ConnectDisconnectThread(sharedBin, &failures));
+    }
+    Q_FOREACH(ConnectDisconnectThread *thread, threads) {
+        thread->start();
+    }
+    Q_FOREACH(ConnectDisconnectThread *thread, threads) {
+        thread->wait();
+        delete thread;
+    }
+
+#if QT_VERSION >= 0x050000
+    QCOMPARE(failures.load(), 0);
+#else
+    QCOMPARE(static_cast<int>(failures), 0);
+#endif
+
+    //everything must have been disconnected
+    QVERIFY(!QGlib::disconnect(sharedBin));
+}
+
+class QueuedTestReceiver : public QObject
+{
+public:
+    QueuedTestReceiver() : calls(0), invocationThread(0) {}
+
+    void testClosure(const QGlib::ObjectPtr & sender, const QGlib::ParamSpecPtr & param)
+    {
+        Q_UNUSED(param);
+        ++calls;
+        invocationThread = QThread::currentThread();
+        lastSender = sender;
+    }
+
+    int calls;
+    QThread *invocationThread;
+    QGlib::ObjectPtr lastSender;
+};
+
+class RenameThread : public QThread
+{
+public:
+    RenameThread(const QGst::BinPtr & bin, int count) : m_bin(bin), m_count(count) {}
+
+protected:
+    virtual void run()
+    {
+        for (int i = 0; i < m_count; ++i) {
+            m_bin->setProperty("name", QString::fromLatin1("bin%1").arg(i));
+        }
+    }
+
+private:
+    QGst::BinPtr m_bin;
+    int m_count;
+};
+
+void SignalsTest::queuedConnectTest()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+
+    QueuedTestReceiver queued;
+    QueuedTestReceiver coalesced;
+    QVERIFY(QGlib::connect(bin, "notify::name", &queued, &QueuedTestReceiver::testClosure,
+                           QGlib::ConnectQueued | QGlib::PassSender));
+    QVERIFY(QGlib::connect(bin, "notify::name", &coalesced, &QueuedTestReceiver::testClosure,
+                           QGlib::ConnectCoalesced | QGlib::PassSender));
+
+    RenameThread thread(bin, 10);
+    thread.start();
+    thread.wait();
+
+    //nothing must have been invoked from the emitting thread
+    QCOMPARE(queued.calls, 0);
+    QCOMPARE(coalesced.calls, 0);
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(queued.calls, 10);
+    QCOMPARE(queued.invocationThread, QThread::currentThread());
+    QCOMPARE(queued.lastSender, QGlib::ObjectPtr(bin));
+
+    QCOMPARE(coalesced.calls, 1);
+    QCOMPARE(coalesced.invocationThread, QThread::currentThread());
+
+    //pending invocations must be dropped when disconnecting
+    RenameThread thread2(bin, 5);
+    thread2.start();
+    thread2.wait();
+
+    QVERIFY(QGlib::disconnect(bin, "notify::name", &queued, &QueuedTestReceiver::testClosure));
+    QVERIFY(QGlib::disconnect(bin, "notify::name", &coalesced, &QueuedTestReceiver::testClosure));
+    QCoreApplication::processEvents();
+
+    QCOMPARE(queued.calls, 10);
+    QCOMPARE(coalesced.calls, 1);
+}
+
+QTEST_MAIN(SignalsTest)
 
 #include "moc_qgsttest.cpp"
 #include "signalstest.moc"
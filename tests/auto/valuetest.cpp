@@ -43,6 +43,7 @@ private Q_SLOTS:
     void qdebugTest();
     void datetimeTest();
     void errorTest();
+    void manyTypesTest();
 };
 
 void ValueTest::intTest()
@@ -275,6 +276,33 @@ void ValueTest::errorTest()
     QCOMPARE(error.code(), 42);
 }
 
+void ValueTest::manyTypesTest()
+{
+    //more types than fit in the initial vtable cache, so that it has to grow
+    QList<QGlib::Type> types;
+    for (int i = 0; i < 200; ++i) {
+        QByteArray name = "QGstValueTestBin" + QByteArray::number(i);
+        types.append(g_type_register_static_simple(GST_TYPE_BIN, name.constData(),
+                                                   sizeof(GstBinClass), NULL,
+                                                   sizeof(GstBin), NULL, GTypeFlags(0)));
+    }
+
+    //the second round is served from the cache
+    for (int round = 0; round < 2; ++round) {
+        Q_FOREACH(QGlib::Type type, types) {
+            GstBin *gbin = GST_BIN(g_object_new(type, NULL));
+            gst_object_ref_sink(gbin);
+            QGst::BinPtr bin = QGst::BinPtr::wrap(gbin, false);
+
+            QGlib::Value v;
+            v.init(type);
+            v.set(bin);
+            QCOMPARE(v.type(), type);
+            QCOMPARE(static_cast<GstBin*>(v.get<QGst::BinPtr>()), gbin);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(ValueTest)
 
 #include "moc_qgsttest.cpp"
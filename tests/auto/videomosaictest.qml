@@ -0,0 +1,16 @@
+import QtQuick 2.1
+import QtQuick.Window 2.1
+import QtGStreamer 1.0
+
+Window {
+    width: 200
+    height: 100
+    visible: true
+
+    VideoMosaicItem {
+        objectName: "mosaic"
+        anchors.fill: parent
+        columns: 2
+        surfaces: [ surface1, surface2 ]
+    }
+}
@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/VideoSinkStats>
+#include <QGst/ElementFactory>
+
+class VideoSinkStatsTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void invalidTest();
+    void structureTest();
+};
+
+void VideoSinkStatsTest::invalidTest()
+{
+    QGst::VideoSinkStats stats;
+    QVERIFY(!stats.isValid());
+    QCOMPARE(stats.framesReceived(), Q_UINT64_C(0));
+    QVERIFY(stats.latencyHistogram().isEmpty());
+
+    // fakesink is no Qt video sink, even if it may have a "stats" property
+    QGst::ElementPtr fakesink = QGst::ElementFactory::make("fakesink");
+    QVERIFY(fakesink);
+    QVERIFY(!QGst::VideoSinkStats::fromSink(fakesink).isValid());
+    QVERIFY(!QGst::VideoSinkStats::fromSink(QGst::ElementPtr()).isValid());
+}
+
+void VideoSinkStatsTest::structureTest()
+{
+    QGst::Structure s = QGst::Structure::fromString(
+            "application/x-qt-video-sink-stats, "
+            "frames-received=(guint64)10, frames-rendered=(guint64)7, "
+            "frames-dropped=(guint64)3, paints=(guint64)9, "
+            "upload-time-average=(guint64)1000, upload-time-max=(guint64)2000, "
+            "paint-time-average=(guint64)3000, paint-time-max=(guint64)4000, "
+            "latency-average=(guint64)5000000, latency-max=(guint64)9000000, "
+            "latency-histogram=(guint64)< 0, 0, 0, 5, 2 >, "
+            "latency-histogram-limits=(guint64)< 1000000, 2000000, 4000000, "
+                "8000000, 18446744073709551615 >");
+    QVERIFY(s.isValid());
+
+    QGst::VideoSinkStats stats(s);
+    QVERIFY(stats.isValid());
+    QCOMPARE(stats.framesReceived(), Q_UINT64_C(10));
+    QCOMPARE(stats.framesRendered(), Q_UINT64_C(7));
+    QCOMPARE(stats.framesDropped(), Q_UINT64_C(3));
+    QCOMPARE(stats.paints(), Q_UINT64_C(9));
+    QCOMPARE(static_cast<quint64>(stats.averageUploadTime()), Q_UINT64_C(1000));
+    QCOMPARE(static_cast<quint64>(stats.maxUploadTime()), Q_UINT64_C(2000));
+    QCOMPARE(static_cast<quint64>(stats.averagePaintTime()), Q_UINT64_C(3000));
+    QCOMPARE(static_cast<quint64>(stats.maxPaintTime()), Q_UINT64_C(4000));
+    QCOMPARE(static_cast<quint64>(stats.averageLatency()), Q_UINT64_C(5000000));
+    QCOMPARE(static_cast<quint64>(stats.maxLatency()), Q_UINT64_C(9000000));
+
+    QList<quint64> histogram = stats.latencyHistogram();
+    QCOMPARE(histogram.size(), 5);
+    QCOMPARE(histogram.at(3), Q_UINT64_C(5));
+    QCOMPARE(histogram.at(4), Q_UINT64_C(2));
+
+    QList<QGst::ClockTime> limits = stats.latencyHistogramLimits();
+    QCOMPARE(limits.size(), 5);
+    QCOMPARE(static_cast<quint64>(limits.at(0)), Q_UINT64_C(1000000));
+    QVERIFY(!limits.last().isValid());
+}
+
+QTEST_APPLESS_MAIN(VideoSinkStatsTest)
+
+#include "moc_qgsttest.cpp"
+#include "videosinkstatstest.moc"
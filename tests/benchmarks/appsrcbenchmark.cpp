@@ -0,0 +1,123 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest/QtTest>
+#include <QGst/Init>
+#include <QGst/Buffer>
+#include <QGst/BufferPool>
+#include <QGst/Bus>
+#include <QGst/Message>
+#include <QGst/Parse>
+#include <QGst/Pipeline>
+#include <QGst/Utils/ApplicationSource>
+
+class AppSrcBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+    void pushBuffers_data();
+    void pushBuffers();
+};
+
+static const int BufferCount = 2000;
+
+enum PushMode { Copied, Wrapped, Pooled };
+static const char * const PushModeNames[] = { "copied", "wrapped", "pooled" };
+
+void AppSrcBenchmark::pushBuffers_data()
+{
+    QTest::addColumn<int>("bufferSize");
+    QTest::addColumn<int>("mode");
+
+    for (int size = 4096; size <= 4 * 1024 * 1024; size *= 16) {
+        for (int mode = Copied; mode <= Pooled; ++mode) {
+            QTest::newRow(QByteArray::number(size) + " bytes, " + PushModeNames[mode])
+                << size << mode;
+        }
+    }
+}
+
+void AppSrcBenchmark::pushBuffers()
+{
+    QFETCH(int, bufferSize);
+    QFETCH(int, mode);
+
+    QGst::PipelinePtr pipeline = QGst::Parse::launch(
+        "appsrc name=src ! fakesink sync=false").dynamicCast<QGst::Pipeline>();
+    QVERIFY(pipeline);
+
+    QGst::Utils::ApplicationSource appsrc;
+    appsrc.setElement(pipeline->getElementByName("src"));
+    appsrc.enableBlock(true);
+
+    //the payload that the application has already received, e.g. from the network
+    QByteArray payload(bufferSize, 'x');
+
+    //copied buffers come from a pool instead of being allocated one by one
+    QGst::BufferPoolPtr pool;
+    if (mode == Pooled) {
+        pool = QGst::BufferPool::create();
+        QGst::BufferPoolConfig config = pool->config();
+        config.setParams(QGst::CapsPtr(), bufferSize, 4, 0);
+        QVERIFY(pool->setConfig(config));
+        QVERIFY(pool->setActive(true));
+    }
+
+    pipeline->setState(QGst::StatePlaying);
+
+    QElapsedTimer timer;
+    QBENCHMARK_ONCE {
+        timer.start();
+        for (int i = 0; i < BufferCount; ++i) {
+            QGst::BufferPtr buffer;
+            if (mode == Wrapped) {
+                buffer = QGst::Buffer::fromByteArray(payload);
+            } else {
+                if (mode == Pooled) {
+                    QCOMPARE(pool->acquireBuffer(buffer), QGst::FlowOk);
+                } else {
+                    buffer = QGst::Buffer::create(bufferSize);
+                }
+                QGst::MapInfo info;
+                buffer->map(info, QGst::MapWrite);
+                memcpy(info.data(), payload.constData(), bufferSize);
+                buffer->unmap(info);
+            }
+            appsrc.pushBuffer(buffer);
+        }
+        appsrc.endOfStream();
+
+        QGst::MessagePtr msg = pipeline->bus()->pop(
+            QGst::MessageType(QGst::MessageEos | QGst::MessageError), QGst::ClockTime::None);
+        QVERIFY(msg && msg->type() == QGst::MessageEos);
+    }
+    qint64 elapsed = qMax(timer.elapsed(), qint64(1));
+
+    qDebug("%d bytes/buffer, %s: %.0f MB/s", bufferSize, PushModeNames[mode],
+           double(bufferSize) * BufferCount * 1000 / elapsed / (1024 * 1024));
+
+    pipeline->setState(QGst::StateNull);
+    if (pool) {
+        pool->setActive(false);
+    }
+}
+
+QTEST_APPLESS_MAIN(AppSrcBenchmark)
+
+#include "appsrcbenchmark.moc"
@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest/QtTest>
+#include <QGst/Init>
+#include <QGst/Buffer>
+#include <gst/gst.h>
+
+class ObjectStoreBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+    void wrapUnwrapBuffers_data();
+    void wrapUnwrapBuffers();
+};
+
+static const int IterationsPerThread = 200000;
+
+/* Wraps the same GstBuffer repeatedly and copies the wrapper around,
+ * which exercises ObjectStore::put() and take() on every step. */
+class WrapperThread : public QThread
+{
+public:
+    WrapperThread() : m_buffer(gst_buffer_new_allocate(NULL, 16, NULL)) {}
+    virtual ~WrapperThread() { gst_buffer_unref(m_buffer); }
+
+private:
+    virtual void run()
+    {
+        for (int i = 0; i < IterationsPerThread; ++i) {
+            QGst::BufferPtr wrapper = QGst::BufferPtr::wrap(m_buffer);
+            QGst::BufferPtr copy1 = wrapper;
+            QGst::BufferPtr copy2 = copy1;
+            Q_UNUSED(copy2);
+        }
+    }
+
+    GstBuffer *m_buffer;
+};
+
+void ObjectStoreBenchmark::wrapUnwrapBuffers_data()
+{
+    QTest::addColumn<int>("threads");
+
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        QTest::newRow(QByteArray::number(threads) + " threads") << threads;
+    }
+}
+
+void ObjectStoreBenchmark::wrapUnwrapBuffers()
+{
+    QFETCH(int, threads);
+
+    QList<WrapperThread*> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.append(new WrapperThread);
+    }
+
+    QElapsedTimer timer;
+    QBENCHMARK_ONCE {
+        timer.start();
+        Q_FOREACH(WrapperThread *worker, workers) {
+            worker->start();
+        }
+        Q_FOREACH(WrapperThread *worker, workers) {
+            worker->wait();
+        }
+    }
+    qint64 elapsed = qMax(timer.elapsed(), qint64(1));
+
+    //every iteration does 3 put() and 3 take() calls
+    qDebug("%d threads: %.0f store operations/s", threads,
+           6.0 * IterationsPerThread * threads * 1000 / elapsed);
+
+    qDeleteAll(workers);
+}
+
+QTEST_APPLESS_MAIN(ObjectStoreBenchmark)
+
+#include "objectstorebenchmark.moc"
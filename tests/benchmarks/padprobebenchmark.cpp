@@ -0,0 +1,134 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest/QtTest>
+#include <QGlib/Connect>
+#include <QGst/Init>
+#include <QGst/Pad>
+#include <QGst/Buffer>
+#include <QGst/Element>
+#include <QGst/ElementFactory>
+#include <gst/gst.h>
+
+static const int BuffersPerIteration = 1000;
+
+class PadProbeBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    QGst::PadProbeReturn onBuffer(const QGst::BufferPtr &) { ++m_buffers; return QGst::PadProbeOk; }
+    void onHandoff(const QGst::BufferPtr &) { ++m_buffers; }
+
+    void pushBuffers(const QGst::PadPtr & src);
+
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+    void noProbe();
+    void padProbe();
+    void identityHandoff();
+
+private:
+    int m_buffers;
+};
+
+static GstFlowReturn discardChain(GstPad *, GstObject *, GstBuffer *buffer)
+{
+    gst_buffer_unref(buffer);
+    return GST_FLOW_OK;
+}
+
+static QGst::PadPtr createSinkPad()
+{
+    QGst::PadPtr sink = QGst::Pad::create(QGst::PadSink, "sink");
+    gst_pad_set_chain_function(sink, discardChain);
+    sink->setActive(true);
+    return sink;
+}
+
+static void startStream(const QGst::PadPtr & src)
+{
+    src->setActive(true);
+    gst_pad_push_event(src, gst_event_new_stream_start("padprobebenchmark"));
+    gst_pad_push_event(src, gst_event_new_caps(gst_caps_new_empty_simple("application/x-test")));
+
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_BYTES);
+    gst_pad_push_event(src, gst_event_new_segment(&segment));
+}
+
+void PadProbeBenchmark::pushBuffers(const QGst::PadPtr & src)
+{
+    m_buffers = 0;
+    QBENCHMARK {
+        for (int i = 0; i < BuffersPerIteration; ++i) {
+            gst_pad_push(src, gst_buffer_new());
+        }
+    }
+}
+
+void PadProbeBenchmark::noProbe()
+{
+    QGst::PadPtr src = QGst::Pad::create(QGst::PadSrc, "src");
+    QGst::PadPtr sink = createSinkPad();
+    QCOMPARE(src->link(sink), QGst::PadLinkOk);
+    startStream(src);
+
+    pushBuffers(src);
+}
+
+void PadProbeBenchmark::padProbe()
+{
+    QGst::PadPtr src = QGst::Pad::create(QGst::PadSrc, "src");
+    QGst::PadPtr sink = createSinkPad();
+    QCOMPARE(src->link(sink), QGst::PadLinkOk);
+    startStream(src);
+
+    ulong id = src->addProbe(QGst::PadProbeTypeBuffer, this, &PadProbeBenchmark::onBuffer);
+    QVERIFY(id != 0);
+
+    pushBuffers(src);
+    QVERIFY(m_buffers > 0);
+    QCOMPARE(m_buffers % BuffersPerIteration, 0);
+
+    src->removeProbe(id);
+}
+
+void PadProbeBenchmark::identityHandoff()
+{
+    QGst::ElementPtr identity = QGst::ElementFactory::make("identity");
+    QVERIFY(identity);
+
+    QGst::PadPtr src = QGst::Pad::create(QGst::PadSrc, "src");
+    QGst::PadPtr sink = createSinkPad();
+    QCOMPARE(src->link(identity->getStaticPad("sink")), QGst::PadLinkOk);
+    QCOMPARE(identity->getStaticPad("src")->link(sink), QGst::PadLinkOk);
+    QVERIFY(QGlib::connect(identity, "handoff", this, &PadProbeBenchmark::onHandoff));
+
+    identity->setState(QGst::StatePlaying);
+    startStream(src);
+
+    pushBuffers(src);
+    QVERIFY(m_buffers > 0);
+    QCOMPARE(m_buffers % BuffersPerIteration, 0);
+
+    identity->setState(QGst::StateNull);
+}
+
+QTEST_APPLESS_MAIN(PadProbeBenchmark)
+
+#include "padprobebenchmark.moc"
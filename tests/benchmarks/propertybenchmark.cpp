@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest/QtTest>
+#include <QGlib/Object>
+#include <QGst/Init>
+#include <QGst/Bin>
+
+class PropertyBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+    void getByName();
+    void getByHandle();
+    void getBatch();
+    void setByName();
+    void setByHandle();
+    void setBatch();
+};
+
+void PropertyBenchmark::getByName()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+
+    bool asyncHandling = true;
+    bool messageForward = true;
+    QBENCHMARK {
+        asyncHandling = bin->property("async-handling").get<bool>();
+        messageForward = bin->property("message-forward").get<bool>();
+    }
+    QVERIFY(!asyncHandling && !messageForward);
+}
+
+void PropertyBenchmark::getByHandle()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGlib::PropertyHandle asyncHandlingProperty(QGlib::GetType<QGst::Bin>(), "async-handling");
+    QGlib::PropertyHandle messageForwardProperty(QGlib::GetType<QGst::Bin>(), "message-forward");
+
+    bool asyncHandling = true;
+    bool messageForward = true;
+    QBENCHMARK {
+        asyncHandling = bin->property(asyncHandlingProperty).get<bool>();
+        messageForward = bin->property(messageForwardProperty).get<bool>();
+    }
+    QVERIFY(!asyncHandling && !messageForward);
+}
+
+void PropertyBenchmark::getBatch()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+    QList<QGlib::PropertyHandle> handles;
+    handles << QGlib::PropertyHandle(QGlib::GetType<QGst::Bin>(), "async-handling")
+            << QGlib::PropertyHandle(QGlib::GetType<QGst::Bin>(), "message-forward");
+
+    QList<QGlib::Value> values;
+    QBENCHMARK {
+        values = bin->properties(handles);
+    }
+    QCOMPARE(values.size(), 2);
+    QVERIFY(!values[0].get<bool>() && !values[1].get<bool>());
+}
+
+void PropertyBenchmark::setByName()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+
+    QBENCHMARK {
+        bin->setProperty("async-handling", true);
+        bin->setProperty("message-forward", true);
+    }
+    QVERIFY(bin->property("async-handling").get<bool>());
+}
+
+void PropertyBenchmark::setByHandle()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGlib::PropertyHandle asyncHandlingProperty(QGlib::GetType<QGst::Bin>(), "async-handling");
+    QGlib::PropertyHandle messageForwardProperty(QGlib::GetType<QGst::Bin>(), "message-forward");
+
+    QBENCHMARK {
+        bin->setProperty(asyncHandlingProperty, true);
+        bin->setProperty(messageForwardProperty, true);
+    }
+    QVERIFY(bin->property("async-handling").get<bool>());
+}
+
+void PropertyBenchmark::setBatch()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+    QList<QGlib::PropertyHandle> handles;
+    handles << QGlib::PropertyHandle(QGlib::GetType<QGst::Bin>(), "async-handling")
+            << QGlib::PropertyHandle(QGlib::GetType<QGst::Bin>(), "message-forward");
+    QList<QGlib::Value> values;
+    values << QGlib::Value::create(true) << QGlib::Value::create(true);
+
+    QBENCHMARK {
+        bin->setProperties(handles, values);
+    }
+    QVERIFY(bin->property("async-handling").get<bool>());
+}
+
+QTEST_APPLESS_MAIN(PropertyBenchmark)
+
+#include "propertybenchmark.moc"
@@ -0,0 +1,97 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest/QtTest>
+#include <QGlib/Signal>
+#include <QGlib/Connect>
+#include <QGst/Init>
+#include <QGst/Bin>
+
+class SignalBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    void notifyClosure(const QGlib::ParamSpecPtr &) { ++m_calls; }
+
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+    void emitByName_data();
+    void emitByName();
+    void emitByHandle_data();
+    void emitByHandle();
+
+private:
+    int m_calls;
+};
+
+static void addConnectedColumn()
+{
+    QTest::addColumn<bool>("connected");
+    QTest::newRow("no handlers") << false;
+    QTest::newRow("one handler") << true;
+}
+
+void SignalBenchmark::emitByName_data()
+{
+    addConnectedColumn();
+}
+
+void SignalBenchmark::emitByName()
+{
+    QFETCH(bool, connected);
+
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGlib::ParamSpecPtr param = bin->findProperty("name");
+    if (connected) {
+        QGlib::connect(bin, "notify::name", this, &SignalBenchmark::notifyClosure);
+    }
+
+    m_calls = 0;
+    QBENCHMARK {
+        QGlib::emit<void>(bin, "notify::name", param);
+    }
+    QVERIFY(!connected || m_calls > 0);
+}
+
+void SignalBenchmark::emitByHandle_data()
+{
+    addConnectedColumn();
+}
+
+void SignalBenchmark::emitByHandle()
+{
+    QFETCH(bool, connected);
+
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGlib::ParamSpecPtr param = bin->findProperty("name");
+    if (connected) {
+        QGlib::connect(bin, "notify::name", this, &SignalBenchmark::notifyClosure);
+    }
+
+    QGlib::SignalHandle handle(QGlib::GetType<QGst::Bin>(), "notify::name");
+
+    m_calls = 0;
+    QBENCHMARK {
+        QGlib::emit<void>(handle, bin, param);
+    }
+    QVERIFY(!connected || m_calls > 0);
+}
+
+QTEST_APPLESS_MAIN(SignalBenchmark)
+
+#include "signalbenchmark.moc"
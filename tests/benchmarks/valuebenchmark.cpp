@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2016 Collabora Ltd. <info@collabora.com>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest/QtTest>
+#include <QGlib/Value>
+#include <QGst/Init>
+#include <QGst/Bin>
+#include <QGst/Caps>
+#include <QGst/ChildProxy>
+#include <gst/gst.h>
+
+class ValueBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+    void getFundamental();
+    void getBoxed();
+    void getObject();
+    void getInterface();
+};
+
+void ValueBenchmark::getFundamental()
+{
+    QGlib::Value v = QGlib::Value::create(10);
+
+    int result = 0;
+    QBENCHMARK {
+        result = v.get<int>();
+    }
+    QCOMPARE(result, 10);
+}
+
+void ValueBenchmark::getBoxed()
+{
+    QGst::CapsPtr caps = QGst::Caps::createSimple("video/x-raw");
+    QGlib::Value v = QGlib::Value::create(caps);
+
+    QGst::CapsPtr result;
+    QBENCHMARK {
+        result = v.get<QGst::CapsPtr>();
+    }
+    QCOMPARE(static_cast<GstCaps*>(result), static_cast<GstCaps*>(caps));
+}
+
+void ValueBenchmark::getObject()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGlib::Value v = QGlib::Value::create(bin);
+
+    QGst::BinPtr result;
+    QBENCHMARK {
+        result = v.get<QGst::BinPtr>();
+    }
+    QCOMPARE(static_cast<GstBin*>(result), static_cast<GstBin*>(bin));
+}
+
+void ValueBenchmark::getInterface()
+{
+    QGst::ChildProxyPtr childProxy = QGst::Bin::create();
+    QGlib::Value v;
+    v.init<QGst::ChildProxy>();
+    v.set(childProxy);
+
+    QGst::ChildProxyPtr result;
+    QBENCHMARK {
+        result = v.get<QGst::ChildProxyPtr>();
+    }
+    QCOMPARE(static_cast<GstChildProxy*>(result), static_cast<GstChildProxy*>(childProxy));
+}
+
+QTEST_APPLESS_MAIN(ValueBenchmark)
+
+#include "valuebenchmark.moc"